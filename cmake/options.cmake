@@ -10,6 +10,7 @@ option(BUILD_PLAYERBOT      "Build Playerbot mod"                   OFF)
 option(BUILD_AHBOT          "Build Auction House Bot mod"           OFF)
 option(BUILD_RECASTDEMOMOD  "Build map/vmap/mmap viewer"            OFF)
 option(BUILD_GIT_ID         "Build git_id"                          OFF)
+option(BUILD_BENCHMARKS     "Build micro benchmarks"                OFF)
 option(BUILD_DOCS           "Build documentation with doxygen"      OFF)
 
 # TODO: options that should be checked/created:
@@ -35,6 +36,7 @@ message(STATUS
     BUILD_AHBOT             Build Auction House Bot mod
     BUILD_RECASTDEMOMOD     Build map/vmap/mmap viewer
     BUILD_GIT_ID            Build git_id
+    BUILD_BENCHMARKS        Build micro benchmarks (contrib/threat_bench)
     BUILD_DOCS              Build documentation with doxygen
 
   To set an option simply type -D<OPTION>=<VALUE> after 'cmake <srcs>'.
@@ -0,0 +1,234 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+/*
+ * Micro benchmark for the ThreatContainer storage.
+ *
+ * Models one creature with a 40 attacker threat table: every tick each
+ * attacker adds threat a few times (lookup by guid), some attackers go
+ * offline and come back (remove/add), and the owner re-sorts the list when
+ * it got dirty and reads the top victim.
+ *
+ * The game library is not linked, references carry only the sort keys used
+ * by ThreatContainer::update that do not need a live map.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <list>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+    struct Reference
+    {
+        uint64_t guid;
+        float threat;
+        bool taunted;
+        int hostileState;
+    };
+
+    bool MoreHated(Reference const* lhs, Reference const* rhs)
+    {
+        if (lhs->taunted != rhs->taunted)
+            return lhs->taunted;
+        if (lhs->hostileState != rhs->hostileState)
+            return lhs->hostileState > rhs->hostileState;
+        return lhs->threat > rhs->threat;
+    }
+
+    // list with a linear guid search, the storage before the guid index
+    class ListScanContainer
+    {
+        public:
+            void Add(Reference* ref) { m_list.push_back(ref); }
+            void Remove(Reference* ref) { m_list.remove(ref); }
+            Reference* Find(uint64_t guid) const
+            {
+                for (Reference* ref : m_list)
+                    if (ref->guid == guid)
+                        return ref;
+                return nullptr;
+            }
+            void Sort() { m_list.sort(MoreHated); }
+            Reference* Top() const { return m_list.empty() ? nullptr : m_list.front(); }
+
+        private:
+            std::list<Reference*> m_list;
+    };
+
+    // list with a guid -> node index, the current ThreatContainer
+    class ListIndexContainer
+    {
+        public:
+            void Add(Reference* ref)
+            {
+                m_list.push_back(ref);
+                m_index[ref->guid] = std::prev(m_list.end());
+            }
+            void Remove(Reference* ref)
+            {
+                auto itr = m_index.find(ref->guid);
+                if (itr == m_index.end())
+                    return;
+                m_list.erase(itr->second);
+                m_index.erase(itr);
+            }
+            Reference* Find(uint64_t guid) const
+            {
+                auto itr = m_index.find(guid);
+                return itr != m_index.end() ? *itr->second : nullptr;
+            }
+            void Sort() { m_list.sort(MoreHated); }
+            Reference* Top() const { return m_list.empty() ? nullptr : m_list.front(); }
+
+        private:
+            std::list<Reference*> m_list;
+            std::unordered_map<uint64_t, std::list<Reference*>::iterator> m_index;
+    };
+
+    // vector with a guid index and an insertion sort, for comparison
+    class VectorIndexContainer
+    {
+        public:
+            void Add(Reference* ref)
+            {
+                m_vector.push_back(ref);
+                m_index[ref->guid] = ref;
+            }
+            void Remove(Reference* ref)
+            {
+                auto itr = std::find(m_vector.begin(), m_vector.end(), ref);
+                if (itr == m_vector.end())
+                    return;
+                m_vector.erase(itr);
+                m_index.erase(ref->guid);
+            }
+            Reference* Find(uint64_t guid) const
+            {
+                auto itr = m_index.find(guid);
+                return itr != m_index.end() ? itr->second : nullptr;
+            }
+            void Sort()
+            {
+                for (size_t i = 1; i < m_vector.size(); ++i)
+                {
+                    Reference* ref = m_vector[i];
+                    size_t j = i;
+                    for (; j > 0 && MoreHated(ref, m_vector[j - 1]); --j)
+                        m_vector[j] = m_vector[j - 1];
+                    m_vector[j] = ref;
+                }
+            }
+            Reference* Top() const { return m_vector.empty() ? nullptr : m_vector.front(); }
+
+        private:
+            std::vector<Reference*> m_vector;
+            std::unordered_map<uint64_t, Reference*> m_index;
+    };
+
+    const int ATTACKERS = 40;
+    const int HITS_PER_TICK = 4;                            // threat events per attacker per tick
+    const int OFFLINE_CHANCE = 10;                          // percent of ticks one attacker goes offline and back
+
+    template<class Container>
+    double Run(char const* name, int ticks, uint64_t& checksum)
+    {
+        std::mt19937 rng(42);
+        std::uniform_int_distribution<int> attackerDist(0, ATTACKERS - 1);
+        std::uniform_real_distribution<float> threatDist(50.0f, 1500.0f);
+        std::uniform_int_distribution<int> percentDist(0, 99);
+
+        std::vector<Reference> refs(ATTACKERS);
+        std::vector<uint64_t> guids(ATTACKERS);
+        Container container;
+        for (int i = 0; i < ATTACKERS; ++i)
+        {
+            // spread the guids like creature and player guids in one table
+            guids[i] = (uint64_t(i % 2 ? 0xF130 : 0x0000) << 48) | uint64_t(1000 + i * 7919);
+            refs[i] = { guids[i], 0.0f, false, 0 };
+            container.Add(&refs[i]);
+        }
+
+        bool dirty = true;
+        auto start = std::chrono::steady_clock::now();
+        for (int tick = 0; tick < ticks; ++tick)
+        {
+            for (int hit = 0; hit < ATTACKERS * HITS_PER_TICK; ++hit)
+            {
+                Reference* ref = container.Find(guids[attackerDist(rng)]);
+                if (!ref)
+                    continue;
+                ref->threat += threatDist(rng);
+                // same rule as ThreatContainer, only a change that can move the victim dirties the list
+                Reference* top = container.Top();
+                if (top != ref && MoreHated(ref, top))
+                    dirty = true;
+            }
+
+            if (percentDist(rng) < OFFLINE_CHANCE)
+            {
+                Reference* ref = container.Find(guids[attackerDist(rng)]);
+                if (ref)
+                {
+                    container.Remove(ref);
+                    ref->hostileState = percentDist(rng) < 50 ? 1 : 0;
+                    container.Add(ref);
+                    dirty = true;
+                }
+            }
+
+            if (dirty)
+            {
+                container.Sort();
+                dirty = false;
+            }
+            checksum += container.Top()->guid;
+        }
+        auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+        double perTick = elapsed / ticks;
+        printf("%-24s %10.1f ns/tick %8.1f ns/threat event\n", name, perTick, perTick / (ATTACKERS * HITS_PER_TICK));
+        return perTick;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    int ticks = argc > 1 ? atoi(argv[1]) : 200000;
+    if (ticks <= 0)
+    {
+        printf("Usage: threat_bench [ticks]\n");
+        return 1;
+    }
+
+    printf("%d attackers, %d threat events per attacker and tick, %d ticks\n", ATTACKERS, HITS_PER_TICK, ticks);
+
+    uint64_t checksum = 0;
+    Run<ListScanContainer>("list + linear search", ticks, checksum);
+    Run<ListIndexContainer>("list + guid index", ticks, checksum);
+    Run<VectorIndexContainer>("vector + guid index", ticks, checksum);
+
+    printf("checksum %llu\n", (unsigned long long)checksum);
+    return 0;
+}
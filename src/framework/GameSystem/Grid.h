@@ -38,11 +38,23 @@
 // forward declaration
 template<class A, class T, class O> class GridLoader;
 
+/*
+  @class NullCellIndex
+  Default spatial index policy of a Grid: keeps nothing. A game side index
+  is told about every object entering and leaving the grid containers.
+*/
+struct NullCellIndex
+{
+    template<class SPECIFIC_OBJECT> void Insert(SPECIFIC_OBJECT* /*obj*/) {}
+    template<class SPECIFIC_OBJECT> void Remove(SPECIFIC_OBJECT* /*obj*/) {}
+};
+
 template
 <
     class ACTIVE_OBJECT,
     class WORLD_OBJECT_TYPES,
-    class GRID_OBJECT_TYPES
+    class GRID_OBJECT_TYPES,
+    class CELL_INDEX = NullCellIndex
     >
 class Grid
 {
@@ -61,7 +73,11 @@ class Grid
         template<class SPECIFIC_OBJECT>
         bool AddWorldObject(SPECIFIC_OBJECT* obj)
         {
-            return i_objects.template insert<SPECIFIC_OBJECT>(obj);
+            if (!i_objects.template insert<SPECIFIC_OBJECT>(obj))
+                return false;
+
+            i_index.Insert(obj);
+            return true;
         }
 
         /** an object of interested exits the grid
@@ -69,6 +85,7 @@ class Grid
         template<class SPECIFIC_OBJECT>
         bool RemoveWorldObject(SPECIFIC_OBJECT* obj)
         {
+            i_index.Remove(obj);
             return i_objects.template remove<SPECIFIC_OBJECT>(obj);
         }
 
@@ -95,6 +112,10 @@ class Grid
             return m_activeGridObjects.size() + i_objects.template Count<ACTIVE_OBJECT>();
         }
 
+        /** Spatial index of the objects listed in the grid
+         */
+        CELL_INDEX const& GetIndex() const { return i_index; }
+
         /** Inserts a container type object into the grid.
          */
         template<class SPECIFIC_OBJECT>
@@ -103,7 +124,11 @@ class Grid
             if (obj->isActiveObject())
                 m_activeGridObjects.insert(obj);
 
-            return i_container.template insert<SPECIFIC_OBJECT>(obj);
+            if (!i_container.template insert<SPECIFIC_OBJECT>(obj))
+                return false;
+
+            i_index.Insert(obj);
+            return true;
         }
 
         /** Removes a containter type object from the grid
@@ -114,6 +139,7 @@ class Grid
             if (obj->isActiveObject())
                 m_activeGridObjects.erase(obj);
 
+            i_index.Remove(obj);
             return i_container.template remove<SPECIFIC_OBJECT>(obj);
         }
 
@@ -123,6 +149,7 @@ class Grid
         TypeMapContainer<WORLD_OBJECT_TYPES> i_objects;
         typedef std::set<void*> ActiveGridObjects;
         ActiveGridObjects m_activeGridObjects;
+        CELL_INDEX i_index;
 };
 
 #endif
@@ -46,24 +46,24 @@ class GridLoader
 
         /** Loads the grid
          */
-        template<class LOADER>
-        void Load(Grid<ACTIVE_OBJECT, WORLD_OBJECT_TYPES, GRID_OBJECT_TYPES>& grid, LOADER& loader)
+        template<class LOADER, class CELL_INDEX>
+        void Load(Grid<ACTIVE_OBJECT, WORLD_OBJECT_TYPES, GRID_OBJECT_TYPES, CELL_INDEX>& grid, LOADER& loader)
         {
             loader.Load(grid);
         }
 
         /** Stop the grid
          */
-        template<class STOPER>
-        void Stop(Grid<ACTIVE_OBJECT, WORLD_OBJECT_TYPES, GRID_OBJECT_TYPES>& grid, STOPER& stoper)
+        template<class STOPER, class CELL_INDEX>
+        void Stop(Grid<ACTIVE_OBJECT, WORLD_OBJECT_TYPES, GRID_OBJECT_TYPES, CELL_INDEX>& grid, STOPER& stoper)
         {
             stoper.Stop(grid);
         }
 
         /** Unloads the grid
          */
-        template<class UNLOADER>
-        void Unload(Grid<ACTIVE_OBJECT, WORLD_OBJECT_TYPES, GRID_OBJECT_TYPES>& grid, UNLOADER& unloader)
+        template<class UNLOADER, class CELL_INDEX>
+        void Unload(Grid<ACTIVE_OBJECT, WORLD_OBJECT_TYPES, GRID_OBJECT_TYPES, CELL_INDEX>& grid, UNLOADER& unloader)
         {
             unloader.Unload(grid);
         }
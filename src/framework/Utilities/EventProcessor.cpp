@@ -18,10 +18,125 @@
 
 #include "EventProcessor.h"
 
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <new>
+
+namespace
+{
+    // Released event blocks are kept in per thread free lists, one list per size class. A block freed on
+    // another thread than the one that allocated it simply moves to the free lists of that thread.
+    const std::size_t EVENT_BLOCK_GRANULARITY = 16;
+    const std::size_t EVENT_BLOCK_CLASSES = 16;             // pooled up to 256 bytes, bigger events use the heap
+    const std::size_t EVENT_BLOCK_CACHE_LIMIT = 1024;       // cached blocks per size class and thread
+
+    struct EventBlock
+    {
+        EventBlock* next;
+    };
+
+    // trivially destructible so that it stays usable while other thread locals are destroyed
+    struct EventBlockCache
+    {
+        EventBlock* free[EVENT_BLOCK_CLASSES];
+        std::size_t count[EVENT_BLOCK_CLASSES];
+        bool released;
+        bool cleanupArmed;
+    };
+
+    thread_local EventBlockCache t_eventBlocks;
+
+    struct EventBlockCacheCleanup
+    {
+        bool armed = false;
+
+        ~EventBlockCacheCleanup()
+        {
+            for (std::size_t i = 0; i < EVENT_BLOCK_CLASSES; ++i)
+            {
+                while (EventBlock* block = t_eventBlocks.free[i])
+                {
+                    t_eventBlocks.free[i] = block->next;
+                    ::operator delete(block);
+                }
+                t_eventBlocks.count[i] = 0;
+            }
+            t_eventBlocks.released = true;
+        }
+    };
+
+    thread_local EventBlockCacheCleanup t_eventBlocksCleanup;
+
+    // make sure the cache of this thread gets released at thread exit
+    inline void ArmEventBlockCleanup(EventBlockCache& cache)
+    {
+        if (!cache.cleanupArmed)
+        {
+            t_eventBlocksCleanup.armed = true;
+            cache.cleanupArmed = true;
+        }
+    }
+
+    inline std::size_t GetEventBlockClass(std::size_t size)
+    {
+        return (size + EVENT_BLOCK_GRANULARITY - 1) / EVENT_BLOCK_GRANULARITY - 1;
+    }
+}
+
+void* BasicEvent::operator new(std::size_t size)
+{
+    std::size_t sizeClass = GetEventBlockClass(size);
+    if (sizeClass >= EVENT_BLOCK_CLASSES)
+        return ::operator new(size);
+
+    EventBlockCache& cache = t_eventBlocks;
+    if (EventBlock* block = cache.free[sizeClass])
+    {
+        cache.free[sizeClass] = block->next;
+        --cache.count[sizeClass];
+        return block;
+    }
+
+    ArmEventBlockCleanup(cache);
+    return ::operator new((sizeClass + 1) * EVENT_BLOCK_GRANULARITY);
+}
+
+void BasicEvent::operator delete(void* ptr, std::size_t size)
+{
+    if (!ptr)
+        return;
+
+    std::size_t sizeClass = GetEventBlockClass(size);
+    EventBlockCache& cache = t_eventBlocks;
+    if (sizeClass >= EVENT_BLOCK_CLASSES || cache.released || cache.count[sizeClass] >= EVENT_BLOCK_CACHE_LIMIT)
+    {
+        ::operator delete(ptr);
+        return;
+    }
+
+    // the thread may only free events allocated elsewhere
+    ArmEventBlockCleanup(cache);
+
+    EventBlock* block = static_cast<EventBlock*>(ptr);
+    block->next = cache.free[sizeClass];
+    cache.free[sizeClass] = block;
+    ++cache.count[sizeClass];
+}
+
 EventProcessor::EventProcessor()
 {
     m_time = 0;
     m_aborting = false;
+
+    m_wheelTick = 0;
+    m_sequence = 0;
+    m_scheduled = 0;
+    std::fill(std::begin(m_occupied), std::end(m_occupied), 0);
+    for (auto& level : m_wheel)
+        std::fill(std::begin(level), std::end(level), nullptr);
+    m_overflow = nullptr;
+    m_due = nullptr;
 }
 
 EventProcessor::~EventProcessor()
@@ -34,13 +149,14 @@ void EventProcessor::Update(uint32 p_time)
     // update time
     m_time += p_time;
 
+    // move all events that are due by now to the execution queue
+    AdvanceWheel();
+
     // main event loop
-    EventList::iterator i;
-    while (((i = m_events.begin()) != m_events.end()) && i->first <= m_time)
+    while (BasicEvent* Event = m_due)
     {
         // get and remove event from queue
-        BasicEvent* Event = i->second;
-        m_events.erase(i);
+        Unqueue(Event);
 
         if (!Event->to_Abort)
         {
@@ -63,65 +179,271 @@ void EventProcessor::KillAllEvents(bool force)
     // prevent event insertions
     m_aborting = true;
 
-    // first, abort all existing events
-    for (EventList::iterator i = m_events.begin(); i != m_events.end();)
+    // abort all existing events
+    AbortQueue(m_due, force);
+    for (auto& level : m_wheel)
+        for (BasicEvent*& head : level)
+            AbortQueue(head, force);
+    AbortQueue(m_overflow, force);
+}
+
+void EventProcessor::KillEvent(BasicEvent* event)
+{
+    // events being executed right now are not queued and stay alive
+    if (!IsQueued(event))
+        return;
+
+    Unqueue(event);
+    delete event;
+}
+
+void EventProcessor::AddEvent(BasicEvent* Event, uint64 e_time, bool set_addtime)
+{
+    if (set_addtime)
+        Event->m_addTime = m_time;
+
+    Event->m_execTime = e_time;
+    Event->m_sequence = m_sequence++;
+    Schedule(Event);
+}
+
+void EventProcessor::ModifyEventTime(BasicEvent* Event, uint64 msTime)
+{
+    if (!IsQueued(Event))
+        return;
+
+    Unqueue(Event);
+    Event->m_execTime = msTime;
+    Event->m_sequence = m_sequence++;
+    Schedule(Event);
+}
+
+uint64 EventProcessor::CalculateTime(uint64 t_offset) const
+{
+    return m_time + t_offset;
+}
+
+void EventProcessor::Schedule(BasicEvent* event)
+{
+    if (event->m_execTime <= m_time)
     {
-        EventList::iterator i_old = i;
-        ++i;
+        QueueDue(event);
+        return;
+    }
 
-        i_old->second->to_Abort = true;
-        i_old->second->Abort(m_time);
-        if (force || i_old->second->IsDeletable())
-        {
-            delete i_old->second;
+    // m_wheelTick never passes the tick of m_time, so a future event never lands behind it
+    uint64 tick = event->m_execTime >> WHEEL_TICK_BITS;
+    uint64 delta = tick - m_wheelTick;
 
-            if (!force)                                     // need per-element cleanup
-                m_events.erase(i_old);
+    BasicEvent** head = &m_overflow;
+    for (uint32 level = 0; level < WHEEL_LEVELS; ++level)
+    {
+        if (delta < (uint64(1) << (WHEEL_SLOT_BITS * (level + 1))))
+        {
+            uint32 slot = uint32(tick >> (WHEEL_SLOT_BITS * level)) & (WHEEL_SLOTS - 1);
+            head = &m_wheel[level][slot];
+            m_occupied[level] |= 1u << slot;
+            break;
         }
     }
 
-    // fast clear event list (in force case)
-    if (force)
-        m_events.clear();
+    event->m_slot = head;
+    event->m_next = nullptr;
+    if (BasicEvent* first = *head)
+    {
+        BasicEvent* last = first->m_prev;
+        last->m_next = event;
+        event->m_prev = last;
+        first->m_prev = event;
+    }
+    else
+    {
+        *head = event;
+        event->m_prev = event;
+    }
+    ++m_scheduled;
 }
 
-void EventProcessor::KillEvent(BasicEvent* event)
+void EventProcessor::QueueDue(BasicEvent* event)
 {
-    for (EventList::iterator iter = m_events.begin(); iter != m_events.end();)
+    auto isBefore = [](BasicEvent const* lhs, BasicEvent const* rhs)
     {
-        if (iter->second == event)
-        {
-            delete iter->second;
-            iter = m_events.erase(iter);
-        }
-        else ++iter;
+        return lhs->m_execTime < rhs->m_execTime || (lhs->m_execTime == rhs->m_execTime && lhs->m_sequence < rhs->m_sequence);
+    };
+
+    event->m_slot = &m_due;
+
+    // due events are mostly queued in time order, so look for the place from the tail
+    BasicEvent* pos = nullptr;
+    if (m_due && isBefore(event, m_due->m_prev))
+    {
+        pos = m_due->m_prev;
+        while (pos != m_due && isBefore(event, pos->m_prev))
+            pos = pos->m_prev;
+    }
+
+    event->m_next = pos;
+    if (!m_due)
+    {
+        m_due = event;
+        event->m_prev = event;
+    }
+    else if (!pos)
+    {
+        BasicEvent* last = m_due->m_prev;
+        last->m_next = event;
+        event->m_prev = last;
+        m_due->m_prev = event;
+    }
+    else if (pos == m_due)
+    {
+        event->m_prev = m_due->m_prev;
+        pos->m_prev = event;
+        m_due = event;
+    }
+    else
+    {
+        event->m_prev = pos->m_prev;
+        pos->m_prev->m_next = event;
+        pos->m_prev = event;
     }
 }
 
-void EventProcessor::AddEvent(BasicEvent* Event, uint64 e_time, bool set_addtime)
+void EventProcessor::Unqueue(BasicEvent* event)
 {
-    if (set_addtime)
-        Event->m_addTime = m_time;
+    BasicEvent** head = event->m_slot;
+    if (event == *head)
+    {
+        *head = event->m_next;
+        if (*head)
+            (*head)->m_prev = event->m_prev;
+    }
+    else
+    {
+        event->m_prev->m_next = event->m_next;
+        if (event->m_next)
+            event->m_next->m_prev = event->m_prev;
+        else
+            (*head)->m_prev = event->m_prev;
+    }
 
-    Event->m_execTime = e_time;
-    m_events.insert(std::pair<uint64, BasicEvent*>(e_time, Event));
+    event->m_slot = nullptr;
+    event->m_next = nullptr;
+    event->m_prev = nullptr;
+
+    if (head == &m_due)
+        return;
+
+    --m_scheduled;
+    if (head != &m_overflow && !*head)
+    {
+        std::size_t index = head - &m_wheel[0][0];
+        m_occupied[index / WHEEL_SLOTS] &= ~(1u << (index % WHEEL_SLOTS));
+    }
 }
 
-void EventProcessor::ModifyEventTime(BasicEvent* Event, uint64 msTime)
+bool EventProcessor::IsQueued(BasicEvent const* event) const
 {
-    for (auto itr = m_events.begin(); itr != m_events.end(); ++itr)
+    BasicEvent* const* head = event->m_slot;
+    if (!head)
+        return false;
+    if (head == &m_due || head == &m_overflow)
+        return true;
+
+    BasicEvent* const* first = &m_wheel[0][0];
+    return std::greater_equal<BasicEvent* const*>()(head, first) && std::less<BasicEvent* const*>()(head, first + WHEEL_LEVELS * WHEEL_SLOTS);
+}
+
+void EventProcessor::AdvanceWheel()
+{
+    uint64 targetTick = m_time >> WHEEL_TICK_BITS;
+    while (true)
     {
-        if (itr->second != Event)
+        if (!m_scheduled)
+        {
+            m_wheelTick = targetTick;
+            break;
+        }
+
+        // every event in the current slot belongs to the current tick, which may be only partially over
+        uint32 slot = uint32(m_wheelTick) & (WHEEL_SLOTS - 1);
+        if (m_occupied[0] & (1u << slot))
+        {
+            BasicEvent* event = m_wheel[0][slot];
+            while (event)
+            {
+                BasicEvent* next = event->m_next;
+                if (event->m_execTime <= m_time)
+                {
+                    Unqueue(event);
+                    QueueDue(event);
+                }
+                event = next;
+            }
+        }
+
+        if (m_wheelTick >= targetTick)
+            break;
+
+        // nothing left in this round of the first ring, jump straight to the next one
+        uint32 later = m_occupied[0] & ~((2u << slot) - 1);
+        if (!later)
+            m_wheelTick = std::min((m_wheelTick | (WHEEL_SLOTS - 1)) + 1, targetTick);
+        else
+            ++m_wheelTick;
+
+        if (m_wheelTick & (WHEEL_SLOTS - 1))
             continue;
 
-        Event->m_execTime = msTime;
-        m_events.erase(itr);
-        m_events.insert(std::pair<uint64, BasicEvent*>(msTime, Event));
-        break;
+        // new round of the first ring, pull the events of the matching slots down from the outer rings
+        uint64 round = m_wheelTick >> WHEEL_SLOT_BITS;
+        if (!(round & (WHEEL_SLOTS - 1)))
+        {
+            if (!((round >> WHEEL_SLOT_BITS) & (WHEEL_SLOTS - 1)))
+                Requeue(m_overflow);
+            Requeue(m_wheel[2][(round >> WHEEL_SLOT_BITS) & (WHEEL_SLOTS - 1)]);
+        }
+        Requeue(m_wheel[1][round & (WHEEL_SLOTS - 1)]);
     }
 }
 
-uint64 EventProcessor::CalculateTime(uint64 t_offset) const
+void EventProcessor::Requeue(BasicEvent*& head)
 {
-    return m_time + t_offset;
+    // detach the whole slot first, events of later rounds go right back into it
+    BasicEvent* event = head;
+    head = nullptr;
+    if (&head != &m_overflow)
+    {
+        std::size_t index = &head - &m_wheel[0][0];
+        m_occupied[index / WHEEL_SLOTS] &= ~(1u << (index % WHEEL_SLOTS));
+    }
+
+    while (event)
+    {
+        BasicEvent* next = event->m_next;
+        event->m_slot = nullptr;
+        event->m_next = nullptr;
+        event->m_prev = nullptr;
+        --m_scheduled;
+        Schedule(event);
+        event = next;
+    }
+}
+
+void EventProcessor::AbortQueue(BasicEvent*& head, bool force)
+{
+    BasicEvent* event = head;
+    while (event)
+    {
+        BasicEvent* next = event->m_next;
+
+        event->to_Abort = true;
+        event->Abort(m_time);
+        if (force || event->IsDeletable())
+        {
+            Unqueue(event);
+            delete event;
+        }
+        event = next;
+    }
 }
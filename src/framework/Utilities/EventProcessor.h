@@ -21,16 +21,18 @@
 
 #include "Platform/Define.h"
 
-#include <map>
+#include <cstddef>
 
 // Note. All times are in milliseconds here.
 
+class EventProcessor;
+
 class BasicEvent
 {
     public:
 
         BasicEvent()
-            : to_Abort(false)
+            : to_Abort(false), m_addTime(0), m_execTime(0), m_next(nullptr), m_prev(nullptr), m_slot(nullptr), m_sequence(0)
         {
         }
 
@@ -53,9 +55,20 @@ class BasicEvent
         // these can be used for time offset control
         uint64 m_addTime;                                   // time when the event was added to queue, filled by event handler
         uint64 m_execTime;                                  // planned time of next execution, filled by event handler
-};
 
-typedef std::multimap<uint64, BasicEvent*> EventList;
+        // events are small and short living, blocks are recycled through per thread free lists
+        static void* operator new(std::size_t size);
+        static void operator delete(void* ptr, std::size_t size);
+
+    private:
+        friend class EventProcessor;
+
+        // intrusive link in one of the EventProcessor queues, the head of a queue keeps the tail in m_prev
+        BasicEvent* m_next;
+        BasicEvent* m_prev;
+        BasicEvent** m_slot;                                // queue head the event is linked in, nullptr if not queued
+        uint64 m_sequence;                                  // keeps events with equal m_execTime in insertion order
+};
 
 class EventProcessor
 {
@@ -70,13 +83,55 @@ class EventProcessor
         void AddEvent(BasicEvent* Event, uint64 e_time, bool set_addtime = true);
         void ModifyEventTime(BasicEvent* event, uint64 msTime);
         uint64 CalculateTime(uint64 t_offset) const;
-        EventList& GetEvents() { return m_events; }
+
+        template<typename F>
+        void VisitEvents(F const& visitor)
+        {
+            VisitQueue(m_due, visitor);
+            for (auto& level : m_wheel)
+                for (BasicEvent* head : level)
+                    VisitQueue(head, visitor);
+            VisitQueue(m_overflow, visitor);
+        }
 
     protected:
+        // Hierarchical timing wheel: WHEEL_LEVELS rings of WHEEL_SLOTS slots, a slot of the first ring
+        // covers one tick of 2^WHEEL_TICK_BITS ms, a slot of each further ring covers a full round of the
+        // ring below. Events further away than the last ring wait in m_overflow.
+        static const uint32 WHEEL_TICK_BITS = 4;
+        static const uint32 WHEEL_SLOT_BITS = 5;
+        static const uint32 WHEEL_SLOTS = 1 << WHEEL_SLOT_BITS;
+        static const uint32 WHEEL_LEVELS = 3;
+
+        void Schedule(BasicEvent* event);
+        void QueueDue(BasicEvent* event);
+        void Unqueue(BasicEvent* event);
+        bool IsQueued(BasicEvent const* event) const;
+        void AdvanceWheel();
+        void Requeue(BasicEvent*& head);
+        void AbortQueue(BasicEvent*& head, bool force);
+
+        template<typename F>
+        static void VisitQueue(BasicEvent* head, F const& visitor)
+        {
+            while (head)
+            {
+                BasicEvent* next = head->m_next;
+                visitor(head);
+                head = next;
+            }
+        }
 
         uint64 m_time;
-        EventList m_events;
         bool m_aborting;
+
+        uint64 m_wheelTick;                                 // first ring tick not fully executed yet
+        uint64 m_sequence;
+        uint32 m_scheduled;                                 // events in the wheel and overflow queue
+        uint32 m_occupied[WHEEL_LEVELS];                    // non empty slots of each ring
+        BasicEvent* m_wheel[WHEEL_LEVELS][WHEEL_SLOTS];
+        BasicEvent* m_overflow;
+        BasicEvent* m_due;                                  // events to execute in the current update, ordered by time
 };
 
 #endif
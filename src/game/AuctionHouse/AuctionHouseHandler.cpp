@@ -228,6 +228,9 @@ AuctionHouseEntry const* WorldSession::GetCheckedAuctionHouseForAuctioneer(Objec
 // this void creates new auction and adds auction to some auctionhouse
 void WorldSession::HandleAuctionSellItem(WorldPacket& recv_data)
 {
+    // auctions are seen by all characters, they are written through the first delay thread
+    Database::ShardGuard dbShard(0);
+
     DEBUG_LOG("WORLD: HandleAuctionSellItem");
 
     ObjectGuid auctioneerGuid;
@@ -371,6 +374,9 @@ void WorldSession::HandleAuctionSellItem(WorldPacket& recv_data)
 // this function is called when client bids or buys out auction
 void WorldSession::HandleAuctionPlaceBid(WorldPacket& recv_data)
 {
+    // a bid refunds the previous bidder and can pay the seller
+    Database::ShardGuard dbShard(0);
+
     DEBUG_LOG("WORLD: HandleAuctionPlaceBid");
 
     ObjectGuid auctioneerGuid;
@@ -449,6 +455,9 @@ void WorldSession::HandleAuctionPlaceBid(WorldPacket& recv_data)
 // this void is called when auction_owner cancels his auction
 void WorldSession::HandleAuctionRemoveItem(WorldPacket& recv_data)
 {
+    // cancelling refunds the bidder by mail
+    Database::ShardGuard dbShard(0);
+
     DEBUG_LOG("WORLD: HandleAuctionRemoveItem");
 
     ObjectGuid auctioneerGuid;
@@ -563,43 +563,53 @@ AuctionHouseEntry const* AuctionHouseMgr::GetAuctionHouseEntry(Unit* unit)
 void AuctionHouseObject::Update()
 {
     time_t curTime = sWorld.GetGameTime();
-    ///- Handle expired auctions
-    for (AuctionEntryMap::iterator itr = AuctionsMap.begin(); itr != AuctionsMap.end();)
+    ///- Collect expired auctions
+    // runs next to map updates, so mails and item transfers that touch online players are handled by the world thread
+    std::vector<uint32> expired;
+    for (AuctionEntryMap::const_iterator itr = AuctionsMap.begin(); itr != AuctionsMap.end(); ++itr)
     {
-        if (itr->second->moneyDeliveryTime)                 // pending auction
-        {
-            if (curTime > itr->second->moneyDeliveryTime)
-            {
-                sAuctionMgr.SendAuctionSuccessfulMail(itr->second);
+        time_t endTime = itr->second->moneyDeliveryTime ? itr->second->moneyDeliveryTime : itr->second->expireTime;
+        if (curTime > endTime)
+            expired.push_back(itr->first);
+    }
 
-                itr->second->DeleteFromDB();
-                MANGOS_ASSERT(!itr->second->itemGuidLow);   // already removed or send in mail at won
-                delete itr->second;
-                AuctionsMap.erase(itr++);
-                continue;
-            }
-        }
-        else                                                // active auction
-        {
-            if (curTime > itr->second->expireTime)
-            {
-                ///- perform the transaction if there was bidder
-                if (itr->second->bid)
-                    itr->second->AuctionBidWinning();
-                ///- cancel the auction if there was no bidder and clear the auction
-                else
-                {
-                    sAuctionMgr.SendAuctionExpiredMail(itr->second);
+    if (expired.empty())
+        return;
 
-                    itr->second->DeleteFromDB();
-                    delete itr->second;
-                    AuctionsMap.erase(itr++);
-                    continue;
-                }
-            }
-        }
+    sWorld.GetMessager().AddMessage([this, expired](World*)
+    {
+        for (uint32 id : expired)
+            HandleExpiredAuction(id);
+    });
+}
+
+void AuctionHouseObject::HandleExpiredAuction(uint32 id)
+{
+    AuctionEntryMap::iterator itr = AuctionsMap.find(id);
+    if (itr == AuctionsMap.end())                           // bought out or cancelled meanwhile
+        return;
+
+    AuctionEntry* auction = itr->second;
+    if (auction->moneyDeliveryTime)                         // pending auction
+    {
+        sAuctionMgr.SendAuctionSuccessfulMail(auction);
+
+        auction->DeleteFromDB();
+        MANGOS_ASSERT(!auction->itemGuidLow);               // already removed or send in mail at won
+        delete auction;
+        AuctionsMap.erase(itr);
+    }
+    ///- perform the transaction if there was bidder
+    else if (auction->bid)
+        auction->AuctionBidWinning();
+    ///- cancel the auction if there was no bidder and clear the auction
+    else
+    {
+        sAuctionMgr.SendAuctionExpiredMail(auction);
 
-        ++itr;
+        auction->DeleteFromDB();
+        delete auction;
+        AuctionsMap.erase(itr);
     }
 }
 
@@ -131,6 +131,8 @@ class AuctionHouseObject
 
         AuctionEntry* AddAuction(AuctionHouseEntry const* auctionHouseEntry, Item* newItem, uint32 etime, uint32 bid, uint32 buyout = 0, uint32 deposit = 0, Player* pl = nullptr);
     private:
+        void HandleExpiredAuction(uint32 id);
+
         AuctionEntryMap AuctionsMap;
 };
 
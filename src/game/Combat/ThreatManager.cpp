@@ -235,6 +235,24 @@ void ThreatContainer::clearReferences()
         delete (*i);
     }
     iThreatList.clear();
+    iReferenceIndex.clear();
+}
+
+void ThreatContainer::remove(HostileReference* ref)
+{
+    auto itr = iReferenceIndex.find(ref->getUnitGuid());
+    if (itr == iReferenceIndex.end() || *itr->second != ref)
+        return;
+
+    // keep the order, the list stays sorted
+    iThreatList.erase(itr->second);
+    iReferenceIndex.erase(itr);
+}
+
+void ThreatContainer::addReference(HostileReference* hostileReference)
+{
+    iThreatList.push_back(hostileReference);
+    iReferenceIndex[hostileReference->getUnitGuid()] = std::prev(iThreatList.end());
 }
 
 //============================================================
@@ -245,13 +263,8 @@ HostileReference* ThreatContainer::getReferenceByTarget(Unit* victim)
     if (!victim)
         return nullptr;
 
-    ObjectGuid guid = victim->GetObjectGuid();
-
-    for (ThreatList::const_iterator i = iThreatList.begin(); i != iThreatList.end(); ++i)
-        if ((*i)->getUnitGuid() == guid)
-            return (*i);
-
-    return nullptr;
+    auto itr = iReferenceIndex.find(victim->GetObjectGuid());
+    return itr != iReferenceIndex.end() ? *itr->second : nullptr;
 }
 
 //============================================================
@@ -352,9 +365,6 @@ HostileReference* ThreatContainer::selectNextVictim(Unit* attacker, HostileRefer
     if (suppressRanged && currentVictim)
         currentVictimInMelee = attacker->CanReachWithMeleeAttack(currentVictim->getTarget());
 
-    ThreatList::const_iterator lastRef = iThreatList.end();
-    --lastRef;
-
     for (ThreatList::const_iterator iter = iThreatList.begin(); iter != iThreatList.end() && !found;)
     {
         currentRef = (*iter);
@@ -26,6 +26,7 @@
 #include "Timer.h"
 #include "Entities/ObjectGuid.h"
 #include <list>
+#include <unordered_map>
 
 //==============================================================
 
@@ -147,6 +148,8 @@ class HostileReference : public Reference<Unit, ThreatManager>
 //==============================================================
 class ThreatManager;
 
+// kept sorted by ThreatContainer::update, most hated first
+// a list, threat events add and remove references while AI and scripts iterate over it
 typedef std::list<HostileReference*> ThreatList;
 
 class ThreatContainer
@@ -176,14 +179,15 @@ class ThreatContainer
     protected:
         friend class ThreatManager;
 
-        void remove(HostileReference* ref) { iThreatList.remove(ref); }
-        void addReference(HostileReference* hostileReference) { iThreatList.push_back(hostileReference); }
+        void remove(HostileReference* ref);
+        void addReference(HostileReference* hostileReference);
         void clearReferences();
         // Sort the list if necessary
         void update(bool force, bool isPlayer);
 
         ThreatList iThreatList;
     private:
+        std::unordered_map<ObjectGuid, ThreatList::iterator> iReferenceIndex;
         bool iDirty;
 };
 
@@ -687,9 +687,13 @@ void Creature::Update(const uint32 diff)
 
                 GetMap()->Add(this);
 
+                // pools spawn and despawn map wide, a region leaves that to the map thread
                 if (GetObjectGuid().GetHigh() != HIGHGUID_PET)
                     if (uint16 poolid = sPoolMgr.IsPartOfAPool<Creature>(m_dbGuid))
-                        sPoolMgr.UpdatePool<Creature>(*GetMap()->GetPersistentState(), poolid, m_dbGuid);
+                        GetMap()->RunAfterUpdateRegions([poolid, dbGuid = m_dbGuid](Map* map)
+                        {
+                            sPoolMgr.UpdatePool<Creature>(*map->GetPersistentState(), poolid, dbGuid);
+                        });
             }
             break;
         }
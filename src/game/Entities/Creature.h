@@ -24,6 +24,7 @@
 #include "Globals/SharedDefines.h"
 #include "Server/DBCEnums.h"
 #include "Util.h"
+#include "Maps/MapObjectPool.h"
 
 #include <list>
 #include <memory>
@@ -613,6 +614,10 @@ class Creature : public Unit
         explicit Creature(CreatureSubtype subtype = CREATURE_SUBTYPE_GENERIC);
         virtual ~Creature();
 
+        // allocated from the object pool of the map in update, see MapObjectPool
+        static void* operator new(size_t size) { return MapObjectPool::Allocate(size, MAP_POOL_CREATURE); }
+        static void operator delete(void* ptr) { MapObjectPool::Deallocate(ptr); }
+
         void AddToWorld() override;
         void RemoveFromWorld() override;
         virtual void CleanupsBeforeDelete() override;
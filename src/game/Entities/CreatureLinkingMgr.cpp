@@ -337,6 +337,9 @@ void CreatureLinkingHolder::AddSlaveToHolder(Creature* pCreature)
     if (!pInfo)
         return;
 
+    // the holder is shared by all update regions of the map
+    auto guard = pCreature->GetMap()->LockForUpdateRegion();
+
     if (pInfo->mapId == INVALID_MAP_ID)                     // Guid case, store master->slaves for fast access
     {
         HolderMapBounds bounds = m_holderGuidMap.equal_range(pInfo->masterId);
@@ -395,6 +398,8 @@ void CreatureLinkingHolder::AddMasterToHolder(Creature* pCreature)
     if (!sCreatureLinkingMgr.IsLinkedMaster(pCreature))
         return;
 
+    auto guard = pCreature->GetMap()->LockForUpdateRegion();
+
     // Check, if already stored
     BossGuidMapBounds bounds = m_masterGuid.equal_range(pCreature->GetEntry());
     for (BossGuidMap::const_iterator itr = bounds.first; itr != bounds.second; ++itr)
@@ -418,6 +423,9 @@ void CreatureLinkingHolder::DoCreatureLinkingEvent(CreatureLinkingEvent eventTyp
     if (eventType == LINKING_EVENT_AGGRO && !pEnemy)
         return;
 
+    // linked NPCs share the update region of pSource, the lock guards the holder itself
+    auto guard = pSource->GetMap()->LockForUpdateRegion();
+
     uint32 eventFlagFilter = 0;
     uint32 reverseEventFlagFilter = 0;
 
@@ -675,6 +683,7 @@ bool CreatureLinkingHolder::CanSpawn(Creature* pCreature) const
 
     float sx, sy, sz;
     pCreature->GetRespawnCoord(sx, sy, sz);
+    auto guard = pCreature->GetMap()->LockForUpdateRegion();
     return CanSpawn(0, pCreature->GetMap(), pInfo, sx, sy);
 }
 
@@ -751,6 +760,8 @@ bool CreatureLinkingHolder::TryFollowMaster(Creature* pCreature)
     if (!pInfo || !(pInfo->linkingFlag & FLAG_FOLLOW))
         return false;
 
+    auto guard = pCreature->GetMap()->LockForUpdateRegion();
+
     Creature* pMaster = nullptr;
     if (pInfo->mapId != INVALID_MAP_ID)                     // entry case
     {
@@ -778,4 +789,36 @@ bool CreatureLinkingHolder::TryFollowMaster(Creature* pCreature)
     return false;
 }
 
+// Function to collect the masters and slaves events of this NPC can reach, whatever their distance
+void CreatureLinkingHolder::GetLinkedCreatureGuids(Creature* pCreature, GuidList& linkedGuids) const
+{
+    // Slaves (by entry)
+    auto bounds = m_holderMap.equal_range(pCreature->GetEntry());
+    for (HolderMap::const_iterator itr = bounds.first; itr != bounds.second; ++itr)
+        linkedGuids.insert(linkedGuids.end(), itr->second.linkedGuids.begin(), itr->second.linkedGuids.end());
+
+    // Slaves (by guid)
+    bounds = m_holderGuidMap.equal_range(pCreature->GetGUIDLow());
+    for (HolderMap::const_iterator itr = bounds.first; itr != bounds.second; ++itr)
+        linkedGuids.insert(linkedGuids.end(), itr->second.linkedGuids.begin(), itr->second.linkedGuids.end());
+
+    // Masters
+    CreatureLinkingInfo const* pInfo = sCreatureLinkingMgr.GetLinkedTriggerInformation(pCreature);
+    if (!pInfo)
+        return;
+
+    if (pInfo->mapId != INVALID_MAP_ID)                     // entry case
+    {
+        BossGuidMapBounds finds = m_masterGuid.equal_range(pInfo->masterId);
+        for (BossGuidMap::const_iterator itr = finds.first; itr != finds.second; ++itr)
+            linkedGuids.push_back(itr->second);
+    }
+    else                                                    // guid case
+    {
+        CreatureData const* masterData = sObjectMgr.GetCreatureData(pInfo->masterDBGuid);
+        CreatureInfo const* cInfo = ObjectMgr::GetCreatureTemplate(masterData->id);
+        linkedGuids.push_back(ObjectGuid(cInfo->GetHighGuid(), cInfo->Entry, pInfo->masterDBGuid));
+    }
+}
+
 /*! @} */
@@ -165,6 +165,9 @@ class CreatureLinkingHolder
         // This function lets a slave refollow his master
         bool TryFollowMaster(Creature* pCreature);
 
+        // Function to collect the masters and slaves events of this NPC can reach, whatever their distance
+        void GetLinkedCreatureGuids(Creature* pCreature, GuidList& linkedGuids) const;
+
     private:
         // Structure associated to a master (entry case)
         struct InfoAndGuids
@@ -23,6 +23,7 @@
 #include "Server/DBCEnums.h"
 #include "Spells/SpellTargetDefines.h"
 #include "Entities/Unit.h"
+#include "Maps/MapObjectPool.h"
 
 enum DynamicObjectType
 {
@@ -38,6 +39,10 @@ class DynamicObject : public WorldObject
     public:
         explicit DynamicObject();
 
+        // allocated from the object pool of the map in update, see MapObjectPool
+        static void* operator new(size_t size) { return MapObjectPool::Allocate(size, MAP_POOL_DYNAMICOBJECT); }
+        static void operator delete(void* ptr) { MapObjectPool::Deallocate(ptr); }
+
         void AddToWorld() override;
         void RemoveFromWorld() override;
 
@@ -695,8 +695,12 @@ void GameObject::Update(const uint32 diff)
                 SaveRespawnTime();
 
             // if part of pool, let pool system schedule new spawn instead of just scheduling respawn
+            // pools spawn and despawn map wide, a region leaves that to the map thread
             if (uint16 poolid = sPoolMgr.IsPartOfAPool<GameObject>(m_dbGuid))
-                sPoolMgr.UpdatePool<GameObject>(*GetMap()->GetPersistentState(), poolid, m_dbGuid);
+                GetMap()->RunAfterUpdateRegions([poolid, dbGuid = m_dbGuid](Map* map)
+                {
+                    sPoolMgr.UpdatePool<GameObject>(*map->GetPersistentState(), poolid, dbGuid);
+                });
 
             // can be not in world at pool despawn
             if (IsInWorld())
@@ -752,7 +756,10 @@ void GameObject::Delete()
         AI()->JustDespawned();
 
     if (uint16 poolid = sPoolMgr.IsPartOfAPool<GameObject>(m_dbGuid))
-        sPoolMgr.UpdatePool<GameObject>(*GetMap()->GetPersistentState(), poolid, m_dbGuid);
+        GetMap()->RunAfterUpdateRegions([poolid, dbGuid = m_dbGuid](Map* map)
+        {
+            sPoolMgr.UpdatePool<GameObject>(*map->GetPersistentState(), poolid, dbGuid);
+        });
     else
         AddObjectToRemoveList();
 
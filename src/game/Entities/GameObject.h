@@ -27,6 +27,7 @@
 #include "Spells/SpellAuras.h"
 #include "Spells/SpellDefines.h"
 #include "Entities/GameObjectDefines.h"
+#include "Maps/MapObjectPool.h"
 
 // GCC have alternative #pragma pack(N) syntax and old gcc version not support pack(push,N), also any gcc version not support it at some platform
 #if defined( __GNUC__ )
@@ -710,6 +711,10 @@ class GameObject : public WorldObject
         explicit GameObject();
         ~GameObject();
 
+        // allocated from the object pool of the map in update, see MapObjectPool
+        static void* operator new(size_t size) { return MapObjectPool::Allocate(size, MAP_POOL_GAMEOBJECT); }
+        static void operator delete(void* ptr) { MapObjectPool::Deallocate(ptr); }
+
         static GameObject* CreateGameObject(uint32 entry);
 
         void AddToWorld() override;
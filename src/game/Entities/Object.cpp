@@ -47,6 +47,9 @@
 #include "Spells/SpellMgr.h"
 #include "MotionGenerators/PathFinder.h"
 
+std::atomic<uint64> Object::s_valuesBlocksBuilt(0);
+std::atomic<uint64> Object::s_valuesBlocksSent(0);
+
 Object::Object(): m_updateFlag(0), m_itsNewObject(false)
 {
     m_objectTypeId      = TYPEID_OBJECT;
@@ -220,6 +223,100 @@ void Object::BuildValuesUpdateBlockForPlayer(UpdateData* data, Player* target) c
     data->AddUpdateBlock(buf);
 }
 
+// unit fields replaced by zero for viewers that are not allowed to see the stats under fog of war
+static bool IsFogOfWarStatsField(uint16 index)
+{
+    return index == UNIT_FIELD_RANGEDATTACKTIME ||
+           index == UNIT_FIELD_MINDAMAGE || index == UNIT_FIELD_MAXDAMAGE ||
+           index == UNIT_FIELD_MINOFFHANDDAMAGE || index == UNIT_FIELD_MAXOFFHANDDAMAGE ||
+           (index >= UNIT_FIELD_STAT0 && index < UNIT_FIELD_BASE_MANA) ||
+           index == UNIT_FIELD_BASE_HEALTH || index == UNIT_FIELD_ATTACK_POWER ||
+           index == UNIT_FIELD_ATTACK_POWER_MODS || index == UNIT_FIELD_ATTACK_POWER_MULTIPLIER ||
+           index == UNIT_FIELD_RANGED_ATTACK_POWER || index == UNIT_FIELD_RANGED_ATTACK_POWER_MODS ||
+           index == UNIT_FIELD_RANGED_ATTACK_POWER_MULTIPLIER || index == UNIT_FIELD_MINRANGEDDAMAGE ||
+           index == UNIT_FIELD_MAXRANGEDDAMAGE || (index >= UNIT_FIELD_POWER_COST_MODIFIER && index <= UNIT_FIELD_MAXHEALTHMODIFIER);
+}
+
+enum ValuesUpdateViewerKey
+{
+    VALUES_UPDATE_VIEWER_ACTIVATE_TO_QUEST  = 0x01,
+    VALUES_UPDATE_VIEWER_CASTER_AURASTATE   = 0x02,
+    VALUES_UPDATE_VIEWER_FOW_HEALTH         = 0x04,
+    VALUES_UPDATE_VIEWER_FOW_STATS          = 0x08,
+    VALUES_UPDATE_VIEWER_GAMEMASTER         = 0x10,
+
+    VALUES_UPDATE_VIEWER_UNIQUE             = 0xFFFFFFFF,   // block has to be built for this viewer alone
+};
+
+// values blocks of one object already serialized during the current client update pass
+struct ValuesUpdateBlockCache
+{
+    struct Entry
+    {
+        UpdateMask mask;
+        uint32 viewerKey;
+        ByteBuffer block;
+    };
+
+    std::vector<Entry> entries;
+};
+
+void Object::BuildValuesUpdateBlockForPlayer(UpdateData* data, Player* target, ValuesUpdateBlockCache& cache) const
+{
+    UpdateMask updateMask;
+    updateMask.SetCount(m_valuesCount);
+
+    _SetUpdateBits(&updateMask, target);
+
+    uint32 viewerKey = GetValuesUpdateViewerKey(updateMask, target);
+    if (viewerKey != VALUES_UPDATE_VIEWER_UNIQUE)
+    {
+        for (auto const& entry : cache.entries)
+        {
+            if (entry.viewerKey == viewerKey && entry.mask == updateMask)
+            {
+                data->AddUpdateBlock(entry.block);
+                ++s_valuesBlocksSent;
+                return;
+            }
+        }
+    }
+
+    if (viewerKey == VALUES_UPDATE_VIEWER_UNIQUE)
+    {
+        ByteBuffer buf(500);
+
+        buf << uint8(UPDATETYPE_VALUES);
+        buf << GetPackGUID();
+
+        BuildValuesUpdate(UPDATETYPE_VALUES, &buf, &updateMask, target);
+        data->AddUpdateBlock(buf);
+    }
+    else
+    {
+        // BuildValuesUpdate may add bits to the mask, the cache is keyed by the one _SetUpdateBits produced
+        cache.entries.push_back({ updateMask, viewerKey, ByteBuffer(500) });
+        ByteBuffer& buf = cache.entries.back().block;
+
+        buf << uint8(UPDATETYPE_VALUES);
+        buf << GetPackGUID();
+
+        BuildValuesUpdate(UPDATETYPE_VALUES, &buf, &updateMask, target);
+        data->AddUpdateBlock(buf);
+    }
+
+    ++s_valuesBlocksBuilt;
+    ++s_valuesBlocksSent;
+}
+
+Object::SharedUpdateStats Object::ConsumeSharedUpdateStats()
+{
+    SharedUpdateStats stats;
+    stats.blocksBuilt = s_valuesBlocksBuilt.exchange(0);
+    stats.blocksSent = s_valuesBlocksSent.exchange(0);
+    return stats;
+}
+
 void Object::BuildForcedValuesUpdateBlockForPlayer(UpdateData* data, Player* target) const
 {
     ByteBuffer buf(500);
@@ -448,6 +545,76 @@ void Object::BuildMovementUpdate(ByteBuffer* data, uint16 updateFlags) const
     }
 }
 
+// Must follow every target dependent branch of BuildValuesUpdate for UPDATETYPE_VALUES,
+// two viewers with the same mask and key receive byte identical blocks
+uint32 Object::GetValuesUpdateViewerKey(UpdateMask const& updateMask, Player* target) const
+{
+    if (target == this)
+        return VALUES_UPDATE_VIEWER_UNIQUE;
+
+    uint32 key = 0;
+
+    if (isType(TYPEMASK_UNIT))
+    {
+        Unit const* unit = static_cast<Unit const*>(this);
+
+        if (unit->HasAuraState(AURA_STATE_CONFLAGRATE) && unit->HasAuraStateForCaster(AURA_STATE_CONFLAGRATE, target->GetObjectGuid()))
+            key |= VALUES_UPDATE_VIEWER_CASTER_AURASTATE;
+
+        bool health = false;
+        bool stats = false;
+        for (uint16 index = 0; index < m_valuesCount; ++index)
+        {
+            if (!updateMask.GetBit(index))
+                continue;
+
+            switch (index)
+            {
+                case UNIT_NPC_FLAGS:
+                    if (GetTypeId() == TYPEID_UNIT)         // trainer, quest and spellclick checks
+                        return VALUES_UPDATE_VIEWER_UNIQUE;
+                    break;
+                case UNIT_DYNAMIC_FLAGS:                    // loot, tap and tracking flags
+                    return VALUES_UPDATE_VIEWER_UNIQUE;
+                case UNIT_FIELD_FACTIONTEMPLATE:
+                    if (GetTypeId() == TYPEID_PLAYER && sWorld.getConfig(CONFIG_BOOL_ALLOW_TWO_SIDE_INTERACTION_GROUP))
+                        return VALUES_UPDATE_VIEWER_UNIQUE;
+                    break;
+                case UNIT_FIELD_HEALTH:
+                case UNIT_FIELD_MAXHEALTH:
+                    health = true;
+                    break;
+                case UNIT_FIELD_FLAGS:
+                    if (target->IsGameMaster())
+                        key |= VALUES_UPDATE_VIEWER_GAMEMASTER;
+                    break;
+                default:
+                    // base attack time range is sent converted before fog of war is checked
+                    if (!(index >= UNIT_FIELD_BASEATTACKTIME && index <= UNIT_FIELD_RANGEDATTACKTIME) && IsFogOfWarStatsField(index))
+                        stats = true;
+                    break;
+            }
+        }
+
+        if (health && unit->IsFogOfWarVisibleHealth(target))
+            key |= VALUES_UPDATE_VIEWER_FOW_HEALTH;
+        if (stats && unit->IsFogOfWarVisibleStats(target))
+            key |= VALUES_UPDATE_VIEWER_FOW_STATS;
+    }
+    else if (isType(TYPEMASK_CORPSE))
+    {
+        if (updateMask.GetBit(CORPSE_FIELD_BYTES_1) && sWorld.getConfig(CONFIG_BOOL_ALLOW_TWO_SIDE_INTERACTION_GROUP))
+            return VALUES_UPDATE_VIEWER_UNIQUE;
+    }
+    else if (isType(TYPEMASK_GAMEOBJECT) && !((GameObject*)this)->IsDynTransport())
+    {
+        if (((GameObject*)this)->ActivateToQuest(target) || target->IsGameMaster())
+            key |= VALUES_UPDATE_VIEWER_ACTIVATE_TO_QUEST;
+    }
+
+    return key;
+}
+
 void Object::BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, UpdateMask* updateMask, Player* target) const
 {
     if (!target)
@@ -600,16 +767,7 @@ void Object::BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, UpdateMask* u
                     *data << value;
                 }
                 // Fog of War: hide stat values for non-allied units according to settings
-                else if ((index == UNIT_FIELD_RANGEDATTACKTIME ||
-                          index == UNIT_FIELD_MINDAMAGE || index == UNIT_FIELD_MAXDAMAGE ||
-                          index == UNIT_FIELD_MINOFFHANDDAMAGE || index == UNIT_FIELD_MAXOFFHANDDAMAGE ||
-                          (index >= UNIT_FIELD_STAT0 && index < UNIT_FIELD_BASE_MANA) ||
-                          index == UNIT_FIELD_BASE_HEALTH || index == UNIT_FIELD_ATTACK_POWER ||
-                          index == UNIT_FIELD_ATTACK_POWER_MODS || index == UNIT_FIELD_ATTACK_POWER_MULTIPLIER ||
-                          index == UNIT_FIELD_RANGED_ATTACK_POWER || index == UNIT_FIELD_RANGED_ATTACK_POWER_MODS ||
-                          index == UNIT_FIELD_RANGED_ATTACK_POWER_MULTIPLIER || index == UNIT_FIELD_MINRANGEDDAMAGE ||
-                          index == UNIT_FIELD_MAXRANGEDDAMAGE || (index >= UNIT_FIELD_POWER_COST_MODIFIER && index <= UNIT_FIELD_MAXHEALTHMODIFIER)) &&
-                          !static_cast<const Unit*>(this)->IsFogOfWarVisibleStats(target))
+                else if (IsFogOfWarStatsField(index) && !static_cast<const Unit*>(this)->IsFogOfWarVisibleStats(target))
                 {
                     *data << uint32(0);
                 }
@@ -1173,6 +1331,11 @@ void Object::BuildUpdateDataForPlayer(Player* pl, UpdateDataMapType& update_play
     BuildValuesUpdateBlockForPlayer(&iter->second, iter->first);
 }
 
+void Object::BuildUpdateDataForPlayer(Player* pl, UpdateDataMapType& update_players, ValuesUpdateBlockCache& cache) const
+{
+    BuildValuesUpdateBlockForPlayer(&update_players[pl], pl, cache);
+}
+
 void Object::AddToClientUpdateList()
 {
     sLog.outError("Unexpected call of Object::AddToClientUpdateList for object (TypeId: %u Update fields: %u)", GetTypeId(), m_valuesCount);
@@ -1216,9 +1379,16 @@ void Object::ForceValuesUpdateAtIndex(uint16 index)
 WorldObject::WorldObject() :
     m_transportInfo(nullptr), m_isOnEventNotified(false),
     m_currMap(nullptr), m_mapId(0),
-    m_InstanceId(0), m_phaseMask(PHASEMASK_NORMAL), m_isActiveObject(false), m_visibilityData(this),
-    m_debugFlags(0), m_transport(nullptr), m_destLocCounter(0)
+    m_InstanceId(0), m_phaseMask(PHASEMASK_NORMAL), m_cellIndex(nullptr), m_cellIndexSlot(0),
+    m_isActiveObject(false), m_visibilityData(this), m_debugFlags(0), m_transport(nullptr), m_destLocCounter(0)
+{
+}
+
+WorldObject::~WorldObject()
 {
+    // grid unloading deletes objects without removing them from their cell first
+    if (m_cellIndex)
+        m_cellIndex->Remove(this);
 }
 
 void WorldObject::CleanupsBeforeDelete()
@@ -1239,6 +1409,9 @@ void WorldObject::Relocate(float x, float y, float z, float orientation)
     m_position.z = z;
     m_position.o = orientation;
 
+    if (m_cellIndex)
+        m_cellIndex->Relocate(m_cellIndexSlot, x, y, z);
+
     if (isType(TYPEMASK_UNIT))
         m_movementInfo.ChangePosition(x, y, z, orientation);
 }
@@ -1249,6 +1422,9 @@ void WorldObject::Relocate(float x, float y, float z)
     m_position.y = y;
     m_position.z = z;
 
+    if (m_cellIndex)
+        m_cellIndex->Relocate(m_cellIndexSlot, x, y, z);
+
     if (isType(TYPEMASK_UNIT))
         m_movementInfo.ChangePosition(x, y, z, GetOrientation());
 }
@@ -1261,6 +1437,12 @@ void WorldObject::SetOrientation(float orientation)
         m_movementInfo.ChangeOrientation(orientation);
 }
 
+void WorldObject::UpdateCellIndexReach()
+{
+    if (m_cellIndex)
+        m_cellIndex->SetReach(m_cellIndexSlot, std::max(GetObjectBoundingRadius(), GetCombatReach()));
+}
+
 uint32 WorldObject::GetZoneId() const
 {
     return GetTerrain()->GetZoneId(m_position.x, m_position.y, m_position.z);
@@ -2461,6 +2643,7 @@ struct WorldObjectChangeAccumulator
 {
     UpdateDataMapType& i_updateDatas;
     WorldObject& i_object;
+    ValuesUpdateBlockCache i_blockCache;                    // viewers with equal masks share one serialized block
     WorldObjectChangeAccumulator(WorldObject& obj, UpdateDataMapType& d) : i_updateDatas(d), i_object(obj)
     {
         // send self fields changes in another way, otherwise
@@ -2475,7 +2658,7 @@ struct WorldObjectChangeAccumulator
         {
             Player* owner = iter.getSource()->GetOwner();
             if (owner != &i_object && owner->HaveAtClient(&i_object))
-                i_object.BuildUpdateDataForPlayer(owner, i_updateDatas);
+                i_object.BuildUpdateDataForPlayer(owner, i_updateDatas, i_blockCache);
         }
     }
 
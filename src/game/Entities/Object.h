@@ -33,6 +33,7 @@
 #include "Entities/ObjectVisibility.h"
 #include "Grids/Cell.h"
 
+#include <atomic>
 #include <set>
 
 enum TempSpawnType
@@ -117,6 +118,7 @@ class ChatHandler;
 struct SpellEntry;
 class Spell;
 class GenericTransport;
+struct ValuesUpdateBlockCache;
 
 typedef std::unordered_map<Player*, UpdateData> UpdateDataMapType;
 
@@ -403,7 +405,17 @@ class Object
         void SendForcedObjectUpdate();
 
         void BuildValuesUpdateBlockForPlayer(UpdateData* data, Player* target) const;
+        void BuildValuesUpdateBlockForPlayer(UpdateData* data, Player* target, ValuesUpdateBlockCache& cache) const;
         void BuildForcedValuesUpdateBlockForPlayer(UpdateData* data, Player* target) const;
+
+        struct SharedUpdateStats
+        {
+            uint64 blocksBuilt;                             // values blocks serialized
+            uint64 blocksSent;                              // values blocks appended to viewers
+        };
+
+        // totals over all threads since the previous call
+        static SharedUpdateStats ConsumeSharedUpdateStats();
         void BuildOutOfRangeUpdateBlock(UpdateData* data) const;
         void BuildMovementUpdateBlock(UpdateData* data, uint16 flags = 0) const;
 
@@ -614,6 +626,13 @@ class Object
         void BuildMovementUpdate(ByteBuffer* data, uint16 updateFlags) const;
         void BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, UpdateMask* updateMask, Player* target) const;
         void BuildUpdateDataForPlayer(Player* pl, UpdateDataMapType& update_players) const;
+        void BuildUpdateDataForPlayer(Player* pl, UpdateDataMapType& update_players, ValuesUpdateBlockCache& cache) const;
+
+        // returns the part of the target that BuildValuesUpdate output depends on for this mask, or VALUES_UPDATE_VIEWER_UNIQUE
+        uint32 GetValuesUpdateViewerKey(UpdateMask const& updateMask, Player* target) const;
+
+        static std::atomic<uint64> s_valuesBlocksBuilt;
+        static std::atomic<uint64> s_valuesBlocksSent;
 
         uint16 m_objectType;
 
@@ -896,9 +915,10 @@ inline ByteBuffer& operator>> (ByteBuffer& buf, MovementInfo& mi)
 class WorldObject : public Object
 {
         friend struct WorldObjectChangeAccumulator;
+        friend class CellIndex;
 
     public:
-        virtual ~WorldObject() {}
+        virtual ~WorldObject();
 
         virtual void Update(const uint32 /*diff*/) {}
 
@@ -912,6 +932,7 @@ class WorldObject : public Object
         void Relocate(float x, float y, float z);
 
         void SetOrientation(float orientation);
+        void UpdateCellIndexReach();                        // call after bounding radius or combat reach changed
 
         float GetPositionX() const { return m_position.x; }
         float GetPositionY() const { return m_position.y; }
@@ -1223,6 +1244,8 @@ class WorldObject : public Object
         uint32 m_phaseMask;                                 // in area phase state
 
         Position m_position;
+        CellIndex* m_cellIndex;                             // spatial index of the cell the object is listed in
+        uint32 m_cellIndexSlot;
         ViewPoint m_viewPoint;
         bool m_isActiveObject;
         uint64 m_debugFlags;
@@ -68,6 +68,7 @@
 #include "Loot/LootMgr.h"
 #include "World/WorldStateDefines.h"
 #include "World/WorldState.h"
+#include "Metric/Metric.h"
 
 #ifdef BUILD_PLAYERBOT
 #include "PlayerBot/Base/PlayerbotAI.h"
@@ -144,6 +145,10 @@ enum CharacterCustomizeFlags
 #define DEATH_EXPIRE_STEP (5*MINUTE)
 #define MAX_DEATH_COUNT 3
 
+// values kept per row to compare saves, see _SaveAuras and _SaveSpellCooldowns
+#define AURA_SAVE_ROW_SIZE (8 + 2 * MAX_EFFECT_INDEX)
+#define COOLDOWN_SAVE_ROW_SIZE 5
+
 static const uint32 corpseReclaimDelay[MAX_DEATH_COUNT] = {30, 60, 120};
 
 MirrorTimer::Status MirrorTimer::FetchStatus()
@@ -593,6 +598,8 @@ Player::Player(WorldSession* session): Unit(), m_taxiTracker(*this), m_mover(thi
     //////////////////// Rest System/////////////////////
 
     m_mailsUpdated = false;
+    m_characterRowSaved = false;
+    m_enteredInstancesChanged = false;
     unReadMails = 0;
     m_nextMailDelivereTime = 0;
 
@@ -3940,13 +3947,11 @@ void Player::_LoadSpellCooldowns(QueryResult* result)
 void Player::_SaveSpellCooldowns()
 {
     static SqlStatementID deleteSpellCooldown;
-
-    // delete all old cooldown
-    SqlStatement stmt = CharacterDatabase.CreateStatement(deleteSpellCooldown, "DELETE FROM character_spell_cooldown WHERE guid = ?");
-    stmt.PExecute(GetGUIDLow());
-
     static SqlStatementID insertSpellCooldown;
 
+    // expire times are absolute, so the rows only differ from the last save when cooldowns started or ended
+    std::vector<int64> rows(1, 0);                          // row count, then spell, spell expire, category, category expire, item
+
     for (auto& cdItr : m_cooldownMap)
     {
         auto& cdData = cdItr.second;
@@ -3956,19 +3961,36 @@ void Player::_SaveSpellCooldowns()
             TimePoint cTime = TimePoint::min();
             cdData->GetSpellCDExpireTime(sTime);
             cdData->GetCatCDExpireTime(cTime);
-            uint64 spellExpireTime = uint64(Clock::to_time_t(sTime));
-            uint64 catExpireTime = uint64(Clock::to_time_t(cTime));
 
-            stmt = CharacterDatabase.CreateStatement(insertSpellCooldown, "INSERT INTO character_spell_cooldown (guid, SpellId, SpellExpireTime, Category, CategoryExpireTime, ItemId) VALUES( ?, ?, ?, ?, ?, ?)");
-            stmt.addUInt32(GetGUIDLow());
-            stmt.addUInt32(cdData->GetSpellId());
-            stmt.addUInt64(spellExpireTime);
-            stmt.addUInt32(cdData->GetCategory());
-            stmt.addUInt64(catExpireTime);
-            stmt.addUInt32(cdData->GetItemId());
-            stmt.Execute();
+            rows.push_back(cdData->GetSpellId());
+            rows.push_back(int64(Clock::to_time_t(sTime)));
+            rows.push_back(cdData->GetCategory());
+            rows.push_back(int64(Clock::to_time_t(cTime)));
+            rows.push_back(cdData->GetItemId());
+            ++rows[0];
         }
     }
+
+    if (rows == m_savedCooldownRows)
+        return;
+
+    // delete all old cooldown
+    SqlStatement stmt = CharacterDatabase.CreateStatement(deleteSpellCooldown, "DELETE FROM character_spell_cooldown WHERE guid = ?");
+    stmt.PExecute(GetGUIDLow());
+
+    for (size_t row = 1; row < rows.size(); row += COOLDOWN_SAVE_ROW_SIZE)
+    {
+        stmt = CharacterDatabase.CreateStatement(insertSpellCooldown, "INSERT INTO character_spell_cooldown (guid, SpellId, SpellExpireTime, Category, CategoryExpireTime, ItemId) VALUES( ?, ?, ?, ?, ?, ?)");
+        stmt.addUInt32(GetGUIDLow());
+        stmt.addUInt32(uint32(rows[row]));
+        stmt.addUInt64(uint64(rows[row + 1]));
+        stmt.addUInt32(uint32(rows[row + 2]));
+        stmt.addUInt64(uint64(rows[row + 3]));
+        stmt.addUInt32(uint32(rows[row + 4]));
+        stmt.Execute();
+    }
+
+    m_savedCooldownRows.swap(rows);
 }
 
 uint32 Player::resetTalentsCost() const
@@ -16175,6 +16197,8 @@ bool Player::LoadFromDB(ObjectGuid guid, SqlQueryHolder* holder)
         return false;
     }
 
+    m_characterRowSaved = true;
+
     m_name = fields[2].GetCppString();
 
     // check name limitations
@@ -17751,15 +17775,23 @@ InstancePlayerBind* Player::BindToInstance(DungeonPersistentState* state, bool p
         {
             // update the state when the group kills a boss
             if (permanent != bind.perm || state != bind.state)
+            {
                 if (!load)
-                    CharacterDatabase.PExecute("UPDATE character_instance SET instance = '%u', permanent = '%u' WHERE guid = '%u' AND instance = '%u'",
-                                               state->GetInstanceId(), permanent, GetGUIDLow(), bind.state->GetInstanceId());
+                {
+                    static SqlStatementID updateInstanceBind;
+                    SqlStatement stmt = CharacterDatabase.CreateStatement(updateInstanceBind, "UPDATE character_instance SET instance = ?, permanent = ? WHERE guid = ? AND instance = ?");
+                    stmt.PExecute(state->GetInstanceId(), uint32(permanent), GetGUIDLow(), bind.state->GetInstanceId());
+                }
+            }
         }
         else
         {
             if (!load)
-                CharacterDatabase.PExecute("INSERT INTO character_instance (guid, instance, permanent) VALUES ('%u', '%u', '%u')",
-                                           GetGUIDLow(), state->GetInstanceId(), permanent);
+            {
+                static SqlStatementID insertInstanceBind;
+                SqlStatement stmt = CharacterDatabase.CreateStatement(insertInstanceBind, "INSERT INTO character_instance (guid, instance, permanent) VALUES (?, ?, ?)");
+                stmt.PExecute(GetGUIDLow(), state->GetInstanceId(), uint32(permanent));
+            }
         }
 
         if (bind.state != state)
@@ -17991,6 +18023,9 @@ void Player::SaveToDB()
     // delay auto save at any saves (manual, in code, or autosave)
     m_nextSave = sWorld.getConfig(CONFIG_UINT32_INTERVAL_SAVE);
 
+    // autosave runs outside of the session update, keep it ordered with the other requests of the account
+    Database::ShardGuard dbShard(GetSession()->GetAccountId());
+
     // lets allow only players in world to be saved
     if (IsBeingTeleportedFar())
     {
@@ -18004,142 +18039,18 @@ void Player::SaveToDB()
     DEBUG_FILTER_LOG(LOG_FILTER_PLAYER_STATS, "The value of player %s at save: ", m_name.c_str());
     outDebugStatsValues();
 
-    CharacterDatabase.BeginTransaction();
-
-    static SqlStatementID delChar ;
-    static SqlStatementID insChar ;
-
-    SqlStatement stmt = CharacterDatabase.CreateStatement(delChar, "DELETE FROM characters WHERE guid = ?");
-    stmt.PExecute(GetGUIDLow());
-
-    SqlStatement uberInsert = CharacterDatabase.CreateStatement(insChar, "INSERT INTO characters (guid,account,name,race,class,gender,level,xp,money,playerBytes,playerBytes2,playerFlags,"
-                              "map, dungeon_difficulty, position_x, position_y, position_z, orientation, "
-                              "taximask, online, cinematic, "
-                              "totaltime, leveltime, rest_bonus, logout_time, is_logout_resting, resettalents_cost, resettalents_time, "
-                              "trans_x, trans_y, trans_z, trans_o, transguid, extra_flags, stable_slots, at_login, zone, "
-                              "death_expire_time, taxi_path, arenaPoints, totalHonorPoints, todayHonorPoints, yesterdayHonorPoints, totalKills, "
-                              "todayKills, yesterdayKills, chosenTitle, knownCurrencies, watchedFaction, drunk, health, power1, power2, power3, "
-                              "power4, power5, power6, power7, specCount, activeSpec, exploredZones, equipmentCache, ammoId, knownTitles, actionBars) "
-                              "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, "
-                              "?, ?, ?, ?, ?, ?, "
-                              "?, ?, ?, "
-                              "?, ?, ?, ?, ?, ?, ?, "
-                              "?, ?, ?, ?, ?, ?, ?, ?, ?, "
-                              "?, ?, ?, ?, ?, ?, ?, "
-                              "?, ?, ?, ?, ?, ?, ?, ?, ?, ?, "
-                              "?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?) ");
-
-    uberInsert.addUInt32(GetGUIDLow());
-    uberInsert.addUInt32(GetSession()->GetAccountId());
-    uberInsert.addString(m_name);
-    uberInsert.addUInt8(getRace());
-    uberInsert.addUInt8(getClass());
-    uberInsert.addUInt8(getGender());
-    uberInsert.addUInt32(getLevel());
-    uberInsert.addUInt32(GetUInt32Value(PLAYER_XP));
-    uberInsert.addUInt32(GetMoney());
-    uberInsert.addUInt32(GetUInt32Value(PLAYER_BYTES));
-    uberInsert.addUInt32(GetUInt32Value(PLAYER_BYTES_2));
-    uberInsert.addUInt32(GetUInt32Value(PLAYER_FLAGS));
-
-    if (!IsBeingTeleported())
-    {
-        uberInsert.addUInt32(GetMapId());
-        uberInsert.addUInt32(uint32(GetDungeonDifficulty()));
-        uberInsert.addFloat(finiteAlways(GetPositionX()));
-        uberInsert.addFloat(finiteAlways(GetPositionY()));
-        uberInsert.addFloat(finiteAlways(GetPositionZ()));
-        uberInsert.addFloat(finiteAlways(GetOrientation()));
-    }
-    else
-    {
-        uberInsert.addUInt32(GetTeleportDest().mapid);
-        uberInsert.addUInt32(uint32(GetDungeonDifficulty()));
-        uberInsert.addFloat(finiteAlways(GetTeleportDest().coord_x));
-        uberInsert.addFloat(finiteAlways(GetTeleportDest().coord_y));
-        uberInsert.addFloat(finiteAlways(GetTeleportDest().coord_z));
-        uberInsert.addFloat(finiteAlways(GetTeleportDest().orientation));
-    }
-
+    // the strings are large and change rarely, they are only written when they differ from the last save
     std::ostringstream ss;
     ss << m_taxi;                                   // string with TaxiMaskSize numbers
-    uberInsert.addString(ss);
-
-    uberInsert.addUInt32(IsInWorld() ? 1 : 0);
-
-    uberInsert.addUInt32(m_cinematic);
-
-    uberInsert.addUInt32(m_Played_time[PLAYED_TIME_TOTAL]);
-    uberInsert.addUInt32(m_Played_time[PLAYED_TIME_LEVEL]);
-
-    uberInsert.addFloat(finiteAlways(m_rest_bonus));
-    uberInsert.addUInt64(uint64(time(nullptr)));
-    uberInsert.addUInt32(HasFlag(PLAYER_FLAGS, PLAYER_FLAGS_RESTING) ? 1 : 0);
-    // save, far from tavern/city
-    // save, but in tavern/city
-    uberInsert.addUInt32(m_resetTalentsCost);
-    uberInsert.addUInt64(uint64(m_resetTalentsTime));
-
-    Position const& transportPosition = m_movementInfo.GetTransportPos();
-    uberInsert.addFloat(finiteAlways(transportPosition.x));
-    uberInsert.addFloat(finiteAlways(transportPosition.y));
-    uberInsert.addFloat(finiteAlways(transportPosition.z));
-    uberInsert.addFloat(finiteAlways(transportPosition.o));
-
-    if (m_transport)
-        uberInsert.addUInt32(m_transport->GetGUIDLow());
-    else
-        uberInsert.addUInt32(0);
-
-    uberInsert.addUInt32(m_ExtraFlags);
-
-    uberInsert.addUInt32(uint32(m_stableSlots));            // to prevent save uint8 as char
-
-    uberInsert.addUInt32(uint32(m_atLoginFlags));
-
-    uberInsert.addUInt32(IsInWorld() ? GetZoneId() : GetCachedZoneId());
-
-    uberInsert.addUInt64(uint64(m_deathExpireTime));
-
-    ss << m_taxiTracker.Save();
-    uberInsert.addString(ss);
-
-    uberInsert.addUInt32(GetArenaPoints());
-
-    uberInsert.addUInt32(GetHonorPoints());
-
-    uberInsert.addUInt32(GetUInt32Value(PLAYER_FIELD_TODAY_CONTRIBUTION));
-
-    uberInsert.addUInt32(GetUInt32Value(PLAYER_FIELD_YESTERDAY_CONTRIBUTION));
-
-    uberInsert.addUInt32(GetUInt32Value(PLAYER_FIELD_LIFETIME_HONORBALE_KILLS));
-
-    uberInsert.addUInt16(GetUInt16Value(PLAYER_FIELD_KILLS, 0));
-
-    uberInsert.addUInt16(GetUInt16Value(PLAYER_FIELD_KILLS, 1));
-
-    uberInsert.addUInt32(GetUInt32Value(PLAYER_CHOSEN_TITLE));
-
-    uberInsert.addUInt64(GetUInt64Value(PLAYER_FIELD_KNOWN_CURRENCIES));
-
-    // FIXME: at this moment send to DB as unsigned, including unit32(-1)
-    uberInsert.addUInt32(GetUInt32Value(PLAYER_FIELD_WATCHED_FACTION_INDEX));
-
-    uberInsert.addUInt8(GetDrunkValue());
-
-    uberInsert.addUInt32(GetHealth());
-
-    for (uint32 i = 0; i < MAX_POWERS; ++i)
-        uberInsert.addUInt32(GetPower(Powers(i)));
-
-    uberInsert.addUInt32(uint32(m_specsCount));
-    uberInsert.addUInt32(uint32(m_activeSpec));
+    std::string taxiMask = ss.str();
+    ss.str(std::string());
 
     for (uint32 i = 0; i < PLAYER_EXPLORED_ZONES_SIZE; ++i) // string
     {
         ss << GetUInt32Value(PLAYER_EXPLORED_ZONES_1 + i) << " ";
     }
-    uberInsert.addString(ss);
+    std::string exploredZones = ss.str();
+    ss.str(std::string());
 
     for (uint32 i = 0; i < EQUIPMENT_SLOT_END * 2; ++i)     // string
     {
@@ -18151,19 +18062,104 @@ void Player::SaveToDB()
         ss << (m_items[i] ? m_items[i]->GetEntry() : 0) << " ";
         ss << uint32(MAKE_PAIR32(0, 0)) << " ";
     }
-    uberInsert.addString(ss);
-
-    uberInsert.addUInt32(GetUInt32Value(PLAYER_AMMO_ID));
+    std::string equipmentCache = ss.str();
+    ss.str(std::string());
 
     for (uint32 i = 0; i < KNOWN_TITLES_SIZE * 2; ++i)      // string
     {
         ss << GetUInt32Value(PLAYER__FIELD_KNOWN_TITLES + i) << " ";
     }
-    uberInsert.addString(ss);
+    std::string knownTitles = ss.str();
+    ss.str(std::string());
+
+    CharacterDatabase.BeginTransaction();
 
-    uberInsert.addUInt32(uint32(GetByteValue(PLAYER_FIELD_BYTES, 2)));
+    if (!m_characterRowSaved)
+    {
+        static SqlStatementID delChar ;
+        static SqlStatementID insChar ;
+
+        SqlStatement stmt = CharacterDatabase.CreateStatement(delChar, "DELETE FROM characters WHERE guid = ?");
+        stmt.PExecute(GetGUIDLow());
+
+        SqlStatement uberInsert = CharacterDatabase.CreateStatement(insChar, "INSERT INTO characters ("
+                              "guid, account, name, race, class, gender, level, xp, money, playerBytes, playerBytes2, playerFlags, map, "
+                              "dungeon_difficulty, position_x, position_y, position_z, orientation, online, cinematic, totaltime, leveltime, "
+                              "rest_bonus, logout_time, is_logout_resting, resettalents_cost, resettalents_time, trans_x, trans_y, trans_z, "
+                              "trans_o, transguid, extra_flags, stable_slots, at_login, zone, death_expire_time, taxi_path, arenaPoints, "
+                              "totalHonorPoints, todayHonorPoints, yesterdayHonorPoints, totalKills, todayKills, yesterdayKills, "
+                              "chosenTitle, knownCurrencies, watchedFaction, drunk, health, power1, power2, power3, power4, power5, power6, "
+                              "power7, specCount, activeSpec, ammoId, actionBars, taximask, exploredZones, equipmentCache, knownTitles) "
+                              "VALUES ("
+                              "?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, "
+                              "?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, "
+                              "?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, "
+                              "?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, "
+                              "?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, "
+                              "?, ?, ?, ?, ?)");
+
+        uberInsert.addUInt32(GetGUIDLow());
+        _AddCharacterFields(uberInsert);
+        uberInsert.addString(taxiMask);
+        uberInsert.addString(exploredZones);
+        uberInsert.addString(equipmentCache);
+        uberInsert.addString(knownTitles);
+        uberInsert.Execute();
+
+        m_characterRowSaved = true;
+    }
+    else
+    {
+        static SqlStatementID updChar ;
+        static SqlStatementID updTaxiMask ;
+        static SqlStatementID updExploredZones ;
+        static SqlStatementID updEquipmentCache ;
+        static SqlStatementID updKnownTitles ;
 
-    uberInsert.Execute();
+        SqlStatement uberUpdate = CharacterDatabase.CreateStatement(updChar, "UPDATE characters SET "
+                              "account = ?, name = ?, race = ?, class = ?, gender = ?, level = ?, xp = ?, money = ?, "
+                              "playerBytes = ?, playerBytes2 = ?, playerFlags = ?, map = ?, dungeon_difficulty = ?, position_x = ?, position_y = ?, position_z = ?, "
+                              "orientation = ?, online = ?, cinematic = ?, totaltime = ?, leveltime = ?, rest_bonus = ?, logout_time = ?, is_logout_resting = ?, "
+                              "resettalents_cost = ?, resettalents_time = ?, trans_x = ?, trans_y = ?, trans_z = ?, trans_o = ?, transguid = ?, extra_flags = ?, "
+                              "stable_slots = ?, at_login = ?, zone = ?, death_expire_time = ?, taxi_path = ?, arenaPoints = ?, totalHonorPoints = ?, todayHonorPoints = ?, "
+                              "yesterdayHonorPoints = ?, totalKills = ?, todayKills = ?, yesterdayKills = ?, chosenTitle = ?, knownCurrencies = ?, watchedFaction = ?, drunk = ?, "
+                              "health = ?, power1 = ?, power2 = ?, power3 = ?, power4 = ?, power5 = ?, power6 = ?, power7 = ?, "
+                              "specCount = ?, activeSpec = ?, ammoId = ?, actionBars = ? "
+                              "WHERE guid = ?");
+
+        _AddCharacterFields(uberUpdate);
+        uberUpdate.addUInt32(GetGUIDLow());
+        uberUpdate.Execute();
+
+        if (taxiMask != m_savedTaxiMask)
+        {
+            SqlStatement stmt = CharacterDatabase.CreateStatement(updTaxiMask, "UPDATE characters SET taximask = ? WHERE guid = ?");
+            stmt.PExecute(taxiMask.c_str(), GetGUIDLow());
+        }
+
+        if (exploredZones != m_savedExploredZones)
+        {
+            SqlStatement stmt = CharacterDatabase.CreateStatement(updExploredZones, "UPDATE characters SET exploredZones = ? WHERE guid = ?");
+            stmt.PExecute(exploredZones.c_str(), GetGUIDLow());
+        }
+
+        if (equipmentCache != m_savedEquipmentCache)
+        {
+            SqlStatement stmt = CharacterDatabase.CreateStatement(updEquipmentCache, "UPDATE characters SET equipmentCache = ? WHERE guid = ?");
+            stmt.PExecute(equipmentCache.c_str(), GetGUIDLow());
+        }
+
+        if (knownTitles != m_savedKnownTitles)
+        {
+            SqlStatement stmt = CharacterDatabase.CreateStatement(updKnownTitles, "UPDATE characters SET knownTitles = ? WHERE guid = ?");
+            stmt.PExecute(knownTitles.c_str(), GetGUIDLow());
+        }
+    }
+
+    m_savedTaxiMask.swap(taxiMask);
+    m_savedExploredZones.swap(exploredZones);
+    m_savedEquipmentCache.swap(equipmentCache);
+    m_savedKnownTitles.swap(knownTitles);
 
     if (m_mailsUpdated)                                     // save mails only when needed
         _SaveMail();
@@ -18187,6 +18183,10 @@ void Player::SaveToDB()
     _SaveGlyphs();
     _SaveTalents();
 
+    size_t statements, bytes;
+    if (CharacterDatabase.GetTransactionVolume(statements, bytes))
+        sWorld.GetPlayerSaveMetric().record({ int64(statements), int64(bytes) });
+
     CharacterDatabase.CommitTransaction();
 
     // check if stats should only be saved on logout
@@ -18199,6 +18199,114 @@ void Player::SaveToDB()
         pet->SavePetToDB(PET_SAVE_AS_CURRENT, this);
 }
 
+// binds the columns of the characters row that are saved every time, in the order of SaveToDB
+void Player::_AddCharacterFields(SqlStatement& stmt)
+{
+    stmt.addUInt32(GetSession()->GetAccountId());
+    stmt.addString(m_name);
+    stmt.addUInt8(getRace());
+    stmt.addUInt8(getClass());
+    stmt.addUInt8(getGender());
+    stmt.addUInt32(getLevel());
+    stmt.addUInt32(GetUInt32Value(PLAYER_XP));
+    stmt.addUInt32(GetMoney());
+    stmt.addUInt32(GetUInt32Value(PLAYER_BYTES));
+    stmt.addUInt32(GetUInt32Value(PLAYER_BYTES_2));
+    stmt.addUInt32(GetUInt32Value(PLAYER_FLAGS));
+
+    if (!IsBeingTeleported())
+    {
+        stmt.addUInt32(GetMapId());
+        stmt.addUInt32(uint32(GetDungeonDifficulty()));
+        stmt.addFloat(finiteAlways(GetPositionX()));
+        stmt.addFloat(finiteAlways(GetPositionY()));
+        stmt.addFloat(finiteAlways(GetPositionZ()));
+        stmt.addFloat(finiteAlways(GetOrientation()));
+    }
+    else
+    {
+        stmt.addUInt32(GetTeleportDest().mapid);
+        stmt.addUInt32(uint32(GetDungeonDifficulty()));
+        stmt.addFloat(finiteAlways(GetTeleportDest().coord_x));
+        stmt.addFloat(finiteAlways(GetTeleportDest().coord_y));
+        stmt.addFloat(finiteAlways(GetTeleportDest().coord_z));
+        stmt.addFloat(finiteAlways(GetTeleportDest().orientation));
+    }
+
+    stmt.addUInt32(IsInWorld() ? 1 : 0);
+
+    stmt.addUInt32(m_cinematic);
+
+    stmt.addUInt32(m_Played_time[PLAYED_TIME_TOTAL]);
+    stmt.addUInt32(m_Played_time[PLAYED_TIME_LEVEL]);
+
+    stmt.addFloat(finiteAlways(m_rest_bonus));
+    stmt.addUInt64(uint64(time(nullptr)));
+    stmt.addUInt32(HasFlag(PLAYER_FLAGS, PLAYER_FLAGS_RESTING) ? 1 : 0);
+    // save, far from tavern/city
+    // save, but in tavern/city
+    stmt.addUInt32(m_resetTalentsCost);
+    stmt.addUInt64(uint64(m_resetTalentsTime));
+
+    Position const& transportPosition = m_movementInfo.GetTransportPos();
+    stmt.addFloat(finiteAlways(transportPosition.x));
+    stmt.addFloat(finiteAlways(transportPosition.y));
+    stmt.addFloat(finiteAlways(transportPosition.z));
+    stmt.addFloat(finiteAlways(transportPosition.o));
+
+    if (m_transport)
+        stmt.addUInt32(m_transport->GetGUIDLow());
+    else
+        stmt.addUInt32(0);
+
+    stmt.addUInt32(m_ExtraFlags);
+
+    stmt.addUInt32(uint32(m_stableSlots));            // to prevent save uint8 as char
+
+    stmt.addUInt32(uint32(m_atLoginFlags));
+
+    stmt.addUInt32(IsInWorld() ? GetZoneId() : GetCachedZoneId());
+
+    stmt.addUInt64(uint64(m_deathExpireTime));
+
+    stmt.addString(m_taxiTracker.Save());
+
+    stmt.addUInt32(GetArenaPoints());
+
+    stmt.addUInt32(GetHonorPoints());
+
+    stmt.addUInt32(GetUInt32Value(PLAYER_FIELD_TODAY_CONTRIBUTION));
+
+    stmt.addUInt32(GetUInt32Value(PLAYER_FIELD_YESTERDAY_CONTRIBUTION));
+
+    stmt.addUInt32(GetUInt32Value(PLAYER_FIELD_LIFETIME_HONORBALE_KILLS));
+
+    stmt.addUInt16(GetUInt16Value(PLAYER_FIELD_KILLS, 0));
+
+    stmt.addUInt16(GetUInt16Value(PLAYER_FIELD_KILLS, 1));
+
+    stmt.addUInt32(GetUInt32Value(PLAYER_CHOSEN_TITLE));
+
+    stmt.addUInt64(GetUInt64Value(PLAYER_FIELD_KNOWN_CURRENCIES));
+
+    // FIXME: at this moment send to DB as unsigned, including unit32(-1)
+    stmt.addUInt32(GetUInt32Value(PLAYER_FIELD_WATCHED_FACTION_INDEX));
+
+    stmt.addUInt8(GetDrunkValue());
+
+    stmt.addUInt32(GetHealth());
+
+    for (uint32 i = 0; i < MAX_POWERS; ++i)
+        stmt.addUInt32(GetPower(Powers(i)));
+
+    stmt.addUInt32(uint32(m_specsCount));
+    stmt.addUInt32(uint32(m_activeSpec));
+
+    stmt.addUInt32(GetUInt32Value(PLAYER_AMMO_ID));
+
+    stmt.addUInt32(uint32(GetByteValue(PLAYER_FIELD_BYTES, 2)));
+}
+
 // fast save function for item/money cheating preventing - save only inventory and money state
 void Player::SaveInventoryAndGoldToDB()
 {
@@ -18275,19 +18383,10 @@ void Player::_SaveAuras()
     static SqlStatementID deleteAuras ;
     static SqlStatementID insertAuras ;
 
-    SqlStatement stmt = CharacterDatabase.CreateStatement(deleteAuras, "DELETE FROM character_aura WHERE guid = ?");
-    stmt.PExecute(GetGUIDLow());
-
-    SpellAuraHolderMap const& auraHolders = GetSpellAuraHolderMap();
-
-    if (auraHolders.empty())
-        return;
+    // all rows are rewritten, but only if any of them differs from the last save
+    std::vector<int64> rows(1, 0);                          // row count, then AURA_SAVE_ROW_SIZE values per row
 
-    stmt = CharacterDatabase.CreateStatement(insertAuras, "INSERT INTO character_aura (guid, caster_guid, item_guid, spell, stackcount, remaincharges, "
-            "basepoints0, basepoints1, basepoints2, periodictime0, periodictime1, periodictime2, maxduration, remaintime, effIndexMask) "
-            "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)");
-
-    for (const auto& auraHolder : auraHolders)
+    for (const auto& auraHolder : GetSpellAuraHolderMap())
     {
         SpellAuraHolder* holder = auraHolder.second;
         // skip all holders from spells that are passive or channeled
@@ -18318,25 +18417,59 @@ void Player::_SaveAuras()
             if (!effIndexMask)
                 continue;
 
-            stmt.addUInt32(GetGUIDLow());
-            stmt.addUInt64(holder->GetCasterGuid().GetRawValue());
-            stmt.addUInt32(holder->GetCastItemGuid().GetCounter());
-            stmt.addUInt32(holder->GetId());
-            stmt.addUInt32(holder->GetStackAmount());
-            stmt.addUInt8(holder->GetAuraCharges());
+            rows.push_back(int64(holder->GetCasterGuid().GetRawValue()));
+            rows.push_back(holder->GetCastItemGuid().GetCounter());
+            rows.push_back(holder->GetId());
+            rows.push_back(holder->GetStackAmount());
+            rows.push_back(holder->GetAuraCharges());
 
             for (int i : damage)
-                stmt.addInt32(i);
+                rows.push_back(i);
 
             for (unsigned int i : periodicTime)
-                stmt.addUInt32(i);
+                rows.push_back(i);
 
-            stmt.addInt32(holder->GetAuraMaxDuration());
-            stmt.addInt32(holder->GetAuraDuration());
-            stmt.addUInt32(effIndexMask);
-            stmt.Execute();
+            rows.push_back(holder->GetAuraMaxDuration());
+            rows.push_back(holder->GetAuraDuration());
+            rows.push_back(effIndexMask);
+            ++rows[0];
         }
     }
+
+    if (rows == m_savedAuraRows)
+        return;
+
+    SqlStatement stmt = CharacterDatabase.CreateStatement(deleteAuras, "DELETE FROM character_aura WHERE guid = ?");
+    stmt.PExecute(GetGUIDLow());
+
+    stmt = CharacterDatabase.CreateStatement(insertAuras, "INSERT INTO character_aura (guid, caster_guid, item_guid, spell, stackcount, remaincharges, "
+            "basepoints0, basepoints1, basepoints2, periodictime0, periodictime1, periodictime2, maxduration, remaintime, effIndexMask) "
+            "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)");
+
+    for (size_t row = 1; row < rows.size(); row += AURA_SAVE_ROW_SIZE)
+    {
+        int64 const* values = &rows[row];
+
+        stmt.addUInt32(GetGUIDLow());
+        stmt.addUInt64(uint64(values[0]));
+        stmt.addUInt32(uint32(values[1]));
+        stmt.addUInt32(uint32(values[2]));
+        stmt.addUInt32(uint32(values[3]));
+        stmt.addUInt8(uint8(values[4]));
+
+        for (uint32 i = 0; i < MAX_EFFECT_INDEX; ++i)
+            stmt.addInt32(int32(values[5 + i]));
+
+        for (uint32 i = 0; i < MAX_EFFECT_INDEX; ++i)
+            stmt.addUInt32(uint32(values[5 + MAX_EFFECT_INDEX + i]));
+
+        stmt.addInt32(int32(values[5 + 2 * MAX_EFFECT_INDEX]));
+        stmt.addInt32(int32(values[6 + 2 * MAX_EFFECT_INDEX]));
+        stmt.addUInt32(uint32(values[7 + 2 * MAX_EFFECT_INDEX]));
+        stmt.Execute();
+    }
+
+    m_savedAuraRows.swap(rows);
 }
 
 void Player::_SaveGlyphs()
@@ -22507,7 +22640,11 @@ void Player::SaveTitles()
     std::string playerTitles;
     for (uint32 i = 0; i < KNOWN_TITLES_SIZE * 2; ++i)
         playerTitles += std::to_string(GetUInt32Value(PLAYER__FIELD_KNOWN_TITLES + i)) + " ";
-    CharacterDatabase.PExecute("UPDATE characters SET KnownTitles='%s' WHERE guid = '%u'", playerTitles.data(), GetGUIDLow());
+    static SqlStatementID updateTitles;
+    SqlStatement stmt = CharacterDatabase.CreateStatement(updateTitles, "UPDATE characters SET knownTitles = ? WHERE guid = ?");
+    stmt.addString(playerTitles);
+    stmt.addUInt32(GetGUIDLow());
+    stmt.Execute();
 }
 
 void Player::SetQueuedSpell(Spell* spell)
@@ -23905,7 +24042,11 @@ void Player::RemoveAtLoginFlag(AtLoginFlags f, bool in_db_also /*= false*/)
     m_atLoginFlags &= ~f;
 
     if (in_db_also)
-        CharacterDatabase.PExecute("UPDATE characters set at_login = at_login & ~ %u WHERE guid ='%u'", uint32(f), GetGUIDLow());
+    {
+        static SqlStatementID updateAtLogin;
+        SqlStatement stmt = CharacterDatabase.CreateStatement(updateAtLogin, "UPDATE characters SET at_login = at_login & ~ ? WHERE guid = ?");
+        stmt.PExecute(uint32(f), GetGUIDLow());
+    }
 }
 
 void Player::SendClearCooldown(uint32 spell_id, Unit* target) const
@@ -24670,7 +24811,10 @@ bool Player::CanEnterNewInstance(uint32 instanceId)
 void Player::AddNewInstanceId(uint32 instanceId)
 {
     if (m_enteredInstances.find(instanceId) == m_enteredInstances.end())
+    {
         m_enteredInstances.emplace(instanceId, std::chrono::time_point_cast<std::chrono::milliseconds>(Clock::now() + std::chrono::hours(1)));
+        m_enteredInstancesChanged = true;
+    }
 }
 
 void Player::_LoadCreatedInstanceTimers()
@@ -24697,7 +24841,15 @@ void Player::_LoadCreatedInstanceTimers()
 
 void Player::_SaveNewInstanceIdTimer()
 {
-    CharacterDatabase.PExecute("DELETE FROM account_instances_entered WHERE AccountId = '%u'", m_session->GetAccountId());
+    // expired timers are skipped at load, they don't need a save of their own
+    if (!m_enteredInstancesChanged)
+        return;
+
+    m_enteredInstancesChanged = false;
+
+    static SqlStatementID deleteInsertTimer;
+    SqlStatement delStmt = CharacterDatabase.CreateStatement(deleteInsertTimer, "DELETE FROM account_instances_entered WHERE AccountId = ?");
+    delStmt.PExecute(m_session->GetAccountId());
 
     if (m_enteredInstances.empty())
         return;
@@ -24770,7 +24922,11 @@ void Player::SetRandomBattlegroundWinner(bool isWinner)
     m_hasWonRandomBattleground = isWinner;
 
     if (m_hasWonRandomBattleground)
-        CharacterDatabase.PExecute("INSERT INTO character_battleground_random (guid) VALUES ('%u')", GetGUIDLow());
+    {
+        static SqlStatementID insertRandomWinner;
+        SqlStatement stmt = CharacterDatabase.CreateStatement(insertRandomWinner, "INSERT INTO character_battleground_random (guid) VALUES (?)");
+        stmt.PExecute(GetGUIDLow());
+    }
 }
 
 void Player::_LoadRandomBattlegroundStatus(QueryResult* result)
@@ -2554,6 +2554,16 @@ class Player : public Unit
         void _SaveGlyphs();
         void _SaveTalents();
         void _SaveStats();
+        void _AddCharacterFields(SqlStatement& stmt);
+
+        // what the last save wrote, so the next one skips what did not change since
+        bool m_characterRowSaved;                           // the row exists and is updated in place
+        std::string m_savedTaxiMask;
+        std::string m_savedExploredZones;
+        std::string m_savedEquipmentCache;
+        std::string m_savedKnownTitles;
+        std::vector<int64> m_savedAuraRows;                 // empty until the first save
+        std::vector<int64> m_savedCooldownRows;
 
         void _SetCreateBits(UpdateMask* updateMask, Player* target) const override;
         void _SetUpdateBits(UpdateMask* updateMask, Player* target) const override;
@@ -2811,6 +2821,7 @@ class Player : public Unit
         std::unique_ptr<Spell> m_queuedSpell;
 
         std::unordered_map<uint32, TimePoint> m_enteredInstances;
+        bool m_enteredInstancesChanged;
         uint32 m_createdInstanceClearTimer;
 };
 
@@ -288,6 +288,8 @@ Unit::Unit() :
     // m_AurasCheck = 2000;
     // m_removeAuraTimer = 4;
     m_spellAuraHoldersUpdateIterator = m_spellAuraHolders.end();
+    m_procAuraIndexFlags = 0;
+    m_procAuraIndexRemovedByDamage = 0;
     m_AuraFlags = 0;
 
     m_Visibility = VISIBILITY_ON;
@@ -5444,6 +5446,7 @@ bool Unit::AddSpellAuraHolder(SpellAuraHolder* holder)
     if (m_spellUpdateHappening)
         holder->SetCreationDelayFlag();
     m_spellAuraHolders.insert(SpellAuraHolderMap::value_type(holder->GetId(), holder));
+    AddProcAuraIndexEntry(holder);
 
     for (int32 i = 0; i < MAX_EFFECT_INDEX; ++i)
         if (Aura* aur = holder->GetAuraByEffectIndex(SpellEffectIndex(i)))
@@ -6069,6 +6072,7 @@ void Unit::RemoveSpellAuraHolder(SpellAuraHolder* holder, AuraRemoveMode mode)
             break;
         }
     }
+    RemoveProcAuraIndexEntry(holder);
 
     holder->SetRemoveMode(mode);
     holder->UnregisterAndCleanupTrackedAuras();
@@ -11794,6 +11798,8 @@ void Unit::UpdateModelData()
         else
             SetFloatValue(UNIT_FIELD_COMBATREACH, GetObjectScale() * modelInfo->combat_reach);
 
+        UpdateCellIndexReach();
+
         SetBaseWalkSpeed(modelInfo->SpeedWalk);
         SetBaseRunSpeed(modelInfo->SpeedRun);
     }
@@ -12578,6 +12584,17 @@ class UnitVisitObjectsInRangeNotifyEvent : public BasicEvent
 
         bool Execute(uint64 /*e_time*/, uint32 /*p_time*/) override
         {
+            // the map pairs all units due in this update at once
+            if (sWorld.getConfig(CONFIG_BOOL_AI_NOTIFY_BATCH))
+            {
+                m_owner.GetMap()->GetAINotifyQueue().Add(m_owner);
+                m_owner.FinalizeAINotifyEvent();
+                return true;
+            }
+
+            AINotifyQueue& queue = m_owner.GetMap()->GetAINotifyQueue();
+            bool const measure = queue.IsUnitMetricEnabled();
+            auto startTime = measure ? std::chrono::high_resolution_clock::now() : std::chrono::high_resolution_clock::time_point();
             float radius = MAX_CREATURE_ATTACK_RADIUS * sWorld.getConfig(CONFIG_FLOAT_RATE_CREATURE_AGGRO);
             if (m_owner.GetTypeId() == TYPEID_PLAYER)
             {
@@ -12592,6 +12609,15 @@ class UnitVisitObjectsInRangeNotifyEvent : public BasicEvent
                 MaNGOS::CreatureVisitObjectsNotifier notify(creature);
                 Cell::VisitAllObjects(&m_owner, notify, radius);
             }
+
+            if (measure)
+            {
+                CellArea area = Cell::CalculateCellArea(m_owner.GetPositionX(), m_owner.GetPositionY(), radius + m_owner.GetObjectBoundingRadius());
+                uint32 cells = (area.high_bound.x_coord - area.low_bound.x_coord + 1) * (area.high_bound.y_coord - area.low_bound.y_coord + 1);
+                auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - startTime);
+                queue.RecordUnitNotify(cells, elapsed.count());
+            }
+
             m_owner.FinalizeAINotifyEvent();
             return true;
         }
@@ -13487,11 +13513,13 @@ void Unit::InterruptSpellsCastedOnMe(bool killDelayed)
         if (!killDelayed)
             continue;
         // 2/ Interrupt spells that are not referenced but that still have an event (like delayed spell)
-        for (auto i_events = target->m_events.GetEvents().begin(); i_events != target->m_events.GetEvents().end(); ++i_events)
-            if (SpellEvent* event = dynamic_cast<SpellEvent*>(i_events->second))
+        target->m_events.VisitEvents([this](BasicEvent* basicEvent)
+        {
+            if (SpellEvent* event = dynamic_cast<SpellEvent*>(basicEvent))
                 if (event && event->GetSpell()->m_targets.getUnitTargetGuid() == GetObjectGuid())
                     if (event->GetSpell()->getState() != SPELL_STATE_FINISHED)
                         event->GetSpell()->cancel();
+        });
     }
 }
 
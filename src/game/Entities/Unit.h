@@ -2474,6 +2474,19 @@ class Unit : public WorldObject
 
         SpellAuraHolderMap m_spellAuraHolders;
         SpellAuraHolderMap::iterator m_spellAuraHoldersUpdateIterator; // != end() in Unit::m_spellAuraHolders update and point to next element
+
+        // Holders that can react in ProcDamageAndSpellFor, in m_spellAuraHolders order
+        struct ProcAuraIndexEntry
+        {
+            SpellAuraHolder* holder;
+            uint32 procFlags;                               // proc flags from spell_proc_event or the spell itself
+            bool removedByDamage;                           // AURA_INTERRUPT_FLAG_DAMAGE
+        };
+        void AddProcAuraIndexEntry(SpellAuraHolder* holder);
+        void RemoveProcAuraIndexEntry(SpellAuraHolder* holder);
+        std::vector<ProcAuraIndexEntry> m_procAuraIndex;
+        uint32 m_procAuraIndexFlags;                        // union of procFlags of all entries
+        uint32 m_procAuraIndexRemovedByDamage;              // entries with removedByDamage set
         AuraList m_deletedAuras;                            // auras removed while in ApplyModifier and waiting deleted
         SpellAuraHolderList m_deletedHolders;
         std::map<uint32, Aura*> m_classScripts;
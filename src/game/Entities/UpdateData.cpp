@@ -60,29 +60,80 @@ void UpdateData::AddUpdateBlock(const ByteBuffer& block)
     }
 }
 
-void UpdateData::Compress(void* dst, uint32* dst_size, void* src, int src_size)
+// deflate state takes about 256KB, so every thread keeps one and only resets it between packets
+class UpdatePacketCompressor
 {
-    z_stream c_stream;
+    public:
+        UpdatePacketCompressor() : m_initialized(false), m_level(0)
+        {
+            m_stream.zalloc = (alloc_func)nullptr;
+            m_stream.zfree = (free_func)nullptr;
+            m_stream.opaque = (voidpf)nullptr;
+        }
+
+        ~UpdatePacketCompressor()
+        {
+            if (m_initialized)
+                deflateEnd(&m_stream);
+        }
+
+        z_stream* GetStream(int level)
+        {
+            // compression level can change at config reload
+            if (m_initialized && m_level != level)
+            {
+                deflateEnd(&m_stream);
+                m_initialized = false;
+            }
+
+            if (m_initialized)
+            {
+                deflateReset(&m_stream);
+                return &m_stream;
+            }
+
+            int z_res = deflateInit(&m_stream, level);
+            if (z_res != Z_OK)
+            {
+                sLog.outError("Can't compress update packet (zlib: deflateInit) Error code: %i (%s)", z_res, zError(z_res));
+                return nullptr;
+            }
+
+            m_initialized = true;
+            m_level = level;
+            return &m_stream;
+        }
+
+    private:
+        z_stream m_stream;
+        bool m_initialized;
+        int m_level;
+};
+
+static thread_local UpdatePacketCompressor s_compressor;
+
+std::atomic<uint64> UpdateData::s_compressedBytesIn(0);
+std::atomic<uint64> UpdateData::s_compressedBytesOut(0);
+std::atomic<uint64> UpdateData::s_compressionTime(0);
 
-    c_stream.zalloc = (alloc_func)nullptr;
-    c_stream.zfree = (free_func)nullptr;
-    c_stream.opaque = (voidpf)nullptr;
+void UpdateData::Compress(void* dst, uint32* dst_size, void* src, int src_size)
+{
+    std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
 
     // default Z_BEST_SPEED (1)
-    int z_res = deflateInit(&c_stream, sWorld.getConfig(CONFIG_UINT32_COMPRESSION));
-    if (z_res != Z_OK)
+    z_stream* c_stream = s_compressor.GetStream(sWorld.getConfig(CONFIG_UINT32_COMPRESSION));
+    if (!c_stream)
     {
-        sLog.outError("Can't compress update packet (zlib: deflateInit) Error code: %i (%s)", z_res, zError(z_res));
         *dst_size = 0;
         return;
     }
 
-    c_stream.next_out = (Bytef*)dst;
-    c_stream.avail_out = *dst_size;
-    c_stream.next_in = (Bytef*)src;
-    c_stream.avail_in = (uInt)src_size;
+    c_stream->next_out = (Bytef*)dst;
+    c_stream->avail_out = *dst_size;
+    c_stream->next_in = (Bytef*)src;
+    c_stream->avail_in = (uInt)src_size;
 
-    z_res = deflate(&c_stream, Z_NO_FLUSH);
+    int z_res = deflate(c_stream, Z_NO_FLUSH);
     if (z_res != Z_OK)
     {
         sLog.outError("Can't compress update packet (zlib: deflate) Error code: %i (%s)", z_res, zError(z_res));
@@ -90,14 +141,14 @@ void UpdateData::Compress(void* dst, uint32* dst_size, void* src, int src_size)
         return;
     }
 
-    if (c_stream.avail_in != 0)
+    if (c_stream->avail_in != 0)
     {
         sLog.outError("Can't compress update packet (zlib: deflate not greedy)");
         *dst_size = 0;
         return;
     }
 
-    z_res = deflate(&c_stream, Z_FINISH);
+    z_res = deflate(c_stream, Z_FINISH);
     if (z_res != Z_STREAM_END)
     {
         sLog.outError("Can't compress update packet (zlib: deflate should report Z_STREAM_END instead %i (%s)", z_res, zError(z_res));
@@ -105,15 +156,20 @@ void UpdateData::Compress(void* dst, uint32* dst_size, void* src, int src_size)
         return;
     }
 
-    z_res = deflateEnd(&c_stream);
-    if (z_res != Z_OK)
-    {
-        sLog.outError("Can't compress update packet (zlib: deflateEnd) Error code: %i (%s)", z_res, zError(z_res));
-        *dst_size = 0;
-        return;
-    }
+    *dst_size = c_stream->total_out;
 
-    *dst_size = c_stream.total_out;
+    s_compressedBytesIn += src_size;
+    s_compressedBytesOut += *dst_size;
+    s_compressionTime += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+}
+
+UpdateData::CompressionStats UpdateData::ConsumeCompressionStats()
+{
+    CompressionStats stats;
+    stats.bytesIn = s_compressedBytesIn.exchange(0);
+    stats.bytesOut = s_compressedBytesOut.exchange(0);
+    stats.time = s_compressionTime.exchange(0);
+    return stats;
 }
 
 WorldPacket UpdateData::BuildPacket(size_t index)
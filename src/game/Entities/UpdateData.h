@@ -22,6 +22,8 @@
 #include "ByteBuffer.h"
 #include "Entities/ObjectGuid.h"
 
+#include <atomic>
+
 class WorldPacket;
 
 enum ObjectUpdateType
@@ -70,11 +72,25 @@ class UpdateData
 
         GuidSet const& GetOutOfRangeGUIDs() const { return m_outOfRangeGUIDs; }
 
+        struct CompressionStats
+        {
+            uint64 bytesIn;
+            uint64 bytesOut;
+            uint64 time;                                    // microseconds
+        };
+
+        // totals over all threads since the previous call
+        static CompressionStats ConsumeCompressionStats();
+
     protected:
         GuidSet m_outOfRangeGUIDs;
         std::vector<BufferPair> m_data;
         uint32 m_currentIndex;
 
         static void Compress(void* dst, uint32* dst_size, void* src, int src_size);
+
+        static std::atomic<uint64> s_compressedBytesIn;
+        static std::atomic<uint64> s_compressedBytesOut;
+        static std::atomic<uint64> s_compressionTime;
 };
 #endif
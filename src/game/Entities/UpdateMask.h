@@ -77,6 +77,11 @@ class UpdateMask
             return *this;
         }
 
+        bool operator == (const UpdateMask& mask) const
+        {
+            return mCount == mask.mCount && memcmp(mUpdateMask, mask.mUpdateMask, mBlocks << 2) == 0;
+        }
+
         void operator &= (const UpdateMask& mask)
         {
             MANGOS_ASSERT(mask.mCount <= mCount);
@@ -5723,91 +5723,115 @@ void ObjectMgr::ReturnOrDeleteOldMails(bool serverUp)
         return;                                             // any mails need to be returned or deleted
     }
 
+    std::vector<Mail> mails;
+    mails.reserve(result->GetRowCount());
+
+    do
+    {
+        Field* fields = result->Fetch();
+        Mail m = Mail();
+        m.messageID = fields[0].GetUInt32();
+        m.messageType = fields[1].GetUInt8();
+        m.sender = fields[2].GetUInt32();
+        m.receiverGuid = ObjectGuid(HIGHGUID_PLAYER, fields[3].GetUInt32());
+        m.has_items = fields[4].GetBool();
+        m.expire_time = (time_t)fields[5].GetUInt64();
+        m.deliver_time = 0;
+        m.COD = fields[6].GetUInt32();
+        m.checked = fields[7].GetUInt32();
+        m.mailTemplateId = fields[8].GetInt16();
+
+        if (m.has_items)
+        {
+            QueryResult* resultItems = CharacterDatabase.PQuery("SELECT item_guid,item_template FROM mail_items WHERE mail_id='%u'", m.messageID);
+            if (resultItems)
+            {
+                do
+                {
+                    Field* fields2 = resultItems->Fetch();
+
+                    uint32 item_guid_low = fields2[0].GetUInt32();
+                    uint32 item_template = fields2[1].GetUInt32();
+
+                    m.AddItem(item_guid_low, item_template);
+                }
+                while (resultItems->NextRow());
+
+                delete resultItems;
+            }
+        }
+
+        mails.push_back(std::move(m));
+    }
+    while (result->NextRow());
+    delete result;
+
+    if (!serverUp)
+    {
+        ReturnOrDeleteMails(mails, basetime, false);
+        return;
+    }
+
+    // the lookup runs next to the map updates, the receivers' online state is only stable on the world thread
+    sWorld.GetMessager().AddMessage([mails, basetime](World*)
+    {
+        sObjectMgr.ReturnOrDeleteMails(mails, basetime, true);
+    });
+}
+
+void ObjectMgr::ReturnOrDeleteMails(std::vector<Mail> const& mails, time_t basetime, bool serverUp)
+{
     // std::ostringstream delitems, delmails; // will be here for optimization
     // bool deletemail = false, deleteitem = false;
     // delitems << "DELETE FROM item_instance WHERE guid IN ( ";
     // delmails << "DELETE FROM mail WHERE id IN ( "
 
-    BarGoLink bar(result->GetRowCount());
+    BarGoLink bar(mails.size());
     uint32 count = 0;
 
-    do
+    for (Mail const& m : mails)
     {
         bar.step();
 
-        Field* fields = result->Fetch();
-        Mail* m = new Mail;
-        m->messageID = fields[0].GetUInt32();
-        m->messageType = fields[1].GetUInt8();
-        m->sender = fields[2].GetUInt32();
-        m->receiverGuid = ObjectGuid(HIGHGUID_PLAYER, fields[3].GetUInt32());
-        bool has_items = fields[4].GetBool();
-        m->expire_time = (time_t)fields[5].GetUInt64();
-        m->deliver_time = 0;
-        m->COD = fields[6].GetUInt32();
-        m->checked = fields[7].GetUInt32();
-        m->mailTemplateId = fields[8].GetInt16();
-
         Player* pl = nullptr;
         if (serverUp)
-            pl = GetPlayer(m->receiverGuid);
+            pl = GetPlayer(m.receiverGuid);
         if (pl)
         {
             // this code will run very improbably (the time is between 4 and 5 am, in game is online a player, who has old mail
             // his in mailbox and he has already listed his mails )
-            delete m;
             continue;
         }
         // delete or return mail:
-        if (has_items)
+        if (m.has_items)
         {
-            QueryResult* resultItems = CharacterDatabase.PQuery("SELECT item_guid,item_template FROM mail_items WHERE mail_id='%u'", m->messageID);
-            if (resultItems)
-            {
-                do
-                {
-                    Field* fields2 = resultItems->Fetch();
-
-                    uint32 item_guid_low = fields2[0].GetUInt32();
-                    uint32 item_template = fields2[1].GetUInt32();
-
-                    m->AddItem(item_guid_low, item_template);
-                }
-                while (resultItems->NextRow());
-
-                delete resultItems;
-            }
             // if it is mail from non-player, or if it's already return mail, it shouldn't be returned, but deleted
-            if (m->messageType != MAIL_NORMAL || (m->checked & (MAIL_CHECK_MASK_COD_PAYMENT | MAIL_CHECK_MASK_RETURNED)))
+            if (m.messageType != MAIL_NORMAL || (m.checked & (MAIL_CHECK_MASK_COD_PAYMENT | MAIL_CHECK_MASK_RETURNED)))
             {
                 // mail open and then not returned
-                for (auto& item : m->items)
+                for (auto& item : m.items)
                     CharacterDatabase.PExecute("DELETE FROM item_instance WHERE guid = '%u'", item.item_guid);
             }
             else
             {
                 // mail will be returned:
                 CharacterDatabase.PExecute("UPDATE mail SET sender = '%u', receiver = '%u', expire_time = '" UI64FMTD "', deliver_time = '" UI64FMTD "',cod = '0', checked = '%u' WHERE id = '%u'",
-                                           m->receiverGuid.GetCounter(), m->sender, (uint64)basetime + 30 * DAY, (uint64)basetime, MAIL_CHECK_MASK_RETURNED, m->messageID);
-                for (MailItemInfoVec::iterator itr2 = m->items.begin(); itr2 != m->items.end(); ++itr2)
+                                           m.receiverGuid.GetCounter(), m.sender, (uint64)basetime + 30 * DAY, (uint64)basetime, MAIL_CHECK_MASK_RETURNED, m.messageID);
+                for (MailItemInfoVec::const_iterator itr2 = m.items.begin(); itr2 != m.items.end(); ++itr2)
                 {
                     // update receiver in mail items for its proper delivery, and in instance_item for avoid lost item at sender delete
-                    CharacterDatabase.PExecute("UPDATE mail_items SET receiver = %u WHERE item_guid = '%u'", m->sender, itr2->item_guid);
-                    CharacterDatabase.PExecute("UPDATE item_instance SET owner_guid = %u WHERE guid = '%u'", m->sender, itr2->item_guid);
+                    CharacterDatabase.PExecute("UPDATE mail_items SET receiver = %u WHERE item_guid = '%u'", m.sender, itr2->item_guid);
+                    CharacterDatabase.PExecute("UPDATE item_instance SET owner_guid = %u WHERE guid = '%u'", m.sender, itr2->item_guid);
                 }
-                delete m;
                 continue;
             }
         }
 
         // deletemail = true;
-        // delmails << m->messageID << ", ";
-        CharacterDatabase.PExecute("DELETE FROM mail WHERE id = '%u'", m->messageID);
-        delete m;
+        // delmails << m.messageID << ", ";
+        CharacterDatabase.PExecute("DELETE FROM mail WHERE id = '%u'", m.messageID);
         ++count;
     }
-    while (result->NextRow());
-    delete result;
 
     sLog.outString(">> Loaded %u mails", count);
     sLog.outString();
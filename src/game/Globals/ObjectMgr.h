@@ -42,6 +42,7 @@ class Group;
 class ArenaTeam;
 class Item;
 class SQLStorage;
+struct Mail;
 
 struct GameTele
 {
@@ -812,6 +813,7 @@ class ObjectMgr
         }
 
         void ReturnOrDeleteOldMails(bool serverUp);
+        void ReturnOrDeleteMails(std::vector<Mail> const& mails, time_t basetime, bool serverUp);
 
         void SetHighestGuids();
 
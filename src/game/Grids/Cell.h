@@ -117,6 +117,9 @@ struct Cell
         template<class T> static void VisitWorldObjects(float x, float y, Map* map, T& visitor, float radius, bool dont_load = true);
         template<class T> static void VisitAllObjects(float x, float y, Map* map, T& visitor, float radius, bool dont_load = true);
 
+        // calls visit(WorldObject*) for the objects passing the query, using the cell indexes instead of the grid containers
+        template<class F> static void VisitIndexedObjects(Map* map, CellIndexQuery const& query, F const& visit, bool dont_load = true);
+
     private:
         template<class T, class CONTAINER> void VisitCircle(TypeContainerVisitor<T, CONTAINER>&, Map&, const CellPair&, const CellPair&) const;
 };
@@ -244,4 +244,39 @@ inline void Cell::VisitAllObjects(float x, float y, Map* map, T& visitor, float
     cell.Visit(p, wnotifier, *map, x, y, radius);
 }
 
+template<class F>
+inline void Cell::VisitIndexedObjects(Map* map, CellIndexQuery const& query, F const& visit, bool dont_load)
+{
+    CellPair standing_cell(MaNGOS::ComputeCellPair(query.x, query.y));
+    if (standing_cell.x_coord >= TOTAL_NUMBER_OF_CELLS_PER_MAP || standing_cell.y_coord >= TOTAL_NUMBER_OF_CELLS_PER_MAP)
+        return;
+
+    // same limit as Visit(), the query itself still filters with the full radius
+    float const radius = std::min(query.radius, 333.0f);
+    CellArea area = Cell::CalculateCellArea(query.x, query.y, radius);
+
+    std::vector<WorldObject*> objects;
+    for (uint32 i = area.low_bound.x_coord; i <= area.high_bound.x_coord; ++i)
+    {
+        float const lowX = (float(i) - CENTER_GRID_CELL_ID) * SIZE_OF_GRID_CELL;
+        float const dx = std::max(std::max(lowX - query.x, query.x - (lowX + SIZE_OF_GRID_CELL)), 0.0f);
+        for (uint32 j = area.low_bound.y_coord; j <= area.high_bound.y_coord; ++j)
+        {
+            // corner cells of large areas do not reach into the circle, like in VisitCircle()
+            float const lowY = (float(j) - CENTER_GRID_CELL_ID) * SIZE_OF_GRID_CELL;
+            float const dy = std::max(std::max(lowY - query.y, query.y - (lowY + SIZE_OF_GRID_CELL)), 0.0f);
+            if (dx * dx + dy * dy > radius * radius)
+                continue;
+
+            Cell cell((CellPair(i, j)));
+            if (dont_load)
+                cell.SetNoCreate();
+            map->CollectIndexedObjects(cell, query, objects);
+        }
+    }
+
+    for (WorldObject* obj : objects)
+        visit(obj);
+}
+
 #endif
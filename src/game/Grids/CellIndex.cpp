@@ -0,0 +1,107 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "Grids/CellIndex.h"
+#include "Entities/Object.h"
+#include "World/World.h"
+
+CellIndex::~CellIndex()
+{
+    for (WorldObject* obj : m_objects)
+        obj->m_cellIndex = nullptr;
+}
+
+void CellIndex::Insert(WorldObject* obj)
+{
+    if (!sWorld.getConfig(CONFIG_BOOL_GRID_CELL_INDEX))
+        return;
+
+    if (obj->m_cellIndex)
+        obj->m_cellIndex->Remove(obj);
+
+    obj->m_cellIndex = this;
+    obj->m_cellIndexSlot = uint32(m_objects.size());
+
+    m_objects.push_back(obj);
+    m_x.push_back(obj->GetPositionX());
+    m_y.push_back(obj->GetPositionY());
+    m_z.push_back(obj->GetPositionZ());
+    m_reach.push_back(std::max(obj->GetObjectBoundingRadius(), obj->GetCombatReach()));
+    m_typeMask.push_back(obj->m_objectType);
+}
+
+void CellIndex::Remove(WorldObject* obj)
+{
+    if (obj->m_cellIndex != this)
+        return;
+
+    // swap the last entry into the freed slot
+    uint32 const slot = obj->m_cellIndexSlot;
+    uint32 const last = uint32(m_objects.size()) - 1;
+    if (slot != last)
+    {
+        m_objects[slot] = m_objects[last];
+        m_x[slot] = m_x[last];
+        m_y[slot] = m_y[last];
+        m_z[slot] = m_z[last];
+        m_reach[slot] = m_reach[last];
+        m_typeMask[slot] = m_typeMask[last];
+        m_objects[slot]->m_cellIndexSlot = slot;
+    }
+
+    m_objects.pop_back();
+    m_x.pop_back();
+    m_y.pop_back();
+    m_z.pop_back();
+    m_reach.pop_back();
+    m_typeMask.pop_back();
+
+    obj->m_cellIndex = nullptr;
+}
+
+void CellIndex::Collect(CellIndexQuery const& query, std::vector<WorldObject*>& result) const
+{
+    uint32 const count = uint32(m_objects.size());
+    if (!count)
+        return;
+
+    // first pass only reads the packed arrays and has no branches, so the compiler can vectorize it
+    static thread_local std::vector<uint8> inRange;
+    inRange.resize(count);
+
+    float const* x = m_x.data();
+    float const* y = m_y.data();
+    float const* z = m_z.data();
+    float const* reach = m_reach.data();
+    uint32 const* typeMask = m_typeMask.data();
+    uint8* hit = inRange.data();
+
+    float const dz3D = query.is3D ? 1.0f : 0.0f;
+    for (uint32 i = 0; i < count; ++i)
+    {
+        float const dx = x[i] - query.x;
+        float const dy = y[i] - query.y;
+        float const dz = (z[i] - query.z) * dz3D;
+        float const maxDist = query.radius + reach[i];
+        hit[i] = uint8(dx * dx + dy * dy + dz * dz <= maxDist * maxDist) & uint8((typeMask[i] & query.typeMask) != 0);
+    }
+
+    for (uint32 i = 0; i < count; ++i)
+        if (hit[i])
+            result.push_back(m_objects[i]);
+}
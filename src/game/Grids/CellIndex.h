@@ -0,0 +1,88 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_CELLINDEX_H
+#define MANGOS_CELLINDEX_H
+
+#include "Common.h"
+
+#include <vector>
+
+class Camera;
+class WorldObject;
+
+// Range filter applied to the positions stored in a CellIndex
+struct CellIndexQuery
+{
+    CellIndexQuery(float x, float y, float z, float radius, uint32 typeMask, bool is3D)
+        : x(x), y(y), z(z), radius(radius), typeMask(typeMask), is3D(is3D) {}
+
+    float x, y, z;
+    float radius;                                           // matched against the distance minus the object reach
+    uint32 typeMask;                                        // TYPEMASK_* of the wanted objects
+    bool is3D;
+};
+
+/**
+ * Structure of arrays copy of the positions of the objects listed in one grid cell.
+ *
+ * Range searches filter the packed coordinates first and only dereference the
+ * objects that can be in range, instead of walking the cell's linked lists and
+ * reading every object. Entries are added and removed together with the grid
+ * containers and moved by WorldObject::Relocate.
+ */
+class CellIndex
+{
+    public:
+        CellIndex() {}
+        ~CellIndex();
+
+        CellIndex(CellIndex const&) = delete;
+        CellIndex& operator=(CellIndex const&) = delete;
+
+        void Insert(WorldObject* obj);
+        void Remove(WorldObject* obj);
+
+        // cameras follow their viewpoint owner and are never searched
+        void Insert(Camera* /*camera*/) {}
+        void Remove(Camera* /*camera*/) {}
+
+        void Relocate(uint32 slot, float x, float y, float z)
+        {
+            m_x[slot] = x;
+            m_y[slot] = y;
+            m_z[slot] = z;
+        }
+
+        void SetReach(uint32 slot, float reach) { m_reach[slot] = reach; }
+
+        // appends the objects passing the query, in no particular order
+        void Collect(CellIndexQuery const& query, std::vector<WorldObject*>& result) const;
+
+        uint32 Size() const { return uint32(m_objects.size()); }
+
+    private:
+        std::vector<WorldObject*> m_objects;
+        std::vector<float> m_x;
+        std::vector<float> m_y;
+        std::vector<float> m_z;
+        std::vector<float> m_reach;                         // larger of bounding radius and combat reach
+        std::vector<uint32> m_typeMask;
+};
+
+#endif
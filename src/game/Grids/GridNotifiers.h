@@ -142,6 +142,8 @@ namespace MaNGOS
     {
         Player& i_player;
         PlayerVisitObjectsNotifier(Player& pl) : i_player(pl) {}
+        void VisitCreature(Creature* creature);
+        void VisitPlayer(Player* player);
         template<class T> void Visit(GridRefManager<T>&) {}
 #ifdef _MSC_VER
         template<> void Visit(PlayerMapType&);
@@ -153,6 +155,8 @@ namespace MaNGOS
     {
         Creature& i_creature;
         CreatureVisitObjectsNotifier(Creature& c) : i_creature(c) {}
+        void VisitCreature(Creature* creature);
+        void VisitPlayer(Player* player);
         template<class T> void Visit(GridRefManager<T>&) {}
 #ifdef _MSC_VER
         template<> void Visit(PlayerMapType&);
@@ -100,47 +100,71 @@ inline void CreatureVisitCreatureWorker(Creature* c1, Creature* c2)
     }
 }
 
-template<>
-inline void MaNGOS::PlayerVisitObjectsNotifier::Visit(CreatureMapType& m)
+inline void MaNGOS::PlayerVisitObjectsNotifier::VisitCreature(Creature* creature)
+{
+    if (!i_player.IsAlive() || i_player.IsTaxiFlying() || !creature->IsAlive())
+        return;
+
+    UnitVisitObjectsNotifierWorker(creature, &i_player);
+
+    if (i_player.AI())
+        UnitVisitObjectsNotifierWorker(&i_player, creature);
+}
+
+inline void MaNGOS::PlayerVisitObjectsNotifier::VisitPlayer(Player* player)
 {
     if (!i_player.IsAlive() || i_player.IsTaxiFlying())
         return;
 
-    bool playerHasAI = i_player.AI() != nullptr;
+    if (player->IsAlive() && !player->IsTaxiFlying())
+        return;
 
-    for (auto& iter : m)
-    {
-        Creature* creature = iter.getSource();
-        if (!creature->IsAlive())
-            continue;
+    if (player->AI())
+        UnitVisitObjectsNotifierWorker(player, &i_player);
 
-        UnitVisitObjectsNotifierWorker(creature, &i_player);
+    if (i_player.AI())
+        UnitVisitObjectsNotifierWorker(&i_player, player);
+}
 
-        if (playerHasAI)
-            UnitVisitObjectsNotifierWorker(&i_player, creature);
-    }
+inline void MaNGOS::CreatureVisitObjectsNotifier::VisitPlayer(Player* player)
+{
+    if (!i_creature.IsAlive() || !player->IsAlive() || player->IsTaxiFlying())
+        return;
+
+    if (player->AI())
+        UnitVisitObjectsNotifierWorker(player, &i_creature);
+
+    UnitVisitObjectsNotifierWorker(&i_creature, player);
+}
+
+inline void MaNGOS::CreatureVisitObjectsNotifier::VisitCreature(Creature* creature)
+{
+    if (!i_creature.IsAlive() || creature == &i_creature || !creature->IsAlive())
+        return;
+
+    UnitVisitObjectsNotifierWorker(creature, &i_creature);
+
+    UnitVisitObjectsNotifierWorker(&i_creature, creature);
 }
 
 template<>
-inline void MaNGOS::PlayerVisitObjectsNotifier::Visit(PlayerMapType& m)
+inline void MaNGOS::PlayerVisitObjectsNotifier::Visit(CreatureMapType& m)
 {
     if (!i_player.IsAlive() || i_player.IsTaxiFlying())
         return;
 
-    bool playerHasAI = i_player.AI() != nullptr;
-
     for (auto& iter : m)
-    {
-        Player* player = iter.getSource();
-        if (player->IsAlive() && !player->IsTaxiFlying())
-            continue;
+        VisitCreature(iter.getSource());
+}
 
-        if (player->AI())
-            UnitVisitObjectsNotifierWorker(player, &i_player);
+template<>
+inline void MaNGOS::PlayerVisitObjectsNotifier::Visit(PlayerMapType& m)
+{
+    if (!i_player.IsAlive() || i_player.IsTaxiFlying())
+        return;
 
-        if (playerHasAI)
-            UnitVisitObjectsNotifierWorker(&i_player, player);
-    }
+    for (auto& iter : m)
+        VisitPlayer(iter.getSource());
 }
 
 template<>
@@ -150,16 +174,7 @@ inline void MaNGOS::CreatureVisitObjectsNotifier::Visit(PlayerMapType& m)
         return;
 
     for (auto& iter : m)
-    {
-        Player* player = iter.getSource();
-        if (!player->IsAlive() || player->IsTaxiFlying())
-            continue;
-
-        if (player->AI())
-            UnitVisitObjectsNotifierWorker(player, &i_creature);
-
-        UnitVisitObjectsNotifierWorker(&i_creature, player);
-    }
+        VisitPlayer(iter.getSource());
 }
 
 template<>
@@ -169,15 +184,7 @@ inline void MaNGOS::CreatureVisitObjectsNotifier::Visit(CreatureMapType& m)
         return;
 
     for (auto& iter : m)
-    {
-        Creature* creature = iter.getSource();
-        if (creature == &i_creature || !creature->IsAlive())
-            continue;
-
-        UnitVisitObjectsNotifierWorker(creature, &i_creature);
-
-        UnitVisitObjectsNotifierWorker(&i_creature, creature);
-    }
+        VisitCreature(iter.getSource());
 }
 
 inline void MaNGOS::DynamicObjectUpdater::VisitHelper(Unit* target)
@@ -45,6 +45,8 @@ class ObjectGridLoader
 
         void LoadN(void);
 
+        uint32 GetLoadedObjectCount() const { return i_gameObjects + i_creatures + i_corpses; }
+
     private:
         Cell i_cell;
         NGridType& i_grid;
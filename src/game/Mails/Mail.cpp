@@ -200,6 +200,9 @@ void MailDraft::CloneFrom(MailDraft const& draft)
  */
 void MailDraft::SendReturnToSender(uint32 sender_acc, ObjectGuid sender_guid, ObjectGuid receiver_guid)
 {
+    // mail and items change owner, not an account shard
+    Database::ShardGuard dbShard(0);
+
     Player* receiver = sObjectMgr.GetPlayer(receiver_guid);
 
     uint32 rc_account = 0;
@@ -248,6 +251,9 @@ void MailDraft::SendReturnToSender(uint32 sender_acc, ObjectGuid sender_guid, Ob
  */
 void MailDraft::SendMailTo(MailReceiver const& receiver, MailSender const& sender, MailCheckMask checked, uint32 deliver_delay)
 {
+    // rows of the receiver, which is rarely the calling account
+    Database::ShardGuard dbShard(0);
+
     Player* pReceiver = receiver.GetPlayer();               // can be nullptr
 
     uint32 pReceiverAccount = 0;
@@ -283,23 +289,34 @@ void MailDraft::SendMailTo(MailReceiver const& receiver, MailSender const& sende
 
     time_t expire_time = deliver_time + expire_delay;
 
-    // Add to DB
-    std::string safe_subject = GetSubject();
-    CharacterDatabase.escape_string(safe_subject);
-
-    std::string safe_body = GetBody();
-    CharacterDatabase.escape_string(safe_body);
+    // Add to DB, subject and body are bound as parameters so they need no escaping
+    static SqlStatementID insertMail;
+    static SqlStatementID insertMailItem;
 
     CharacterDatabase.BeginTransaction();
-    CharacterDatabase.PExecute("INSERT INTO mail (id,messageType,stationery,mailTemplateId,sender,receiver,subject,body,has_items,expire_time,deliver_time,money,cod,checked) "
-                               "VALUES ('%u', '%u', '%u', '%u', '%u', '%u', '%s', '%s', '%u', '" UI64FMTD "','" UI64FMTD "', '%u', '%u', '%u')",
-                               mailId, sender.GetMailMessageType(), sender.GetStationery(), GetMailTemplateId(), sender.GetSenderId(), receiver.GetPlayerGuid().GetCounter(), safe_subject.c_str(), safe_body.c_str(), (has_items ? 1 : 0), (uint64)expire_time, (uint64)deliver_time, m_money, m_COD, checked);
+    SqlStatement stmt = CharacterDatabase.CreateStatement(insertMail, "INSERT INTO mail (id,messageType,stationery,mailTemplateId,sender,receiver,subject,body,has_items,expire_time,deliver_time,money,cod,checked) "
+                        "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)");
+    stmt.addUInt32(mailId);
+    stmt.addUInt32(sender.GetMailMessageType());
+    stmt.addUInt32(sender.GetStationery());
+    stmt.addUInt32(GetMailTemplateId());
+    stmt.addUInt32(sender.GetSenderId());
+    stmt.addUInt32(receiver.GetPlayerGuid().GetCounter());
+    stmt.addString(GetSubject());
+    stmt.addString(GetBody());
+    stmt.addUInt32(has_items ? 1 : 0);
+    stmt.addUInt64(uint64(expire_time));
+    stmt.addUInt64(uint64(deliver_time));
+    stmt.addUInt32(m_money);
+    stmt.addUInt32(m_COD);
+    stmt.addUInt32(checked);
+    stmt.Execute();
 
     for (MailItemMap::const_iterator mailItemIter = m_items.begin(); mailItemIter != m_items.end(); ++mailItemIter)
     {
         Item* item = mailItemIter->second;
-        CharacterDatabase.PExecute("INSERT INTO mail_items (mail_id,item_guid,item_template,receiver) VALUES ('%u', '%u', '%u','%u')",
-                                   mailId, item->GetGUIDLow(), item->GetEntry(), receiver.GetPlayerGuid().GetCounter());
+        stmt = CharacterDatabase.CreateStatement(insertMailItem, "INSERT INTO mail_items (mail_id,item_guid,item_template,receiver) VALUES (?, ?, ?, ?)");
+        stmt.PExecute(mailId, item->GetGUIDLow(), item->GetEntry(), receiver.GetPlayerGuid().GetCounter());
     }
     CharacterDatabase.CommitTransaction();
 
@@ -356,8 +373,12 @@ void Mail::prepareTemplateItems(Player* receiver)
 
     has_items = true;
 
+    static SqlStatementID updateMailHasItems;
+    static SqlStatementID insertMailItem;
+
     CharacterDatabase.BeginTransaction();
-    CharacterDatabase.PExecute("UPDATE mail SET has_items = 1 WHERE id = %u", messageID);
+    SqlStatement stmt = CharacterDatabase.CreateStatement(updateMailHasItems, "UPDATE mail SET has_items = 1 WHERE id = ?");
+    stmt.PExecute(messageID);
 
     // mailLoot can be empty
     Loot mailLoot(receiver, mailTemplateId, LOOT_MAIL);
@@ -374,8 +395,8 @@ void Mail::prepareTemplateItems(Player* receiver)
                 item->SaveToDB();
                 AddItem(item->GetGUIDLow(), item->GetEntry());
                 receiver->AddMItem(item);
-                CharacterDatabase.PExecute("INSERT INTO mail_items (mail_id,item_guid,item_template,receiver) VALUES ('%u', '%u', '%u','%u')",
-                                           messageID, item->GetGUIDLow(), item->GetEntry(), receiver->GetGUIDLow());
+                stmt = CharacterDatabase.CreateStatement(insertMailItem, "INSERT INTO mail_items (mail_id,item_guid,item_template,receiver) VALUES (?, ?, ?, ?)");
+                stmt.PExecute(messageID, item->GetGUIDLow(), item->GetEntry(), receiver->GetGUIDLow());
             }
         }
     }
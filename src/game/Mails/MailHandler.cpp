@@ -108,6 +108,9 @@ bool WorldSession::CheckMailBox(ObjectGuid guid) const
  */
 void WorldSession::HandleSendMail(WorldPacket& recv_data)
 {
+    // items change owner to the receiver
+    Database::ShardGuard dbShard(0);
+
     ObjectGuid mailboxGuid;
     uint64 unk3;
     std::string receiver, subject, body;
@@ -305,7 +308,9 @@ void WorldSession::HandleSendMail(WorldPacket& recv_data)
                 item->DeleteFromInventoryDB();              // deletes item from character's inventory
                 item->SaveToDB();                           // recursive and not have transaction guard into self, item not in inventory and can be save standalone
                 // owner in data will set at mail receive and item extracting
-                CharacterDatabase.PExecute("UPDATE item_instance SET owner_guid = '%u' WHERE guid='%u'", rc.GetCounter(), item->GetGUIDLow());
+                static SqlStatementID updateItemOwner;
+                SqlStatement stmt = CharacterDatabase.CreateStatement(updateItemOwner, "UPDATE item_instance SET owner_guid = ? WHERE guid = ?");
+                stmt.PExecute(rc.GetCounter(), item->GetGUIDLow());
                 CharacterDatabase.CommitTransaction();
 
                 draft.AddItem(item);
@@ -415,6 +420,9 @@ void WorldSession::HandleMailDelete(WorldPacket& recv_data)
  */
 void WorldSession::HandleMailReturnToSender(WorldPacket& recv_data)
 {
+    // the mail changes owner back to the sender
+    Database::ShardGuard dbShard(0);
+
     ObjectGuid mailboxGuid;
     uint32 mailId;
     recv_data >> mailboxGuid;
@@ -0,0 +1,180 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "Maps/AINotifyQueue.h"
+#include "Entities/Creature.h"
+#include "Entities/Player.h"
+#include "Grids/CellImpl.h"
+#include "Grids/GridNotifiers.h"
+#include "Grids/GridNotifiersImpl.h"
+#include "Maps/Map.h"
+#include "Metric/Metric.h"
+#include "World/World.h"
+
+#include <algorithm>
+#include <chrono>
+#include <unordered_map>
+
+namespace
+{
+    // gathers the units listed in the visited cells
+    struct AINotifyUnitCollector
+    {
+        std::vector<Unit*>& i_units;
+
+        explicit AINotifyUnitCollector(std::vector<Unit*>& units) : i_units(units) {}
+
+        void Visit(PlayerMapType& m)
+        {
+            for (auto& iter : m)
+                i_units.push_back(iter.getSource());
+        }
+
+        void Visit(CreatureMapType& m)
+        {
+            for (auto& iter : m)
+                i_units.push_back(iter.getSource());
+        }
+
+        template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED>&) {}
+    };
+
+    template<class NOTIFIER>
+    void NotifyUnits(NOTIFIER&& notify, std::vector<Unit*> const& units)
+    {
+        for (Unit* unit : units)
+        {
+            if (unit->GetTypeId() == TYPEID_PLAYER)
+                notify.VisitPlayer(static_cast<Player*>(unit));
+            else
+                notify.VisitCreature(static_cast<Creature*>(unit));
+        }
+    }
+}
+
+AINotifyQueue::AINotifyQueue(Map& map) : m_map(map), m_unitNotifies(0), m_unitNotifyCells(0), m_unitNotifyTime(0)
+{
+    std::map<std::string, std::string> batchTags = { { "map_id", std::to_string(map.GetId()) }, { "instance_id", std::to_string(map.GetInstanceId()) }, { "path", "batch" } };
+    std::map<std::string, std::string> unitTags = { { "map_id", std::to_string(map.GetId()) }, { "instance_id", std::to_string(map.GetInstanceId()) }, { "path", "unit" } };
+    m_batchMetric.reset(new metric::handle("map.ai_notify", { "duration", "units", "cells", "pairs" }, batchTags));
+    m_unitMetric.reset(new metric::handle("map.ai_notify", { "duration", "units", "cells" }, unitTags));
+}
+
+AINotifyQueue::~AINotifyQueue() {}
+
+void AINotifyQueue::Add(Unit& unit)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    m_pending.push_back(unit.GetObjectGuid());
+}
+
+bool AINotifyQueue::IsUnitMetricEnabled() const
+{
+    return m_unitMetric->enabled();
+}
+
+void AINotifyQueue::RecordUnitNotify(uint32 cells, int64 microseconds)
+{
+    ++m_unitNotifies;
+    m_unitNotifyCells += cells;
+    m_unitNotifyTime += microseconds;
+}
+
+void AINotifyQueue::ReportUnitNotifies()
+{
+    uint32 const units = m_unitNotifies.exchange(0);
+    uint32 const cells = m_unitNotifyCells.exchange(0);
+    int64 const time = m_unitNotifyTime.exchange(0);
+    if (units && m_unitMetric->enabled())
+        m_unitMetric->record({ time, int64(units), int64(cells) });
+}
+
+void AINotifyQueue::Process()
+{
+    ReportUnitNotifies();
+
+    std::vector<ObjectGuid> pending;
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        pending.swap(m_pending);
+    }
+
+    if (pending.empty())
+        return;
+
+    metric::scoped_duration<std::chrono::microseconds> meas(*m_batchMetric);
+
+    // a unit can come due more than once when it was rescheduled with force
+    std::sort(pending.begin(), pending.end());
+    pending.erase(std::unique(pending.begin(), pending.end()), pending.end());
+
+    float const radius = MAX_CREATURE_ATTACK_RADIUS * sWorld.getConfig(CONFIG_FLOAT_RATE_CREATURE_AGGRO);
+
+    std::vector<Unit*> notified;
+    notified.reserve(pending.size());
+    for (ObjectGuid const& guid : pending)
+    {
+        Unit* unit = m_map.GetUnit(guid);
+        if (!unit || !unit->IsInWorld() || unit->GetMap() != &m_map || !unit->IsPositionValid())
+            continue;
+
+        // since visitor was called we override can aggro with true if creature is alive
+        if (unit->GetTypeId() == TYPEID_UNIT)
+            static_cast<Creature*>(unit)->SetCanAggro(unit->IsAlive());
+
+        notified.push_back(unit);
+    }
+
+    // walk every cell around the notified units once, the old per unit searches overlapped a lot
+    std::unordered_map<uint32, std::vector<Unit*>> cellUnits;
+    uint32 pairs = 0;
+    for (Unit* unit : notified)
+    {
+        // same cells as Cell::VisitAllObjects would visit for this unit, every unit in them is notified
+        CellArea area = Cell::CalculateCellArea(unit->GetPositionX(), unit->GetPositionY(), radius + unit->GetObjectBoundingRadius());
+        for (uint32 x = area.low_bound.x_coord; x <= area.high_bound.x_coord; ++x)
+        {
+            for (uint32 y = area.low_bound.y_coord; y <= area.high_bound.y_coord; ++y)
+            {
+                auto result = cellUnits.emplace(y * TOTAL_NUMBER_OF_CELLS_PER_MAP + x, std::vector<Unit*>());
+                std::vector<Unit*>& units = result.first->second;
+                if (result.second)
+                {
+                    AINotifyUnitCollector collector(units);
+                    TypeContainerVisitor<AINotifyUnitCollector, GridTypeMapContainer> gridVisitor(collector);
+                    TypeContainerVisitor<AINotifyUnitCollector, WorldTypeMapContainer> worldVisitor(collector);
+
+                    Cell cell((CellPair(x, y)));
+                    cell.SetNoCreate();
+                    m_map.Visit(cell, gridVisitor);
+                    m_map.Visit(cell, worldVisitor);
+                }
+
+                pairs += units.size();
+                if (unit->GetTypeId() == TYPEID_PLAYER)
+                    NotifyUnits(MaNGOS::PlayerVisitObjectsNotifier(static_cast<Player&>(*unit)), units);
+                else
+                    NotifyUnits(MaNGOS::CreatureVisitObjectsNotifier(static_cast<Creature&>(*unit)), units);
+            }
+        }
+    }
+
+    meas.set(1, notified.size());
+    meas.set(2, cellUnits.size());
+    meas.set(3, pairs);
+}
@@ -0,0 +1,67 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_AI_NOTIFY_QUEUE_H
+#define MANGOS_AI_NOTIFY_QUEUE_H
+
+#include "Common.h"
+#include "Entities/ObjectGuid.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+class Map;
+class Unit;
+namespace metric { class handle; }
+
+// Units of one map whose relocation notify came due during the object update.
+// Instead of every unit walking the cells around itself, the cells around all of them
+// are walked once and every notified unit is paired with the units of the cells around it.
+class AINotifyQueue
+{
+    public:
+        explicit AINotifyQueue(Map& map);
+        ~AINotifyQueue();
+
+        void Add(Unit& unit);
+
+        // statistics of the notifies still done by the unit itself, reported with the batch ones
+        bool IsUnitMetricEnabled() const;
+        void RecordUnitNotify(uint32 cells, int64 microseconds);
+
+        void Process();
+
+    private:
+        void ReportUnitNotifies();
+
+        Map& m_map;
+
+        std::mutex m_lock;                                  // units are added from parallel update regions
+        std::vector<ObjectGuid> m_pending;
+
+        std::atomic<uint32> m_unitNotifies;
+        std::atomic<uint32> m_unitNotifyCells;
+        std::atomic<int64> m_unitNotifyTime;
+
+        std::unique_ptr<metric::handle> m_batchMetric;
+        std::unique_ptr<metric::handle> m_unitMetric;
+};
+
+#endif
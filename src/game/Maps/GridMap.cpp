@@ -29,7 +29,12 @@
 #include "Policies/Singleton.h"
 #include "Util.h"
 
+#include <algorithm>
 #include <mutex>
+#include <cstring>
+
+#define GRID_MAX_PREFETCHED 16
+#define GRID_NOT_PREFETCHING 0xFFFFFFFF                    // packed position of m_prefetchReading while idle
 
 char const* MAP_MAGIC         = "MAPS";
 char const* MAP_VERSION_MAGIC = "v1.4";
@@ -77,25 +82,97 @@ GridMap::~GridMap()
     unloadData();
 }
 
+// Reads the sections of a map file either from a stream or from its memory mapping.
+// Mapped arrays are used in place, everything else is copied into buffers owned by the GridMap.
+class GridMapReader
+{
+    public:
+        GridMapReader(FILE* file, MappedFile const& mapped, std::vector<std::unique_ptr<uint8[]>>& ownedData) :
+            m_file(file), m_mapped(mapped), m_pos(0), m_ownedData(ownedData) {}
+        ~GridMapReader() { if (m_file) fclose(m_file); }
+
+        bool Seek(uint32 offset)
+        {
+            if (m_file)
+                return fseek(m_file, offset, SEEK_SET) == 0;
+
+            if (offset > m_mapped.GetSize())
+                return false;
+            m_pos = offset;
+            return true;
+        }
+
+        bool Read(void* dest, size_t size)
+        {
+            if (m_file)
+                return fread(dest, size, 1, m_file) == 1;
+
+            if (m_pos + size > m_mapped.GetSize())
+                return false;
+            memcpy(dest, m_mapped.GetData() + m_pos, size);
+            m_pos += size;
+            return true;
+        }
+
+        template<typename T>
+        bool ReadArray(T const*& array, size_t count)
+        {
+            size_t size = count * sizeof(T);
+            if (!m_file)
+            {
+                if (m_pos + size > m_mapped.GetSize())
+                    return false;
+
+                // sections are not aligned by the extractor, misaligned arrays are copied below
+                uint8 const* data = m_mapped.GetData() + m_pos;
+                if (reinterpret_cast<uintptr_t>(data) % alignof(T) == 0)
+                {
+                    array = reinterpret_cast<T const*>(data);
+                    m_pos += size;
+                    return true;
+                }
+            }
+
+            std::unique_ptr<uint8[]> buffer(new uint8[size]);
+            if (!Read(buffer.get(), size))
+                return false;
+
+            array = reinterpret_cast<T const*>(buffer.get());
+            m_ownedData.push_back(std::move(buffer));
+            return true;
+        }
+
+    private:
+        FILE* m_file;
+        MappedFile const& m_mapped;
+        size_t m_pos;
+        std::vector<std::unique_ptr<uint8[]>>& m_ownedData;
+};
+
 bool GridMap::loadData(char const* filename)
 {
     // Unload old data if exist
     unloadData();
 
-    GridMapFileHeader header;
-    // Not return error if file not found
-    FILE* in = fopen(filename, "rb");
-    if (!in)
+    FILE* file = nullptr;
+    if (!sWorld.getConfig(CONFIG_BOOL_MAP_FILES_MEMORY_MAPPED) || !m_mappedFile.Open(filename))
     {
-        DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "Failled to found %s", filename);
-        // its a valid error only in case of no vmap files are available too
-        return true;
+        // Not return error if file not found
+        file = fopen(filename, "rb");
+        if (!file)
+        {
+            DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "Failled to found %s", filename);
+            // its a valid error only in case of no vmap files are available too
+            return true;
+        }
     }
 
-    if (fread(&header, sizeof(header), 1, in) != 1)
+    GridMapReader in(file, m_mappedFile, m_ownedData);
+
+    GridMapFileHeader header;
+    if (!in.Read(&header, sizeof(header)))
     {
         sLog.outError("Error loading GridMapFileHeader\n");
-        fclose(in);
         return false;
     }
 
@@ -107,7 +184,6 @@ bool GridMap::loadData(char const* filename)
         if (header.areaMapOffset && !loadAreaData(in, header.areaMapOffset, header.areaMapSize))
         {
             sLog.outError("Error loading map area data\n");
-            fclose(in);
             return false;
         }
 
@@ -115,7 +191,6 @@ bool GridMap::loadData(char const* filename)
         if (header.heightMapOffset && !loadHeightData(in, header.heightMapOffset, header.heightMapSize))
         {
             sLog.outError("Error loading map height data\n");
-            fclose(in);
             return false;
         }
 
@@ -123,7 +198,6 @@ bool GridMap::loadData(char const* filename)
         if (header.liquidMapOffset && !loadGridMapLiquidData(in, header.liquidMapOffset, header.liquidMapSize))
         {
             sLog.outError("Error loading map liquids data\n");
-            fclose(in);
             return false;
         }
 
@@ -131,38 +205,38 @@ bool GridMap::loadData(char const* filename)
         if (header.holesOffset && !loadHolesData(in, header.holesOffset, header.holesSize))
         {
             sLog.outError("Error loading map holes data\n");
-            fclose(in);
             return false;
         }
 
-        fclose(in);
         return true;
     }
 
     sLog.outError("Map file '%s' is non-compatible version (outdated?). Please, create new using ad.exe program.", filename);
-    fclose(in);
     return false;
 }
 
 void GridMap::unloadData()
 {
-    if (m_area_map)    { delete[] m_area_map;    m_area_map = nullptr; }
-    if (m_V9)          { delete[] m_V9;          m_V9 = nullptr; }
-    if (m_V8)          { delete[] m_V8;          m_V8 = nullptr; }
-    if (m_liquidEntry) { delete[] m_liquidEntry; m_liquidEntry = nullptr; }
-    if (m_liquidFlags) { delete[] m_liquidFlags; m_liquidFlags = nullptr; }
-    if (m_liquid_map)  { delete[] m_liquid_map;  m_liquid_map = nullptr; }
-    if (m_holes)       { delete[] m_holes;       m_holes = nullptr; }
+    m_area_map = nullptr;
+    m_V9 = nullptr;
+    m_V8 = nullptr;
+    m_liquidEntry = nullptr;
+    m_liquidFlags = nullptr;
+    m_liquid_map = nullptr;
+    m_holes = nullptr;
+
+    m_ownedData.clear();
+    m_mappedFile.Close();
 
     m_gridGetHeight = &GridMap::getHeightFromFlat;
 }
 
-bool GridMap::loadAreaData(FILE* in, uint32 offset, uint32 /*size*/)
+bool GridMap::loadAreaData(GridMapReader& in, uint32 offset, uint32 /*size*/)
 {
     GridMapAreaHeader header;
-    if (fseek(in, offset, SEEK_SET) != 0)
+    if (!in.Seek(offset))
         return false;
-    if (fread(&header, sizeof(header), 1, in) != 1)
+    if (!in.Read(&header, sizeof(header)))
         return false;
     if (header.fourcc != *((uint32 const*)(MAP_AREA_MAGIC)))
         return false;
@@ -170,20 +244,19 @@ bool GridMap::loadAreaData(FILE* in, uint32 offset, uint32 /*size*/)
     m_gridArea = header.gridArea;
     if (!(header.flags & MAP_AREA_NO_AREA))
     {
-        m_area_map = new uint16 [16 * 16];
-        if (fread(m_area_map, sizeof(uint16), 16 * 16, in) != 16 * 16)
+        if (!in.ReadArray(m_area_map, 16 * 16))
             return false;
     }
 
     return true;
 }
 
-bool GridMap::loadHeightData(FILE* in, uint32 offset, uint32 /*size*/)
+bool GridMap::loadHeightData(GridMapReader& in, uint32 offset, uint32 /*size*/)
 {
     GridMapHeightHeader header;
-    if (fseek(in, offset, SEEK_SET) != 0)
+    if (!in.Seek(offset))
         return false;
-    if (fread(&header, sizeof(header), 1, in) != 1)
+    if (!in.Read(&header, sizeof(header)))
         return false;
     if (header.fourcc != *((uint32 const*)(MAP_HEIGHT_MAGIC)))
         return false;
@@ -193,30 +266,24 @@ bool GridMap::loadHeightData(FILE* in, uint32 offset, uint32 /*size*/)
     {
         if ((header.flags & MAP_HEIGHT_AS_INT16))
         {
-            m_uint16_V9 = new uint16[129 * 129];
-            m_uint16_V8 = new uint16[128 * 128];
-            if (fread(m_uint16_V9, sizeof(uint16), 129 * 129, in) != 129 * 129 ||
-                    fread(m_uint16_V8, sizeof(uint16), 128 * 128, in) != 128 * 128)
+            if (!in.ReadArray(m_uint16_V9, 129 * 129) ||
+                    !in.ReadArray(m_uint16_V8, 128 * 128))
                 return false;
             m_gridIntHeightMultiplier = (header.gridMaxHeight - header.gridHeight) / 65535;
             m_gridGetHeight = &GridMap::getHeightFromUint16;
         }
         else if ((header.flags & MAP_HEIGHT_AS_INT8))
         {
-            m_uint8_V9 = new uint8[129 * 129];
-            m_uint8_V8 = new uint8[128 * 128];
-            if (fread(m_uint8_V9, sizeof(uint8), 129 * 129, in) != 129 * 129 ||
-                    fread(m_uint8_V8, sizeof(uint8), 128 * 128, in) != 128 * 128)
+            if (!in.ReadArray(m_uint8_V9, 129 * 129) ||
+                    !in.ReadArray(m_uint8_V8, 128 * 128))
                 return false;
             m_gridIntHeightMultiplier = (header.gridMaxHeight - header.gridHeight) / 255;
             m_gridGetHeight = &GridMap::getHeightFromUint8;
         }
         else
         {
-            m_V9 = new float[129 * 129];
-            m_V8 = new float[128 * 128];
-            if (fread(m_V9, sizeof(float), 129 * 129, in) != 129 * 129 ||
-                    fread(m_V8, sizeof(float), 128 * 128, in) != 128 * 128)
+            if (!in.ReadArray(m_V9, 129 * 129) ||
+                    !in.ReadArray(m_V8, 128 * 128))
                 return false;
             m_gridGetHeight = &GridMap::getHeightFromFloat;
         }
@@ -227,20 +294,19 @@ bool GridMap::loadHeightData(FILE* in, uint32 offset, uint32 /*size*/)
     return true;
 }
 
-bool GridMap::loadHolesData(FILE* in, uint32 offset, uint32 /*size*/)
+bool GridMap::loadHolesData(GridMapReader& in, uint32 offset, uint32 /*size*/)
 {
-    if (fseek(in, offset, SEEK_SET) != 0)
+    if (!in.Seek(offset))
         return false;
-    m_holes = new uint16[16 * 16];
-    return fread(m_holes, sizeof(uint16), 16 * 16, in) == 16 * 16;
+    return in.ReadArray(m_holes, 16 * 16);
 }
 
-bool GridMap::loadGridMapLiquidData(FILE* in, uint32 offset, uint32 /*size*/)
+bool GridMap::loadGridMapLiquidData(GridMapReader& in, uint32 offset, uint32 /*size*/)
 {
     GridMapLiquidHeader header;
-    if (fseek(in, offset, SEEK_SET) != 0)
+    if (!in.Seek(offset))
         return false;
-    if (fread(&header, sizeof(header), 1, in) != 1)
+    if (!in.Read(&header, sizeof(header)))
         return false;
     if (header.fourcc != *((uint32 const*)(MAP_LIQUID_MAGIC)))
         return false;
@@ -255,19 +321,16 @@ bool GridMap::loadGridMapLiquidData(FILE* in, uint32 offset, uint32 /*size*/)
 
     if (!(header.flags & MAP_LIQUID_NO_TYPE))
     {
-        m_liquidEntry = new uint16[16 * 16];
-        if (fread(m_liquidEntry, sizeof(uint16), 16 * 16, in) != 16 * 16)
+        if (!in.ReadArray(m_liquidEntry, 16 * 16))
             return false;
 
-        m_liquidFlags = new uint8[16 * 16];
-        if (fread(m_liquidFlags, sizeof(uint8), 16 * 16, in) != 16 * 16)
+        if (!in.ReadArray(m_liquidFlags, 16 * 16))
             return false;
     }
 
     if (!(header.flags & MAP_LIQUID_NO_HEIGHT))
     {
-        m_liquid_map = new float[m_liquid_width * m_liquid_height];
-        if (fread(m_liquid_map, sizeof(float), m_liquid_width * m_liquid_height, in) != size_t(m_liquid_width * m_liquid_height))
+        if (!in.ReadArray(m_liquid_map, m_liquid_width * m_liquid_height))
             return false;
     }
 
@@ -407,7 +470,7 @@ float GridMap::getHeightFromUint8(float x, float y) const
     y_int &= (MAP_RESOLUTION - 1);
 
     int32 a, b, c;
-    uint8* V9_h1_ptr = &m_uint8_V9[x_int * 128 + x_int + y_int];
+    uint8 const* V9_h1_ptr = &m_uint8_V9[x_int * 128 + x_int + y_int];
     if (x + y < 1)
     {
         if (x > y)
@@ -475,7 +538,7 @@ float GridMap::getHeightFromUint16(float x, float y) const
     y_int &= (MAP_RESOLUTION - 1);
 
     int32 a, b, c;
-    uint16* V9_h1_ptr = &m_uint16_V9[x_int * 128 + x_int + y_int];
+    uint16 const* V9_h1_ptr = &m_uint16_V9[x_int * 128 + x_int + y_int];
     if (x + y < 1)
     {
         if (x > y)
@@ -1243,6 +1306,27 @@ GridMap* TerrainInfo::GetGrid(const float x, const float y, bool loadOnlyMap /*=
     return pMap;
 }
 
+// reads the .map file of a grid into a new GridMap, not linked to any terrain yet
+static GridMap* ReadGridMap(uint32 mapId, uint32 x, uint32 y)
+{
+    GridMap* map = new GridMap();
+
+    // map file name
+    int len = sWorld.GetDataPath().length() + strlen("maps/%03u%02u%02u.map") + 1;
+    char* tmp = new char[len];
+    snprintf(tmp, len, (char*)(sWorld.GetDataPath() + "maps/%03u%02u%02u.map").c_str(), mapId, x, y);
+    DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "Loading map %s", tmp);
+
+    if (!map->loadData(tmp))
+    {
+        sLog.outError("Error load map file: %s", tmp);
+        //assert(false);
+    }
+
+    delete[] tmp;
+    return map;
+}
+
 GridMap* TerrainInfo::LoadMapAndVMap(const uint32 x, const uint32 y, bool mapOnly /*= false*/)
 {
     if ((m_GridMaps[x][y] && mapOnly)
@@ -1257,21 +1341,10 @@ GridMap* TerrainInfo::LoadMapAndVMap(const uint32 x, const uint32 y, bool mapOnl
         // double checked lock pattern
         if (!m_GridMaps[x][y])
         {
-            GridMap* map = new GridMap();
-
-            // map file name
-            int len = sWorld.GetDataPath().length() + strlen("maps/%03u%02u%02u.map") + 1;
-            char* tmp = new char[len];
-            snprintf(tmp, len, (char*)(sWorld.GetDataPath() + "maps/%03u%02u%02u.map").c_str(), m_mapId, x, y);
-            DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "Loading map %s", tmp);
+            GridMap* map = sTerrainMgr.TakePrefetchedGrid(m_mapId, x, y);
+            if (!map)
+                map = ReadGridMap(m_mapId, x, y);
 
-            if (!map->loadData(tmp))
-            {
-                sLog.outError("Error load map file: %s", tmp);
-                //assert(false);
-            }
-
-            delete[] tmp;
             m_GridMaps[x][y] = map;
         }
     }
@@ -1340,12 +1413,25 @@ float TerrainInfo::GetWaterLevel(float x, float y, float z, float* pGround /*= n
 INSTANTIATE_SINGLETON_2(TerrainManager, CLASS_LOCK);
 INSTANTIATE_CLASS_MUTEX(TerrainManager, std::mutex);
 
-TerrainManager::TerrainManager()
+TerrainManager::TerrainManager() : m_prefetchReading(0, GRID_NOT_PREFETCHING), m_prefetchSequence(0), m_prefetchStop(false)
 {
 }
 
 TerrainManager::~TerrainManager()
 {
+    if (m_prefetchThread.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> guard(m_prefetchLock);
+            m_prefetchStop = true;
+        }
+        m_prefetchCondition.notify_all();
+        m_prefetchThread.join();
+    }
+
+    for (auto& itr : m_prefetchedGrids)
+        delete itr.second.map;
+
     for (auto& it : i_TerrainMap)
         delete it.second;
 }
@@ -1399,6 +1485,89 @@ void TerrainManager::UnloadAll()
     i_TerrainMap.clear();
 }
 
+void TerrainManager::PrefetchGrid(uint32 mapId, uint32 x, uint32 y)
+{
+    PrefetchKey key(mapId, (x << 16) | y);
+
+    {
+        std::lock_guard<std::mutex> guard(m_prefetchLock);
+        if (m_prefetchedGrids.find(key) != m_prefetchedGrids.end() || m_prefetchReading == key ||
+                std::find(m_prefetchQueue.begin(), m_prefetchQueue.end(), key) != m_prefetchQueue.end())
+            return;
+
+        m_prefetchQueue.push_back(key);
+
+        if (!m_prefetchThread.joinable())
+            m_prefetchThread = std::thread(&TerrainManager::PrefetchWorker, this);
+    }
+
+    m_prefetchCondition.notify_all();
+}
+
+GridMap* TerrainManager::TakePrefetchedGrid(uint32 mapId, uint32 x, uint32 y)
+{
+    PrefetchKey key(mapId, (x << 16) | y);
+
+    std::unique_lock<std::mutex> lock(m_prefetchLock);
+
+    // not started yet, the caller is quicker reading it itself
+    auto queued = std::find(m_prefetchQueue.begin(), m_prefetchQueue.end(), key);
+    if (queued != m_prefetchQueue.end())
+    {
+        m_prefetchQueue.erase(queued);
+        return nullptr;
+    }
+
+    // half read, reading it again would only take longer
+    m_prefetchCondition.wait(lock, [this, &key] { return m_prefetchReading != key; });
+
+    auto itr = m_prefetchedGrids.find(key);
+    if (itr == m_prefetchedGrids.end())
+        return nullptr;
+
+    GridMap* map = itr->second.map;
+    m_prefetchedGrids.erase(itr);
+    return map;
+}
+
+void TerrainManager::PrefetchWorker()
+{
+    std::unique_lock<std::mutex> lock(m_prefetchLock);
+
+    while (true)
+    {
+        m_prefetchCondition.wait(lock, [this] { return m_prefetchStop || !m_prefetchQueue.empty(); });
+        if (m_prefetchStop)
+            return;
+
+        PrefetchKey key = m_prefetchQueue.front();
+        m_prefetchQueue.pop_front();
+        m_prefetchReading = key;
+
+        lock.unlock();
+        GridMap* map = ReadGridMap(key.first, key.second >> 16, key.second & 0x0000FFFF);
+        lock.lock();
+
+        // grids prefetched for players that turned away must not pile up
+        if (m_prefetchedGrids.size() >= GRID_MAX_PREFETCHED)
+        {
+            auto oldest = m_prefetchedGrids.begin();
+            for (auto itr = m_prefetchedGrids.begin(); itr != m_prefetchedGrids.end(); ++itr)
+                if (itr->second.sequence < oldest->second.sequence)
+                    oldest = itr;
+            delete oldest->second.map;
+            m_prefetchedGrids.erase(oldest);
+        }
+
+        PrefetchedGrid& prefetched = m_prefetchedGrids[key];
+        prefetched.sequence = ++m_prefetchSequence;
+        prefetched.map = map;
+
+        m_prefetchReading = PrefetchKey(0, GRID_NOT_PREFETCHING);
+        m_prefetchCondition.notify_all();
+    }
+}
+
 uint32 TerrainManager::GetAreaIdByAreaFlag(uint16 areaflag, uint32 map_id)
 {
     AreaTableEntry const* entry = GetAreaEntryByAreaFlagAndMap(areaflag, map_id);
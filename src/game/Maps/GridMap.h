@@ -25,9 +25,16 @@
 #include "Entities/ObjectDefines.h"
 
 #include "Maps/GridMapDefines.h"
+#include "MappedFile.h"
 
 #include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
 #include <mutex>
+#include <thread>
+#include <vector>
 
 class Creature;
 class Unit;
@@ -36,6 +43,7 @@ class InstanceData;
 class Group;
 class BattleGround;
 class Map;
+class GridMapReader;
 
 class GridMap
 {
@@ -44,22 +52,22 @@ class GridMap
 
         // Area data
         uint16 m_gridArea;
-        uint16* m_area_map;
+        uint16 const* m_area_map;
 
         // Height level data
         float m_gridHeight;
         float m_gridIntHeightMultiplier;
         union
         {
-            float* m_V9;
-            uint16* m_uint16_V9;
-            uint8* m_uint8_V9;
+            float const* m_V9;
+            uint16 const* m_uint16_V9;
+            uint8 const* m_uint8_V9;
         };
         union
         {
-            float* m_V8;
-            uint16* m_uint16_V8;
-            uint8* m_uint8_V8;
+            float const* m_V8;
+            uint16 const* m_uint16_V8;
+            uint8 const* m_uint8_V8;
         };
 
         // Liquid data
@@ -70,19 +78,23 @@ class GridMap
         uint8 m_liquid_width;
         uint8 m_liquid_height;
         float m_liquidLevel;
-        uint16* m_liquidEntry;
-        uint8* m_liquidFlags;
-        float* m_liquid_map;
+        uint16 const* m_liquidEntry;
+        uint8 const* m_liquidFlags;
+        float const* m_liquid_map;
 
-        uint16* m_holes;
+        uint16 const* m_holes;
+
+        // Arrays above point either into m_mappedFile or into buffers owned here
+        MappedFile m_mappedFile;
+        std::vector<std::unique_ptr<uint8[]>> m_ownedData;
 
         // For fast check
         bool m_fullyLoaded;
 
-        bool loadAreaData(FILE* in, uint32 offset, uint32 size);
-        bool loadHeightData(FILE* in, uint32 offset, uint32 size);
-        bool loadGridMapLiquidData(FILE* in, uint32 offset, uint32 size);
-        bool loadHolesData(FILE* in, uint32 offset, uint32 size);
+        bool loadAreaData(GridMapReader& in, uint32 offset, uint32 size);
+        bool loadHeightData(GridMapReader& in, uint32 offset, uint32 size);
+        bool loadGridMapLiquidData(GridMapReader& in, uint32 offset, uint32 size);
+        bool loadHolesData(GridMapReader& in, uint32 offset, uint32 size);
         bool isHole(int row, int col) const;
 
         // Get height functions and pointers
@@ -161,6 +173,9 @@ class TerrainInfo : public Referencable<std::atomic_long>
         bool GetAreaInfo(float x, float y, float z, uint32& flags, int32& adtId, int32& rootId, int32& groupId) const;
         bool IsOutdoors(float x, float y, float z) const;
 
+        // terrain grids are shared by all instances of the map id
+        bool IsGridMapLoaded(uint32 x, uint32 y) const { return m_GridMaps[x][y] != nullptr; }
+
         // this method should be used only by TerrainManager
         // to cleanup unreferenced GridMap objects - they are too heavy
         // to destroy them dynamically, especially on highly populated servers
@@ -233,15 +248,39 @@ class TerrainManager : public MaNGOS::Singleton<TerrainManager, MaNGOS::ClassLev
         static uint32 GetZoneIdByAreaFlag(uint16 areaflag, uint32 map_id);
         static void GetZoneAndAreaIdByAreaFlag(uint32& zoneid, uint32& areaid, uint16 areaflag, uint32 map_id);
 
+        // reads the .map file of the grid in the background, so a later grid load finds it in memory
+        void PrefetchGrid(uint32 mapId, uint32 x, uint32 y);
+        // prefetched grid not linked to a terrain yet, nullptr if the caller has to read it
+        GridMap* TakePrefetchedGrid(uint32 mapId, uint32 x, uint32 y);
+
     private:
         TerrainManager();
         ~TerrainManager();
 
+        void PrefetchWorker();
+
         TerrainManager(const TerrainManager&);
         TerrainManager& operator=(const TerrainManager&);
 
         typedef MaNGOS::ClassLevelLockable<TerrainManager, std::mutex>::Lock Guard;
         TerrainDataMap i_TerrainMap;
+
+        typedef std::pair<uint32, uint32> PrefetchKey;      // map id, packed grid position
+
+        struct PrefetchedGrid
+        {
+            uint32 sequence;                                // oldest ones are dropped first
+            GridMap* map;
+        };
+
+        std::thread m_prefetchThread;
+        std::mutex m_prefetchLock;
+        std::condition_variable m_prefetchCondition;
+        std::deque<PrefetchKey> m_prefetchQueue;
+        PrefetchKey m_prefetchReading;                      // grid the worker reads right now
+        std::map<PrefetchKey, PrefetchedGrid> m_prefetchedGrids;
+        uint32 m_prefetchSequence;
+        bool m_prefetchStop;
 };
 
 #define sTerrainMgr TerrainManager::Instance()
@@ -18,6 +18,7 @@
 
 #include "Maps/Map.h"
 #include "Maps/MapManager.h"
+#include "Maps/MapWorkers.h"
 #include "Entities/Player.h"
 #include "Grids/GridNotifiers.h"
 #include "Log.h"
@@ -41,6 +42,7 @@
 #include "Calendar/Calendar.h"
 #include "Chat/Chat.h"
 #include "Weather/Weather.h"
+#include "OutdoorPvP/OutdoorPvPMgr.h"
 #include "Grids/ObjectGridLoader.h"
 
 Map::~Map()
@@ -72,6 +74,10 @@ Map::~Map()
         transport->ResetMap();
         delete transport;
     }
+
+    // objects still alive keep the pool until they are deleted
+    if (m_objectPool)
+        m_objectPool->Release();
 }
 
 uint32 Map::GetCurrentMSTime() const
@@ -153,14 +159,37 @@ Map::Map(uint32 id, time_t expiry, uint32 InstanceId, uint8 SpawnMode)
       i_id(id), i_InstanceId(InstanceId), m_unloadTimer(0),
       m_VisibleDistance(DEFAULT_VISIBILITY_DISTANCE), m_persistentState(nullptr),
       m_activeNonPlayersIter(m_activeNonPlayers.end()), m_onEventNotifiedIter(m_onEventNotifiedObjects.end()),
-      i_gridExpiry(expiry), m_TerrainData(sTerrainMgr.LoadTerrain(id)),
-      i_data(nullptr), i_script_id(0), m_transportsIterator(m_transports.begin()), i_defaultLight(GetDefaultMapLight(id))
+      i_gridExpiry(expiry), m_TerrainData(sTerrainMgr.LoadTerrain(id)), m_pathRequests(*this), m_aiNotifyQueue(*this),
+      m_objectPool(nullptr), m_objectPoolMetricTimer(0),
+      i_data(nullptr), i_script_id(0), m_transportsIterator(m_transports.begin()), i_defaultLight(GetDefaultMapLight(id)),
+      m_updateCost(0), m_lineOfSightGeneration(0)
 {
     m_weatherSystem = new WeatherSystem(this);
+
+    std::map<std::string, std::string> metricTags = { { "map_id", std::to_string(i_id) }, { "instance_id", std::to_string(i_InstanceId) } };
+    // count was sent as text before these were handles, keep its type for existing series
+    m_updateMetric.reset(new metric::handle("map.update", { "duration", "count", "regions" }, metricTags, 0x2));
+    m_sessionUpdateMetric.reset(new metric::handle("map.update.session", { "duration", "count" }, metricTags, 0x2));
+    m_gridLoadMetric.reset(new metric::handle("map.grid_load", { "duration", "terrain", "objects" }, metricTags));
+
+    if (sWorld.getConfig(CONFIG_BOOL_MAP_OBJECT_POOL))
+    {
+        m_objectPool = new MapObjectPool();
+        // one series per kind, all kinds in one handle would exceed the fields a handle can carry
+        char const* poolNames[MAX_MAP_POOL_KINDS] = { "creature", "gameobject", "dynamicobject", "aura", "aura_holder" };
+        for (uint32 kind = 0; kind < MAX_MAP_POOL_KINDS; ++kind)
+        {
+            std::map<std::string, std::string> poolTags = metricTags;
+            poolTags["pool"] = poolNames[kind];
+            m_objectPoolMetrics[kind].reset(new metric::handle("map.object_pool", { "live", "capacity" }, poolTags));
+        }
+    }
 }
 
 void Map::Initialize(bool loadInstanceData /*= true*/)
 {
+    MapObjectPool::Scope poolScope(m_objectPool);
+
     m_CreatureGuids.Set(sObjectMgr.GetFirstTemporaryCreatureLowGuid());
     m_GameObjectGuids.Set(sObjectMgr.GetFirstTemporaryGameObjectLowGuid());
 
@@ -347,9 +376,15 @@ void Map::EnsureGridLoadedAtEnter(const Cell& cell, Player* player)
 
 bool Map::EnsureGridLoaded(const Cell& cell)
 {
+    // time the caller is blocked by loading is reported to map.grid_load
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    bool created = !getNGrid(cell.GridX(), cell.GridY());
+
     EnsureGridCreated(GridPair(cell.GridX(), cell.GridY()));
     NGridType* grid = getNGrid(cell.GridX(), cell.GridY());
 
+    int64 terrainTime = created ? std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count() : 0;
+
     MANGOS_ASSERT(grid != nullptr);
     if (!isGridObjectDataLoaded(cell.GridX(), cell.GridY()))
     {
@@ -359,14 +394,21 @@ bool Map::EnsureGridLoaded(const Cell& cell)
         // active object A(loaded with loader.LoadN call and added to the  map)
         // summons some active object B, while B added to map grid loading called again and so on..
         setGridObjectDataLoaded(true, cell.GridX(), cell.GridY());
+        MapObjectPool::Scope poolScope(m_objectPool);
         ObjectGridLoader loader(*grid, this, cell);
         loader.LoadN();
 
         // Add resurrectable corpses to world object list in grid
         sObjectAccessor.AddCorpsesToGrid(GridPair(cell.GridX(), cell.GridY()), (*grid)(cell.CellX(), cell.CellY()), this);
+
+        int64 loadTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+        m_gridLoadMetric->record({ loadTime, terrainTime, int64(loader.GetLoadedObjectCount()) });
         return true;
     }
 
+    if (created)
+        m_gridLoadMetric->record({ terrainTime, terrainTime, 0 });
+
     return false;
 }
 
@@ -446,6 +488,8 @@ Map::Add(T* obj)
         return;
     }
 
+    std::lock_guard<std::recursive_mutex> guard(m_regionLock);
+
     obj->SetMap(this);
 
     Cell cell(p);
@@ -656,13 +700,13 @@ void Map::VisitNearbyCellsOf(WorldObject* obj, TypeContainerVisitor<MaNGOS::Obje
 
 void Map::Update(const uint32& t_diff)
 {
-    metric::duration<std::chrono::milliseconds> meas("map.update", {
-        { "map_id", std::to_string(i_id) },
-        { "instance_id", std::to_string(i_InstanceId) }
-        });
+    metric::scoped_duration<std::chrono::milliseconds> meas(*m_updateMetric);
+    MapObjectPool::Scope poolScope(m_objectPool);
 
     uint64 count = 0;
 
+    m_lineOfSightGeneration = sWorld.getConfig(CONFIG_BOOL_VMAP_LOS_MEMO) ? NextLineOfSightGeneration() : 0;
+
     m_dyn_tree.update(t_diff);
 
     GetMessager().Execute(this);
@@ -687,10 +731,7 @@ void Map::Update(const uint32& t_diff)
     {
         uint32 updatedSessions = 0;
 
-        metric::duration<std::chrono::milliseconds> sessions_meas("map.update.session", {
-            { "map_id", std::to_string(i_id) },
-            { "instance_id", std::to_string(i_InstanceId) },
-            });
+        metric::scoped_duration<std::chrono::milliseconds> sessions_meas(*m_sessionUpdateMetric);
 
         for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
         {
@@ -705,7 +746,7 @@ void Map::Update(const uint32& t_diff)
             ++updatedSessions;
         }
 
-        sessions_meas.add_field("count", std::to_string(static_cast<int32>(updatedSessions)));
+        sessions_meas.set(1, updatedSessions);
     }
 
     /// update players at tick
@@ -771,13 +812,32 @@ void Map::Update(const uint32& t_diff)
     }
 
     // update all objects
-    for (auto wObj : objToUpdate)
+    if (CanUpdateInParallel(objToUpdate.size()))
+        BuildUpdateRegions(objToUpdate);
+
+    if (m_updateRegions.size() > 1)
+    {
+        count = UpdateRegionsInParallel(t_diff);
+        meas.set(2, m_updateRegions.size());
+        m_updateRegions.clear();
+    }
+    else
     {
-        wObj->Update(t_diff);
-        ++count;
+        m_updateRegions.clear();
+        for (auto wObj : objToUpdate)
+        {
+            wObj->Update(t_diff);
+            ++count;
+        }
     }
 
-    meas.add_field("count", std::to_string(static_cast<int32>(count)));
+    meas.set(1, count);
+
+    // relocation notifies that came due during the object update, may start attacks that request paths
+    m_aiNotifyQueue.Process();
+
+    // paths requested during the object update, the generators pick them up on their next update
+    m_pathRequests.Process();
 
     // Send world objects and item update field changes
     SendObjectUpdates();
@@ -804,6 +864,327 @@ void Map::Update(const uint32& t_diff)
         i_data->Update(t_diff);
 
     m_weatherSystem->UpdateWeathers(t_diff);
+
+    if (m_objectPool)
+        ReportObjectPool(t_diff);
+}
+
+void Map::ReportObjectPool(uint32 diff)
+{
+    m_objectPoolMetricTimer += diff;
+    if (m_objectPoolMetricTimer < 10 * IN_MILLISECONDS || !m_objectPoolMetrics[0]->enabled())
+        return;
+
+    m_objectPoolMetricTimer = 0;
+
+    for (uint32 kind = 0; kind < MAX_MAP_POOL_KINDS; ++kind)
+    {
+        MapObjectPool::Stats stats = m_objectPool->GetStats(MapObjectPoolKind(kind));
+        m_objectPoolMetrics[kind]->record({ int64(stats.live), int64(stats.capacity) });
+    }
+}
+
+bool Map::CanUpdateInParallel(size_t objectCount) const
+{
+    uint32 threshold = sWorld.getConfig(CONFIG_UINT32_MAP_PARALLEL_UPDATE_THRESHOLD);
+    if (!threshold || objectCount < threshold)
+        return false;
+
+    // script state of the whole map is reached from any object update
+    if (i_data || IsBattleGroundOrArena() || sOutdoorPvPMgr.HasScriptOnMap(GetId()))
+        return false;
+
+    return sMapMgr.GetUpdater().activated();
+}
+
+namespace
+{
+    uint32 ComputeCellId(WorldObject const* obj)
+    {
+        CellPair p = MaNGOS::ComputeCellPair(obj->GetPositionX(), obj->GetPositionY());
+        return p.y_coord * TOTAL_NUMBER_OF_CELLS_PER_MAP + p.x_coord;
+    }
+
+    // disjoint sets of cells, every set becomes one update region
+    class UpdateRegionCells
+    {
+        public:
+            uint32 Find(uint32 cellId)
+            {
+                m_parent.emplace(cellId, cellId);
+
+                uint32 root = cellId;
+                while (m_parent[root] != root)
+                    root = m_parent[root];
+
+                while (cellId != root)
+                {
+                    uint32& parent = m_parent[cellId];
+                    cellId = parent;
+                    parent = root;
+                }
+                return root;
+            }
+
+            void Union(uint32 first, uint32 second)
+            {
+                uint32 firstRoot = Find(first);
+                uint32 secondRoot = Find(second);
+                if (firstRoot != secondRoot)
+                    m_parent[firstRoot] = secondRoot;
+            }
+
+            bool Contains(uint32 cellId) const { return m_parent.find(cellId) != m_parent.end(); }
+
+            std::vector<uint32> GetCells() const
+            {
+                std::vector<uint32> cells;
+                cells.reserve(m_parent.size());
+                for (auto const& node : m_parent)
+                    cells.push_back(node.first);
+                return cells;
+            }
+
+        private:
+            std::unordered_map<uint32, uint32> m_parent;
+    };
+
+    // objects the update of obj can reach whatever their distance
+    template<class F>
+    void VisitUpdateRegionLinks(Map* map, WorldObject* obj, F const& link)
+    {
+        link(map->GetWorldObject(obj->GetOwnerGuid()));
+        link(obj->GetTransport());
+
+        if (obj->GetTypeId() == TYPEID_GAMEOBJECT)
+        {
+            GameObject* go = static_cast<GameObject*>(obj);
+            if (go->IsTransport())
+                for (WorldObject* passenger : static_cast<GenericTransport*>(go)->GetPassengers())
+                    link(passenger);
+            return;
+        }
+
+        if (!obj->isType(TYPEMASK_UNIT))
+            return;
+
+        Unit* unit = static_cast<Unit*>(obj);
+        link(unit->GetVictim());
+        link(unit->GetCharmer());
+        link(unit->GetCharm());
+        link(map->GetUnit(unit->GetPetGuid()));
+
+        if (!unit->GetMotionMaster()->empty())
+            link(unit->GetMotionMaster()->GetCurrent()->GetCurrentTarget());
+
+        for (HostileReference* ref : unit->getThreatManager().getThreatList())
+            link(ref->getTarget());
+
+        for (HostileReference* ref = unit->getHostileRefManager().getFirst(); ref; ref = ref->next())
+            link(ref->getSource()->getOwner());
+
+        // linking events reach masters and slaves map wide, the master side links slaves without own events
+        if (unit->GetTypeId() == TYPEID_UNIT && unit->IsLinkingEventTrigger())
+        {
+            GuidList linked;
+            map->GetCreatureLinkingHolder()->GetLinkedCreatureGuids(static_cast<Creature*>(unit), linked);
+            for (ObjectGuid const& guid : linked)
+                link(map->GetCreature(guid));
+        }
+
+        if (unit->GetTypeId() == TYPEID_PLAYER)
+            if (Group* group = static_cast<Player*>(unit)->GetGroup())
+                for (GroupReference* ref = group->GetFirstMember(); ref; ref = ref->next())
+                    link(ref->getSource());
+    }
+}
+
+bool MapUpdateRegion::IsNear(Cell const& cell) const
+{
+    CellPair p = cell.cellPair();
+    uint32 const last = TOTAL_NUMBER_OF_CELLS_PER_MAP - 1;
+    for (uint32 x = p.x_coord > 0 ? p.x_coord - 1 : 0; x <= std::min(p.x_coord + 1, last); ++x)
+        for (uint32 y = p.y_coord > 0 ? p.y_coord - 1 : 0; y <= std::min(p.y_coord + 1, last); ++y)
+            if (cells.find(y * TOTAL_NUMBER_OF_CELLS_PER_MAP + x) != cells.end())
+                return true;
+
+    return false;
+}
+
+void Map::BuildUpdateRegions(WorldObjectUnSet const& objects)
+{
+    UpdateRegionCells regionCells;
+    std::unordered_map<uint32, std::vector<WorldObject*>> cellObjects;
+    for (WorldObject* obj : objects)
+    {
+        uint32 cellId = ComputeCellId(obj);
+        regionCells.Find(cellId);
+        cellObjects[cellId].push_back(obj);
+    }
+
+    // linked objects share the region, players are updated before the regions but are reached from them
+    auto linkObjects = [&](WorldObject* obj)
+    {
+        uint32 const cellId = ComputeCellId(obj);
+        VisitUpdateRegionLinks(this, obj, [&](WorldObject const* other)
+        {
+            if (other && other != obj && other->IsInWorld() && other->GetMap() == this && other->IsPositionValid())
+                regionCells.Union(cellId, ComputeCellId(other));
+        });
+    };
+
+    for (WorldObject* obj : objects)
+        linkObjects(obj);
+
+    for (MapRefManager::iterator itr = m_mapRefManager.begin(); itr != m_mapRefManager.end(); ++itr)
+    {
+        Player* player = itr->getSource();
+        if (player->IsInWorld() && player->IsPositionValid())
+            linkObjects(player);
+    }
+
+    // cells closer than any grid search reaches are chained into one region, with one cell of margin
+    // on both sides so objects moving into a neighbour cell during the update stay out of reach too
+    float const reach = std::max(GetVisibilityDistance(), 333.0f);  // same limit as Cell::Visit
+    int32 const gap = int32(ceil(reach / SIZE_OF_GRID_CELL)) + 2;
+
+    for (uint32 cellId : regionCells.GetCells())
+    {
+        int32 cellX = int32(cellId % TOTAL_NUMBER_OF_CELLS_PER_MAP);
+        int32 cellY = int32(cellId / TOTAL_NUMBER_OF_CELLS_PER_MAP);
+        for (int32 x = std::max(cellX - gap, 0); x <= std::min(cellX + gap, int32(TOTAL_NUMBER_OF_CELLS_PER_MAP) - 1); ++x)
+        {
+            // pairs are symmetric, only look at the cells after this one
+            for (int32 y = cellY; y <= std::min(cellY + gap, int32(TOTAL_NUMBER_OF_CELLS_PER_MAP) - 1); ++y)
+            {
+                if (y == cellY && x <= cellX)
+                    continue;
+
+                uint32 otherId = uint32(y) * TOTAL_NUMBER_OF_CELLS_PER_MAP + uint32(x);
+                if (regionCells.Contains(otherId))
+                    regionCells.Union(cellId, otherId);
+            }
+        }
+    }
+
+    m_updateRegions.clear();
+    std::unordered_map<uint32, size_t> regionByRoot;
+    for (uint32 cellId : regionCells.GetCells())
+    {
+        auto result = regionByRoot.emplace(regionCells.Find(cellId), m_updateRegions.size());
+        if (result.second)
+            m_updateRegions.emplace_back(this);
+
+        MapUpdateRegion& region = m_updateRegions[result.first->second];
+        region.cells.insert(cellId);
+
+        auto itr = cellObjects.find(cellId);
+        if (itr != cellObjects.end())
+            region.objects.insert(region.objects.end(), itr->second.begin(), itr->second.end());
+    }
+
+    // cells only reached through links of players have nothing to update
+    m_updateRegions.erase(std::remove_if(m_updateRegions.begin(), m_updateRegions.end(), [](MapUpdateRegion const& region)
+    {
+        return region.objects.empty();
+    }), m_updateRegions.end());
+}
+
+uint32 Map::UpdateRegionsInParallel(uint32 diff)
+{
+    WorkerBatch::Run(sMapMgr.GetUpdater(), m_updateRegions.size(), [this, diff](size_t index)
+    {
+        UpdateRegion(m_updateRegions[index], diff);
+    });
+
+    uint32 count = 0;
+    for (auto& region : m_updateRegions)
+        count += region.objects.size();
+
+    MergeUpdateRegions();
+    return count;
+}
+
+static thread_local MapUpdateRegion* s_currentUpdateRegion = nullptr;
+
+MapUpdateRegion* Map::GetCurrentUpdateRegion() const
+{
+    return s_currentUpdateRegion && s_currentUpdateRegion->map == this ? s_currentUpdateRegion : nullptr;
+}
+
+void Map::UpdateRegion(MapUpdateRegion& region, uint32 diff)
+{
+    s_currentUpdateRegion = &region;
+    MapObjectPool::Scope poolScope(m_objectPool);
+
+    for (WorldObject* obj : region.objects)
+        obj->Update(diff);
+
+    s_currentUpdateRegion = nullptr;
+}
+
+std::unique_lock<std::recursive_mutex> Map::LockForUpdateRegion()
+{
+    std::unique_lock<std::recursive_mutex> guard(m_regionLock, std::defer_lock);
+    if (GetCurrentUpdateRegion())
+        guard.lock();
+    return guard;
+}
+
+void Map::RunAfterUpdateRegions(std::function<void(Map*)>&& action)
+{
+    if (MapUpdateRegion* region = GetCurrentUpdateRegion())
+        region->deferred.push_back(std::move(action));
+    else
+        action(this);
+}
+
+void Map::MergeUpdateRegions()
+{
+    // an object removed by one region can already be deleted, it must not stay queued by any region
+    std::set<Object*> clientUpdateRemovals;
+    for (auto& region : m_updateRegions)
+        clientUpdateRemovals.insert(region.clientUpdateRemovals.begin(), region.clientUpdateRemovals.end());
+
+    for (Object* obj : clientUpdateRemovals)
+        i_objectsToClientUpdate.erase(obj);
+
+    for (auto& region : m_updateRegions)
+        for (Object* obj : region.clientUpdates)
+            if (clientUpdateRemovals.find(obj) == clientUpdateRemovals.end())
+                i_objectsToClientUpdate.insert(obj);
+
+    for (auto& region : m_updateRegions)
+    {
+        for (auto& action : region.deferred)
+            action(this);
+
+        for (WorldObject* obj : region.removals)
+            AddObjectToRemoveList(obj);
+    }
+}
+
+void Map::AddUpdateObject(Object* obj)
+{
+    if (MapUpdateRegion* region = GetCurrentUpdateRegion())
+    {
+        region->clientUpdateRemovals.erase(obj);
+        region->clientUpdates.insert(obj);
+    }
+    else
+        i_objectsToClientUpdate.insert(obj);
+}
+
+void Map::RemoveUpdateObject(Object* obj)
+{
+    if (MapUpdateRegion* region = GetCurrentUpdateRegion())
+    {
+        // the object can also be queued from before the regions or by another region
+        region->clientUpdates.erase(obj);
+        region->clientUpdateRemovals.insert(obj);
+    }
+    else
+        i_objectsToClientUpdate.erase(obj);
 }
 
 void Map::Remove(Player* player, bool remove)
@@ -873,6 +1254,8 @@ Map::Remove(T* obj, bool remove)
         return;
     }
 
+    std::lock_guard<std::recursive_mutex> guard(m_regionLock);
+
     Cell cell(p);
     if (!loaded(GridPair(cell.data.Part.grid_x, cell.data.Part.grid_y)))
         return;
@@ -916,8 +1299,36 @@ Map::PlayerRelocation(Player* player, float x, float y, float z, float orientati
     Cell new_cell(new_val);
     bool same_cell = (new_cell == old_cell);
 
+    // players are moved by transports and spells of the regions too
+    std::unique_lock<std::recursive_mutex> guard(m_regionLock, std::defer_lock);
+    if (MapUpdateRegion* region = GetCurrentUpdateRegion())
+    {
+        if (!same_cell)
+        {
+            // far jumps can land in cells of other regions, they are done after the regions
+            if (!region->IsNear(new_cell))
+            {
+                ObjectGuid guid = player->GetObjectGuid();
+                region->deferred.push_back([guid, x, y, z, orientation](Map* map)
+                {
+                    if (Player* player = map->GetPlayer(guid))
+                        map->PlayerRelocation(player, x, y, z, orientation);
+                });
+                return;
+            }
+
+            guard.lock();
+        }
+    }
+
+    float oldX = player->GetPositionX();
+    float oldY = player->GetPositionY();
+
     player->Relocate(x, y, z, orientation);
 
+    if (!same_cell && (sWorld.getConfig(CONFIG_BOOL_GRID_PREFETCH) || sWorld.getConfig(CONFIG_BOOL_MMAP_PREFETCH)))
+        PrefetchGridAhead(player, oldX, oldY);
+
     if (old_cell.DiffGrid(new_cell) || old_cell.DiffCell(new_cell))
     {
         DEBUG_FILTER_LOG(LOG_FILTER_PLAYER_MOVES, "Player %s relocation grid[%u,%u]cell[%u,%u]->grid[%u,%u]cell[%u,%u]", player->GetName(), old_cell.GridX(), old_cell.GridY(), old_cell.CellX(), old_cell.CellY(), new_cell.GridX(), new_cell.GridY(), new_cell.CellX(), new_cell.CellY());
@@ -943,10 +1354,62 @@ Map::PlayerRelocation(Player* player, float x, float y, float z, float orientati
     }
 }
 
+void Map::PrefetchGridAhead(Player* player, float oldX, float oldY)
+{
+    float dx = player->GetPositionX() - oldX;
+    float dy = player->GetPositionY() - oldY;
+    float length = sqrt(dx * dx + dy * dy);
+    if (length < 0.1f)
+        return;
+
+    // grids are loaded once they get into view, look a cell further along the movement
+    float distance = GetVisibilityDistance() + SIZE_OF_GRID_CELL;
+    float x = player->GetPositionX() + dx / length * distance;
+    float y = player->GetPositionY() + dy / length * distance;
+    if (!MaNGOS::IsValidMapCoord(x, y))
+        return;
+
+    GridPair p = MaNGOS::ComputeGridPair(x, y);
+    if (getNGrid(p.x_coord, p.y_coord))
+        return;
+
+    // terrain coords
+    uint32 gx = (MAX_NUMBER_OF_GRIDS - 1) - p.x_coord;
+    uint32 gy = (MAX_NUMBER_OF_GRIDS - 1) - p.y_coord;
+
+    if (sWorld.getConfig(CONFIG_BOOL_GRID_PREFETCH) && !m_bLoadedGrids[gx][gy] && !m_TerrainData->IsGridMapLoaded(gx, gy))
+        sTerrainMgr.PrefetchGrid(GetId(), gx, gy);
+
+    if (sWorld.getConfig(CONFIG_BOOL_MMAP_PREFETCH) && MMAP::MMapFactory::IsPathfindingEnabled(GetId(), nullptr))
+        MMAP::MMapFactory::createOrGetMMapManager()->PrefetchTile(GetId(), gx, gy);
+}
+
 void Map::CreatureRelocation(Creature* creature, float x, float y, float z, float ang)
 {
     Cell new_cell(MaNGOS::ComputeCellPair(x, y));
 
+    // moves between cells change grid containers, a region only owns the cells around its objects
+    std::unique_lock<std::recursive_mutex> guard(m_regionLock, std::defer_lock);
+    if (MapUpdateRegion* region = GetCurrentUpdateRegion())
+    {
+        if (creature->GetCurrentCell() != new_cell)
+        {
+            // far jumps can land in cells of other regions, they are done after the regions
+            if (!region->IsNear(new_cell))
+            {
+                ObjectGuid guid = creature->GetObjectGuid();
+                region->deferred.push_back([guid, x, y, z, ang](Map* map)
+                {
+                    if (Creature* creature = map->GetAnyTypeCreature(guid))
+                        map->CreatureRelocation(creature, x, y, z, ang);
+                });
+                return;
+            }
+
+            guard.lock();
+        }
+    }
+
     // do move or do move to respawn or remove creature if previous all fail
     if (CreatureCellRelocation(creature, new_cell))
     {
@@ -968,6 +1431,27 @@ void Map::GameObjectRelocation(GameObject* go, float x, float y, float z, float
     Cell new_cell(MaNGOS::ComputeCellPair(x, y));
     Cell old_cell = go->GetCurrentCell();
 
+    std::unique_lock<std::recursive_mutex> guard(m_regionLock, std::defer_lock);
+    if (MapUpdateRegion* region = GetCurrentUpdateRegion())
+    {
+        if (old_cell != new_cell)
+        {
+            // far jumps can land in cells of other regions, they are done after the regions
+            if (!region->IsNear(new_cell))
+            {
+                ObjectGuid guid = go->GetObjectGuid();
+                region->deferred.push_back([guid, x, y, z, orientation, respawnRelocationOnFail](Map* map)
+                {
+                    if (GameObject* go = map->GetGameObject(guid))
+                        map->GameObjectRelocation(go, x, y, z, orientation, respawnRelocationOnFail);
+                });
+                return;
+            }
+
+            guard.lock();
+        }
+    }
+
     if (!respawnRelocationOnFail && !getNGrid(new_cell.GridX(), new_cell.GridY()))
         return;
 
@@ -1003,6 +1487,27 @@ void Map::DynamicObjectRelocation(DynamicObject* dynObj, float x, float y, float
     Cell new_cell(MaNGOS::ComputeCellPair(x, y));
     Cell old_cell = dynObj->GetCurrentCell();
 
+    std::unique_lock<std::recursive_mutex> guard(m_regionLock, std::defer_lock);
+    if (MapUpdateRegion* region = GetCurrentUpdateRegion())
+    {
+        if (old_cell != new_cell)
+        {
+            // far jumps can land in cells of other regions, they are done after the regions
+            if (!region->IsNear(new_cell))
+            {
+                ObjectGuid guid = dynObj->GetObjectGuid();
+                region->deferred.push_back([guid, x, y, z, orientation](Map* map)
+                {
+                    if (DynamicObject* dynObj = map->GetDynamicObject(guid))
+                        map->DynamicObjectRelocation(dynObj, x, y, z, orientation);
+                });
+                return;
+            }
+
+            guard.lock();
+        }
+    }
+
     if (!getNGrid(new_cell.GridX(), new_cell.GridY()))
         return;
 
@@ -1284,10 +1789,29 @@ inline void Map::setNGrid(NGridType* grid, uint32 x, uint32 y)
     i_grids[x][y] = grid;
 }
 
+void Map::CollectIndexedObjects(Cell const& cell, CellIndexQuery const& query, std::vector<WorldObject*>& result)
+{
+    const uint32 x = cell.GridX();
+    const uint32 y = cell.GridY();
+
+    if (!cell.NoCreate() || loaded(GridPair(x, y)))
+    {
+        EnsureGridLoaded(cell);
+        (*getNGrid(x, y))(cell.CellX(), cell.CellY()).GetIndex().Collect(query, result);
+    }
+}
+
 void Map::AddObjectToRemoveList(WorldObject* obj)
 {
     MANGOS_ASSERT(obj->GetMapId() == GetId() && obj->GetInstanceId() == GetInstanceId());
 
+    // cleanups touch objects of the whole map, delay them until all regions are done
+    if (MapUpdateRegion* region = GetCurrentUpdateRegion())
+    {
+        region->removals.push_back(obj);
+        return;
+    }
+
     obj->CleanupsBeforeDelete();                            // remove or simplify at least cross referenced links
 
     i_objectsToRemove.insert(obj);
@@ -1403,6 +1927,8 @@ bool Map::ActiveObjectsNearGrid(uint32 x, uint32 y) const
 
 void Map::AddToActive(WorldObject* obj)
 {
+    std::lock_guard<std::recursive_mutex> guard(m_regionLock);
+
     m_activeNonPlayers.insert(obj);
     Cell cell = Cell(MaNGOS::ComputeCellPair(obj->GetPositionX(), obj->GetPositionY()));
     EnsureGridLoaded(cell);
@@ -1431,6 +1957,8 @@ void Map::AddToActive(WorldObject* obj)
 
 void Map::RemoveFromActive(WorldObject* obj)
 {
+    std::lock_guard<std::recursive_mutex> guard(m_regionLock);
+
     // Map::Update for active object in proccess
     if (m_activeNonPlayersIter != m_activeNonPlayers.end())
     {
@@ -1947,6 +2475,8 @@ bool Map::ScriptsStart(ScriptMapMapName const& scripts, uint32 id, Object* sourc
 {
     MANGOS_ASSERT(source);
 
+    std::lock_guard<std::recursive_mutex> guard(m_regionLock);
+
     ///- Find the script map
     ScriptMapMap::const_iterator scriptInfoMapMapItr = scripts.second.find(id);
     if (scriptInfoMapMapItr == scripts.second.end())
@@ -2013,6 +2543,7 @@ void Map::ScriptCommandStart(ScriptInfo const& script, uint32 delay, Object* sou
 
     ScriptAction sa("Internal Activate Command used for spell", this, sourceGuid, targetGuid, ownerGuid, &script);
 
+    std::lock_guard<std::recursive_mutex> guard(m_regionLock);
     if (delay)
     {
         m_scriptSchedule.emplace(GetCurrentClockTime() + std::chrono::milliseconds(delay), sa);
@@ -2084,6 +2615,7 @@ Player* Map::GetPlayer(ObjectGuid guid)
  */
 Creature* Map::GetCreature(ObjectGuid guid)
 {
+    auto guard = LockForUpdateRegion();
     return m_objectsStore.find<Creature>(guid, (Creature*)nullptr);
 }
 
@@ -2094,6 +2626,7 @@ Creature* Map::GetCreature(ObjectGuid guid)
  */
 Pet* Map::GetPet(ObjectGuid guid)
 {
+    auto guard = LockForUpdateRegion();
     return m_objectsStore.find<Pet>(guid, (Pet*)nullptr);
 }
 
@@ -2135,6 +2668,7 @@ Creature* Map::GetAnyTypeCreature(ObjectGuid guid)
  */
 GameObject* Map::GetGameObject(ObjectGuid guid)
 {
+    auto guard = LockForUpdateRegion();
     return m_objectsStore.find<GameObject>(guid, (GameObject*)nullptr);
 }
 
@@ -2145,6 +2679,7 @@ GameObject* Map::GetGameObject(ObjectGuid guid)
  */
 DynamicObject* Map::GetDynamicObject(ObjectGuid guid)
 {
+    auto guard = LockForUpdateRegion();
     return m_objectsStore.find<DynamicObject>(guid, (DynamicObject*)nullptr);
 }
 
@@ -2202,6 +2737,26 @@ void Map::SendObjectUpdates()
         obj->BuildUpdateData(update_players);
     }
 
+    // building the packets compresses them, spread that over the free updater threads on crowded maps
+    uint32 parallelThreshold = sWorld.getConfig(CONFIG_UINT32_COMPRESSION_PARALLEL_THRESHOLD);
+    if (parallelThreshold && update_players.size() >= parallelThreshold && sMapMgr.GetUpdater().activated())
+    {
+        std::vector<std::pair<UpdateDataMapType::iterator, size_t>> jobs;
+        for (auto itr = update_players.begin(); itr != update_players.end(); ++itr)
+            for (size_t i = 0; i < itr->second.GetPacketCount(); ++i)
+                jobs.emplace_back(itr, i);
+
+        std::vector<WorldPacket> packets(jobs.size());
+        WorkerBatch::Run(sMapMgr.GetUpdater(), jobs.size(), [&jobs, &packets](size_t index)
+        {
+            packets[index] = jobs[index].first->second.BuildPacket(jobs[index].second);
+        });
+
+        for (size_t i = 0; i < jobs.size(); ++i)
+            jobs[i].first->first->GetSession()->SendPacket(packets[i]);
+        return;
+    }
+
     for (auto& update_player : update_players)
     {
         for (size_t i = 0; i < update_player.second.GetPacketCount(); ++i)
@@ -2214,6 +2769,9 @@ void Map::SendObjectUpdates()
 
 uint32 Map::GenerateLocalLowGuid(HighGuid guidhigh)
 {
+    // summons, totems and dynamic objects can be created by several regions at once
+    auto guard = LockForUpdateRegion();
+
     // TODO: for map local guid counters possible force reload map instead shutdown server at guid counter overflow
     switch (guidhigh)
     {
@@ -2334,10 +2892,117 @@ void Map::PlayDirectSoundToMap(uint32 soundId, uint32 zoneId /*=0*/) const
 /**
  * Function to check if a point is in line of sight from an other point
  */
+// Line of sight results of the current map update. Kept per thread so parallel update regions do not need a lock,
+// entries of an older update are told apart by their generation and simply overwritten.
+namespace
+{
+    uint32 const LINE_OF_SIGHT_MEMO_SIZE = 1024;            // direct mapped, a colliding check replaces the entry
+    float const LINE_OF_SIGHT_MEMO_PRECISION = 4.0f;        // endpoints are quantized to a quarter yard
+
+    struct LineOfSightMemoEntry
+    {
+        uint32 generation;
+        int32 key[6];
+        uint32 phasemask;
+        bool ignoreM2Model;
+        bool result;
+    };
+
+    thread_local LineOfSightMemoEntry s_lineOfSightMemo[LINE_OF_SIGHT_MEMO_SIZE];
+    std::atomic<uint32> s_lineOfSightGeneration(0);
+
+    LineOfSightMemoEntry& GetLineOfSightMemoEntry(VMAP::LineOfSightQuery const& query, uint32 phasemask, bool ignoreM2Model, int32* key)
+    {
+        float const coords[6] = { query.x1, query.y1, query.z1, query.x2, query.y2, query.z2 };
+
+        uint32 hash = phasemask * 2 + (ignoreM2Model ? 1 : 0);
+        for (uint32 i = 0; i < 6; ++i)
+        {
+            key[i] = int32(floor(coords[i] * LINE_OF_SIGHT_MEMO_PRECISION));
+            hash = hash * 31 + uint32(key[i]);
+        }
+
+        return s_lineOfSightMemo[(hash ^ (hash >> 16)) & (LINE_OF_SIGHT_MEMO_SIZE - 1)];
+    }
+
+    bool MatchesLineOfSightMemo(LineOfSightMemoEntry const& entry, uint32 generation, int32 const* key, uint32 phasemask, bool ignoreM2Model)
+    {
+        return entry.generation == generation && entry.phasemask == phasemask && entry.ignoreM2Model == ignoreM2Model &&
+               memcmp(entry.key, key, sizeof(entry.key)) == 0;
+    }
+
+    void StoreLineOfSightMemo(LineOfSightMemoEntry& entry, uint32 generation, int32 const* key, uint32 phasemask, bool ignoreM2Model, bool result)
+    {
+        entry.generation = generation;
+        memcpy(entry.key, key, sizeof(entry.key));
+        entry.phasemask = phasemask;
+        entry.ignoreM2Model = ignoreM2Model;
+        entry.result = result;
+    }
+}
+
+uint32 Map::NextLineOfSightGeneration()
+{
+    uint32 generation = ++s_lineOfSightGeneration;
+    // 0 marks the memo as disabled
+    return generation ? generation : ++s_lineOfSightGeneration;
+}
+
 bool Map::IsInLineOfSight(float srcX, float srcY, float srcZ, float destX, float destY, float destZ, uint32 phasemask, bool ignoreM2Model) const
 {
-    return VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSight(GetId(), srcX, srcY, srcZ, destX, destY, destZ, ignoreM2Model)
-           && m_dyn_tree.isInLineOfSight(srcX, srcY, srcZ, destX, destY, destZ, phasemask, ignoreM2Model);
+    if (!m_lineOfSightGeneration)
+        return VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSight(GetId(), srcX, srcY, srcZ, destX, destY, destZ, ignoreM2Model)
+               && m_dyn_tree.isInLineOfSight(srcX, srcY, srcZ, destX, destY, destZ, phasemask, ignoreM2Model);
+
+    VMAP::LineOfSightQuery query = { srcX, srcY, srcZ, destX, destY, destZ, true };
+    int32 key[6];
+    LineOfSightMemoEntry& entry = GetLineOfSightMemoEntry(query, phasemask, ignoreM2Model, key);
+    if (MatchesLineOfSightMemo(entry, m_lineOfSightGeneration, key, phasemask, ignoreM2Model))
+        return entry.result;
+
+    bool result = VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSight(GetId(), srcX, srcY, srcZ, destX, destY, destZ, ignoreM2Model)
+                  && m_dyn_tree.isInLineOfSight(srcX, srcY, srcZ, destX, destY, destZ, phasemask, ignoreM2Model);
+    StoreLineOfSightMemo(entry, m_lineOfSightGeneration, key, phasemask, ignoreM2Model, result);
+    return result;
+}
+
+void Map::IsInLineOfSight(VMAP::LineOfSightQuery* queries, size_t count, uint32 phasemask, bool ignoreM2Model) const
+{
+    // rays answered by the memo are left out of the batch
+    std::vector<size_t> pending;
+    pending.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        int32 key[6];
+        LineOfSightMemoEntry& entry = GetLineOfSightMemoEntry(queries[i], phasemask, ignoreM2Model, key);
+        if (m_lineOfSightGeneration && MatchesLineOfSightMemo(entry, m_lineOfSightGeneration, key, phasemask, ignoreM2Model))
+            queries[i].inLineOfSight = entry.result;
+        else
+            pending.push_back(i);
+    }
+
+    if (pending.empty())
+        return;
+
+    std::vector<VMAP::LineOfSightQuery> batch;
+    batch.reserve(pending.size());
+    for (size_t index : pending)
+        batch.push_back(queries[index]);
+
+    VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSight(GetId(), batch.data(), batch.size(), ignoreM2Model);
+
+    for (size_t i = 0; i < pending.size(); ++i)
+    {
+        VMAP::LineOfSightQuery& query = queries[pending[i]];
+        query.inLineOfSight = batch[i].inLineOfSight && m_dyn_tree.isInLineOfSight(query.x1, query.y1, query.z1, query.x2, query.y2, query.z2, phasemask, ignoreM2Model);
+
+        if (m_lineOfSightGeneration)
+        {
+            int32 key[6];
+            LineOfSightMemoEntry& entry = GetLineOfSightMemoEntry(query, phasemask, ignoreM2Model, key);
+            StoreLineOfSightMemo(entry, m_lineOfSightGeneration, key, phasemask, ignoreM2Model, query.inLineOfSight);
+        }
+    }
 }
 
 /**
@@ -2647,11 +3312,13 @@ uint32 Map::SpawnedCountForEntry(uint32 entry)
 
 void Map::AddToSpawnCount(const ObjectGuid& guid)
 {
+    std::lock_guard<std::recursive_mutex> guard(m_regionLock);
     m_spawnedCount[guid.GetEntry()].insert(guid);
 }
 
 void Map::RemoveFromSpawnCount(const ObjectGuid& guid)
 {
+    std::lock_guard<std::recursive_mutex> guard(m_regionLock);
     m_spawnedCount[guid.GetEntry()].erase(guid);
 }
 
@@ -35,12 +35,18 @@
 #include "Entities/CreatureLinkingMgr.h"
 #include "Vmap/DynamicTree.h"
 #include "Multithreading/Messager.h"
+#include "MotionGenerators/PathRequestQueue.h"
+#include "Maps/AINotifyQueue.h"
+#include "Maps/MapObjectPool.h"
 
 #include <bitset>
 #include <functional>
 #include <list>
+#include <mutex>
+#include <unordered_set>
 
 struct CreatureInfo;
+namespace VMAP { struct LineOfSightQuery; }
 class Creature;
 class Unit;
 class WorldPacket;
@@ -57,6 +63,7 @@ class GameObjectModel;
 class WeatherSystem;
 class GenericTransport;
 namespace MaNGOS { struct ObjectUpdater; }
+namespace metric { class handle; }
 class Transport;
 
 // GCC have alternative #pragma pack(N) syntax and old gcc version not support pack(push,N), also any gcc version not support it at some platform
@@ -110,6 +117,31 @@ struct ZoneDynamicInfo
 
 typedef std::unordered_map<uint32 /*zoneId*/, ZoneDynamicInfo> ZoneDynamicInfoMap;
 
+// Part of a map whose objects are far enough from all other parts to be updated on its own thread.
+// What a region may touch while the regions of its map are updated:
+// - objects in and near its own cells; regions are further apart than any grid search reaches, and objects
+//   referencing each other (victim, threat, hostile references, owner, charm, pet, group, movement target,
+//   transport, creature linking) are put into one region whatever their distance
+// - map wide containers (object store, grids, active objects, script schedule, spawn counts, guid generators,
+//   creature linking holder) only under the region lock; pool updates run after the regions
+// Maps with instance data, battleground or outdoor pvp scripts keep map wide script state and are not split.
+// Side effects on shared map state are collected here and merged by the map thread after all regions are done.
+struct MapUpdateRegion
+{
+    explicit MapUpdateRegion(Map* map) : map(map) {}
+
+    // moves within one cell of the region stay in cells no other region reaches
+    bool IsNear(Cell const& cell) const;
+
+    Map* map;
+    std::vector<WorldObject*> objects;
+    std::unordered_set<uint32> cells;
+    std::set<Object*> clientUpdates;
+    std::set<Object*> clientUpdateRemovals;                 // erased from the client updates of all regions at merge
+    std::vector<WorldObject*> removals;
+    std::vector<std::function<void(Map*)>> deferred;
+};
+
 class Map : public GridRefManager<NGridType>
 {
         friend class MapReference;
@@ -166,6 +198,7 @@ class Map : public GridRefManager<NGridType>
         void DynamicObjectRelocation(DynamicObject* dynObj, float x, float y, float z, float orientation);
 
         template<class T, class CONTAINER> void Visit(const Cell& cell, TypeContainerVisitor<T, CONTAINER>& visitor);
+        void CollectIndexedObjects(Cell const& cell, CellIndexQuery const& query, std::vector<WorldObject*>& result);
 
         bool IsRemovalGrid(float x, float y) const
         {
@@ -288,15 +321,19 @@ class Map : public GridRefManager<NGridType>
         std::map<uint32, uint32>& GetTempCreatures() { return m_tempCreatures; }
         std::map<uint32, uint32>& GetTempPets() { return m_tempPets; }
 
-        void AddUpdateObject(Object* obj)
-        {
-            i_objectsToClientUpdate.insert(obj);
-        }
+        void AddUpdateObject(Object* obj);
+        void RemoveUpdateObject(Object* obj);
 
-        void RemoveUpdateObject(Object* obj)
-        {
-            i_objectsToClientUpdate.erase(obj);
-        }
+        // region of this map updated by the calling thread, nullptr outside of a parallel update
+        MapUpdateRegion* GetCurrentUpdateRegion() const;
+        void UpdateRegion(MapUpdateRegion& region, uint32 diff);
+        // locked only when called from a region, for map wide state shared by all regions
+        std::unique_lock<std::recursive_mutex> LockForUpdateRegion();
+        // runs the action at once, or after all regions are done when called from a region
+        void RunAfterUpdateRegions(std::function<void(Map*)>&& action);
+
+        PathRequestQueue& GetPathRequestQueue() { return m_pathRequests; }
+        AINotifyQueue& GetAINotifyQueue() { return m_aiNotifyQueue; }
 
         // DynObjects currently
         uint32 GenerateLocalLowGuid(HighGuid guidhigh);
@@ -316,6 +353,8 @@ class Map : public GridRefManager<NGridType>
         float GetHeight(uint32 phasemask, float x, float y, float z, bool swim = false) const;
         bool GetHeightInRange(uint32 phasemask, float x, float y, float& z, float maxSearchDist = 4.0f) const;
         bool IsInLineOfSight(float srcX, float srcY, float srcZ, float destX, float destY, float destZ, uint32 phasemask, bool ignoreM2Model) const;
+        // checks all rays at once, the results are remembered for later single checks of the same update
+        void IsInLineOfSight(VMAP::LineOfSightQuery* queries, size_t count, uint32 phasemask, bool ignoreM2Model) const;
         bool GetHitPosition(float srcX, float srcY, float srcZ, float& destX, float& destY, float& destZ, uint32 phasemask, float modifyDist) const;
 
         // Object Model insertion/remove/test for dynamic vmaps use
@@ -363,6 +402,10 @@ class Map : public GridRefManager<NGridType>
 
         Messager<Map>& GetMessager() { return m_messager; }
 
+        // duration of the last update in microseconds, used to start the most expensive maps first
+        uint32 GetUpdateCost() const { return m_updateCost; }
+        void SetUpdateCost(uint32 cost) { m_updateCost = cost; }
+
         GenericTransport* GetTransport(ObjectGuid guid);
 
         void AddTransport(Transport* transport);
@@ -405,6 +448,15 @@ class Map : public GridRefManager<NGridType>
         void setNGrid(NGridType* grid, uint32 x, uint32 y);
         void ScriptsProcess();
 
+        bool CanUpdateInParallel(size_t objectCount) const;
+        void BuildUpdateRegions(WorldObjectUnSet const& objects);
+        uint32 UpdateRegionsInParallel(uint32 diff);
+        void MergeUpdateRegions();
+        void ReportObjectPool(uint32 diff);
+
+        void PrefetchGridAhead(Player* player, float oldX, float oldY);
+        static uint32 NextLineOfSightGeneration();
+
         void SendObjectUpdates();
         std::set<Object*> i_objectsToClientUpdate;
 
@@ -444,6 +496,16 @@ class Map : public GridRefManager<NGridType>
 
         WorldObjectSet i_objectsToRemove;
 
+        // parallel update of independent map regions
+        std::vector<MapUpdateRegion> m_updateRegions;
+        std::recursive_mutex m_regionLock;                  // guards shared map containers while regions are updated
+
+        PathRequestQueue m_pathRequests;
+        AINotifyQueue m_aiNotifyQueue;
+
+        MapObjectPool* m_objectPool;                        // nullptr if objects of this map come from the heap
+        uint32 m_objectPoolMetricTimer;
+
         typedef std::multimap<TimePoint, ScriptAction> ScriptScheduleMap;
         ScriptScheduleMap m_scriptSchedule;
 
@@ -482,6 +544,16 @@ class Map : public GridRefManager<NGridType>
 
         ZoneDynamicInfoMap m_zoneDynamicInfo;
         uint32 i_defaultLight;
+
+        uint32 m_updateCost;
+
+        uint32 m_lineOfSightGeneration;                     // tags line of sight results memorized during the current update, 0 if disabled
+
+        // registered once per map, tagged with map and instance id
+        std::unique_ptr<metric::handle> m_updateMetric;
+        std::unique_ptr<metric::handle> m_sessionUpdateMetric;
+        std::unique_ptr<metric::handle> m_objectPoolMetrics[MAX_MAP_POOL_KINDS];
+        std::unique_ptr<metric::handle> m_gridLoadMetric;
 };
 
 class WorldMap : public Map
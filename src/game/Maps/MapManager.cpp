@@ -192,16 +192,34 @@ void MapManager::Update(uint32 diff)
     if (!i_timer.Passed())
         return;
 
-    for (auto& map : i_maps)
+    if (m_updater.activated())
     {
-        if (m_updater.activated())
-            m_updater.schedule_update(new MapUpdateWorker(*map.second, (uint32)i_timer.GetCurrent(), m_updater));
-        else
-            map.second->Update((uint32)i_timer.GetCurrent());
-    }
+        // most expensive maps of the previous tick go first, so the slowest one is not left for the end of the tick
+        m_updateOrder.clear();
+        for (auto& map : i_maps)
+            m_updateOrder.push_back(map.second);
+
+        std::sort(m_updateOrder.begin(), m_updateOrder.end(), [](Map const* left, Map const* right)
+        {
+            return left->GetUpdateCost() > right->GetUpdateCost();
+        });
+
+        while (m_updateWorkers.size() < m_updateOrder.size())
+            m_updateWorkers.emplace_back(new MapUpdateWorker(m_updater));
+
+        for (size_t i = 0; i < m_updateOrder.size(); ++i)
+        {
+            m_updateWorkers[i]->Reset(*m_updateOrder[i], (uint32)i_timer.GetCurrent());
+            m_updater.schedule_update(*m_updateWorkers[i]);
+        }
 
-    if (m_updater.activated())
         m_updater.wait();
+    }
+    else
+    {
+        for (auto& map : i_maps)
+            map.second->Update((uint32)i_timer.GetCurrent());
+    }
 
     // remove all maps which can be unloaded
     MapMapType::iterator iter = i_maps.begin();
@@ -31,6 +31,7 @@
 
 class Transport;
 class BattleGround;
+class MapUpdateWorker;
 struct TransportTemplate;
 
 struct MapID
@@ -154,6 +155,8 @@ class MapManager : public MaNGOS::Singleton<MapManager, MaNGOS::ClassLevelLockab
         void DoForAllMaps(const std::function<void(Map*)>& worker);
         void DoForAllMapsWithMapId(uint32 mapId, std::function<void(Map*)> worker);
 
+        MapUpdater& GetUpdater() { return m_updater; }
+
     private:
 
         // debugging code, should be deleted some day
@@ -181,6 +184,8 @@ class MapManager : public MaNGOS::Singleton<MapManager, MaNGOS::ClassLevelLockab
         IntervalTimer i_timer;
 
         MapUpdater m_updater;
+        std::vector<Map*> m_updateOrder;
+        std::vector<std::unique_ptr<MapUpdateWorker>> m_updateWorkers;
 };
 
 template<typename Do>
@@ -0,0 +1,154 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "Maps/MapObjectPool.h"
+
+#include <algorithm>
+#include <new>
+
+namespace
+{
+    // in front of every block, also of heap fallbacks, so Deallocate knows where it goes
+    struct alignas(16) MapObjectPoolHeader
+    {
+        MapObjectPool* pool;
+        uint32 sizeClass;
+        uint32 kind;
+    };
+
+    const size_t MAP_POOL_GRANULARITY = 64;
+    const size_t MAP_POOL_SLAB_SIZE = 64 * 1024;
+    const uint32 MAP_POOL_MIN_SLAB_BLOCKS = 4;
+
+    thread_local MapObjectPool* t_currentPool = nullptr;
+}
+
+MapObjectPool::Scope::Scope(MapObjectPool* pool) : m_previous(t_currentPool)
+{
+    t_currentPool = pool;
+}
+
+MapObjectPool::Scope::~Scope()
+{
+    t_currentPool = m_previous;
+}
+
+MapObjectPool::MapObjectPool() : m_references(1), m_stats()
+{
+}
+
+MapObjectPool::~MapObjectPool()
+{
+    for (void* slab : m_slabs)
+        ::operator delete(slab);
+}
+
+void MapObjectPool::Release()
+{
+    bool last;
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        last = --m_references == 0;
+    }
+    if (last)
+        delete this;
+}
+
+MapObjectPool::Stats MapObjectPool::GetStats(MapObjectPoolKind kind) const
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    return m_stats[kind];
+}
+
+void* MapObjectPool::Allocate(size_t size, MapObjectPoolKind kind)
+{
+    if (MapObjectPool* pool = t_currentPool)
+        return pool->AllocateBlock(size, kind);
+
+    MapObjectPoolHeader* header = static_cast<MapObjectPoolHeader*>(::operator new(sizeof(MapObjectPoolHeader) + size));
+    header->pool = nullptr;
+    header->sizeClass = 0;
+    header->kind = kind;
+    return header + 1;
+}
+
+void MapObjectPool::Deallocate(void* ptr)
+{
+    if (!ptr)
+        return;
+
+    MapObjectPoolHeader* header = static_cast<MapObjectPoolHeader*>(ptr) - 1;
+    if (MapObjectPool* pool = header->pool)
+        pool->DeallocateBlock(header, header->sizeClass, MapObjectPoolKind(header->kind));
+    else
+        ::operator delete(header);
+}
+
+void* MapObjectPool::AllocateBlock(size_t size, MapObjectPoolKind kind)
+{
+    uint32 sizeClass = uint32((size + sizeof(MapObjectPoolHeader) + MAP_POOL_GRANULARITY - 1) / MAP_POOL_GRANULARITY);
+
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    void*& freeList = m_freeLists[kind][sizeClass];
+    if (!freeList)
+    {
+        // carve a new slab into blocks of this class
+        uint32 blockSize = sizeClass * MAP_POOL_GRANULARITY;
+        uint32 blocks = std::max(MAP_POOL_MIN_SLAB_BLOCKS, uint32(MAP_POOL_SLAB_SIZE / blockSize));
+        char* slab = static_cast<char*>(::operator new(size_t(blockSize) * blocks));
+        m_slabs.push_back(slab);
+
+        for (uint32 i = 0; i < blocks; ++i)
+        {
+            void* block = slab + size_t(i) * blockSize;
+            *static_cast<void**>(block) = freeList;
+            freeList = block;
+        }
+        m_stats[kind].capacity += blocks;
+    }
+
+    void* block = freeList;
+    freeList = *static_cast<void**>(block);
+
+    ++m_stats[kind].live;
+    ++m_references;
+
+    MapObjectPoolHeader* header = static_cast<MapObjectPoolHeader*>(block);
+    header->pool = this;
+    header->sizeClass = sizeClass;
+    header->kind = kind;
+    return header + 1;
+}
+
+void MapObjectPool::DeallocateBlock(void* block, uint32 sizeClass, MapObjectPoolKind kind)
+{
+    bool last;
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+
+        void*& freeList = m_freeLists[kind][sizeClass];
+        *static_cast<void**>(block) = freeList;
+        freeList = block;
+
+        --m_stats[kind].live;
+        last = --m_references == 0;
+    }
+    if (last)
+        delete this;
+}
@@ -0,0 +1,89 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_MAP_OBJECT_POOL_H
+#define MANGOS_MAP_OBJECT_POOL_H
+
+#include "Common.h"
+
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+enum MapObjectPoolKind
+{
+    MAP_POOL_CREATURE,
+    MAP_POOL_GAMEOBJECT,
+    MAP_POOL_DYNAMICOBJECT,
+    MAP_POOL_AURA,
+    MAP_POOL_SPELL_AURA_HOLDER,
+    MAX_MAP_POOL_KINDS
+};
+
+// Slab allocator for the objects a map creates and destroys all the time. Pooled classes route
+// their operator new/delete here; objects created while a pool is current on the thread (see Scope)
+// come from free lists of that pool, all others from the heap. Freed blocks go back to the pool
+// they came from, whatever thread frees them. The pool stays alive until the map released it and
+// the last of its objects is gone, so objects may outlive their map.
+class MapObjectPool
+{
+    public:
+        struct Stats
+        {
+            uint32 live;                                    // blocks in use
+            uint32 capacity;                                // blocks in slabs
+        };
+
+        // makes the pool current for allocations of this thread, nullptr selects the heap
+        class Scope
+        {
+            public:
+                explicit Scope(MapObjectPool* pool);
+                ~Scope();
+
+                Scope(Scope const&) = delete;
+                Scope& operator=(Scope const&) = delete;
+
+            private:
+                MapObjectPool* m_previous;
+        };
+
+        MapObjectPool();
+
+        // drops the reference of the owning map
+        void Release();
+
+        Stats GetStats(MapObjectPoolKind kind) const;
+
+        static void* Allocate(size_t size, MapObjectPoolKind kind);
+        static void Deallocate(void* ptr);
+
+    private:
+        ~MapObjectPool();
+
+        void* AllocateBlock(size_t size, MapObjectPoolKind kind);
+        void DeallocateBlock(void* block, uint32 sizeClass, MapObjectPoolKind kind);
+
+        mutable std::mutex m_lock;
+        uint32 m_references;                                // owning map and live blocks
+        std::unordered_map<uint32, void*> m_freeLists[MAX_MAP_POOL_KINDS]; // per size class
+        Stats m_stats[MAX_MAP_POOL_KINDS];
+        std::vector<void*> m_slabs;
+};
+
+#endif
@@ -19,10 +19,13 @@
 #include "MapUpdater.h"
 #include "MapWorkers.h"
 
-MapUpdater::MapUpdater(size_t num_threads) : _cancelationToken(false), pending_requests(0)
+// queue owned by the calling thread, if it is one of the updater threads
+static thread_local MapUpdater const* s_threadUpdater = nullptr;
+static thread_local size_t s_threadQueue = 0;
+
+MapUpdater::MapUpdater(size_t num_threads) : _cancelationToken(false), _queuedRequests(0), _nextQueue(0), pending_requests(0)
 {
-    for (size_t i = 0; i < num_threads; ++i)
-        _workerThreads.push_back(std::thread(&MapUpdater::WorkerThread, this));
+    activate(num_threads);
 }
 
 void MapUpdater::activate(size_t num_threads)
@@ -31,17 +34,32 @@ void MapUpdater::activate(size_t num_threads)
         return;
 
     for (size_t i = 0; i < num_threads; ++i)
-        _workerThreads.push_back(std::thread(&MapUpdater::WorkerThread, this));
+        _queues.push_back(std::unique_ptr<RequestQueue>(new RequestQueue));
+
+    for (size_t i = 0; i < num_threads; ++i)
+        _workerThreads.push_back(std::thread(&MapUpdater::WorkerThread, this, i));
 }
 
 void MapUpdater::deactivate()
 {
     _cancelationToken = true;
 
-    _queue.Cancel();
+    {
+        std::lock_guard<std::mutex> lock(_idleLock);
+        _idleCondition.notify_all();
+    }
 
     for (auto& thread : _workerThreads)
         thread.join();
+
+    for (auto& queue : _queues)
+    {
+        for (Request& request : queue->requests)
+            if (request.owned)
+                delete request.worker;
+
+        queue->requests.clear();
+    }
 }
 
 void MapUpdater::wait()
@@ -65,36 +83,107 @@ bool MapUpdater::activated()
 
 void MapUpdater::update_finished()
 {
-    std::lock_guard<std::mutex> lock(_lock);
+    if (--pending_requests > 0)
+        return;
 
-    --pending_requests;
+    std::lock_guard<std::mutex> lock(_lock);
     _condition.notify_all();
 }
 
 void MapUpdater::schedule_update(Worker* worker)
 {
-    std::lock_guard<std::mutex> lock(_lock);
+    ++pending_requests;
+    push({ worker, true });
+}
 
+void MapUpdater::schedule_update(Worker& worker)
+{
     ++pending_requests;
-    _queue.Push(std::move(worker));
+    push({ &worker, false });
 }
 
-void MapUpdater::WorkerThread()
+void MapUpdater::push(Request const& request)
 {
+    // requests scheduled from an updater thread stay local to it, others are spread round robin
+    size_t index = s_threadUpdater == this ? s_threadQueue : _nextQueue++ % _queues.size();
+
+    // counted before it is visible, so the counter never drops below the real number of requests
+    {
+        std::lock_guard<std::mutex> lock(_idleLock);
+        ++_queuedRequests;
+    }
+
+    {
+        RequestQueue& queue = *_queues[index];
+        std::lock_guard<std::mutex> lock(queue.lock);
+        queue.requests.push_back(request);
+    }
+
+    _idleCondition.notify_one();
+}
+
+bool MapUpdater::pop(size_t index, Request& request)
+{
+    {
+        RequestQueue& queue = *_queues[index];
+        std::lock_guard<std::mutex> lock(queue.lock);
+        if (!queue.requests.empty())
+        {
+            request = queue.requests.front();
+            queue.requests.pop_front();
+            --_queuedRequests;
+            return true;
+        }
+    }
+
+    for (size_t i = 1; i < _queues.size(); ++i)
+    {
+        RequestQueue& queue = *_queues[(index + i) % _queues.size()];
+        std::lock_guard<std::mutex> lock(queue.lock);
+        if (!queue.requests.empty())
+        {
+            request = queue.requests.back();
+            queue.requests.pop_back();
+            --_queuedRequests;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void MapUpdater::WorkerThread(size_t index)
+{
+    s_threadUpdater = this;
+    s_threadQueue = index;
+
     while (true)
     {
-        Worker* request = nullptr;
+        Request request;
 
-        _queue.WaitAndPop(request);
+        if (!pop(index, request))
+        {
+            std::unique_lock<std::mutex> lock(_idleLock);
+
+            while (_queuedRequests == 0 && !_cancelationToken)
+                _idleCondition.wait(lock);
+
+            if (_cancelationToken)
+                return;
+
+            continue;
+        }
 
         if (_cancelationToken)
         {
-            delete request;
+            if (request.owned)
+                delete request.worker;
             return;
         }
 
-        request->execute();
+        request.worker->execute();
 
-        delete request;
+        if (request.owned)
+            delete request.worker;
     }
-}
\ No newline at end of file
+}
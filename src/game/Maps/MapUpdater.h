@@ -20,11 +20,12 @@
 #define _MAP_UPDATER_H_INCLUDED
 
 #include "Platform/Define.h"
-#include "ProducerConsumerQueue.h"
 
 #include <mutex>
 #include <thread>
 #include <atomic>
+#include <deque>
+#include <memory>
 #include <vector>
 #include <condition_variable>
 
@@ -33,29 +34,51 @@ class Worker;
 class MapUpdater
 {
     public:
-        MapUpdater() : _cancelationToken(false), pending_requests(0) {}
+        MapUpdater() : _cancelationToken(false), _queuedRequests(0), _nextQueue(0), pending_requests(0) {}
         MapUpdater(size_t num_threads);
         MapUpdater(const MapUpdater&) = delete;
-        
+
         void activate(size_t num_threads);
         void deactivate();
         void wait();
         void join();
         bool activated();
         void update_finished();
-        void schedule_update(Worker* worker);
+        void schedule_update(Worker* worker);               // updater takes ownership of worker
+        void schedule_update(Worker& worker);               // worker must stay alive until wait() returns
 
     private:
-        ProducerConsumerQueue<Worker *> _queue;
+        struct Request
+        {
+            Worker* worker;
+            bool owned;
+        };
+
+        // every thread takes requests from the front of its own queue, in scheduling order,
+        // and steals from the back of the other queues when its own one is empty
+        struct RequestQueue
+        {
+            std::mutex lock;
+            std::deque<Request> requests;
+        };
+
+        std::vector<std::unique_ptr<RequestQueue>> _queues;
 
         std::vector<std::thread> _workerThreads;
         std::atomic<bool> _cancelationToken;
 
+        std::mutex _idleLock;
+        std::condition_variable _idleCondition;
+        std::atomic<size_t> _queuedRequests;
+        std::atomic<size_t> _nextQueue;
+
         std::mutex _lock;
         std::condition_variable _condition;
-        size_t pending_requests;
+        std::atomic<size_t> pending_requests;
 
-        void WorkerThread();
+        void push(Request const& request);
+        bool pop(size_t index, Request& request);
+        void WorkerThread(size_t index);
 };
 
-#endif //_MAP_UPDATER_H_INCLUDED
\ No newline at end of file
+#endif //_MAP_UPDATER_H_INCLUDED
@@ -26,6 +26,10 @@
 #include "Entities/Object.h"
 #include "Platform/Define.h"
 
+#include <chrono>
+#include <functional>
+#include <memory>
+
 class Worker
 {
     public:
@@ -40,53 +44,127 @@ class Worker
         MapUpdater& m_updater;
 };
 
+// Owned by MapManager and reused every tick, so scheduling a map update does not allocate
 class MapUpdateWorker : public Worker
 {
     public:
-        MapUpdateWorker(Map& map, uint32 diff, MapUpdater& updater) :
-            Worker(updater), m_map(map), m_diff(diff)
+        MapUpdateWorker(MapUpdater& updater) :
+            Worker(updater), m_map(nullptr), m_diff(0)
         {}
 
+        void Reset(Map& map, uint32 diff)
+        {
+            m_map = &map;
+            m_diff = diff;
+        }
+
         void execute() override
         {
-            m_map.Update(m_diff);
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            m_map->Update(m_diff);
+            m_map->SetUpdateCost(uint32(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count()));
+
             GetWorker().update_finished();
         }
 
     private:
-        Map& m_map;
+        Map* m_map;
         uint32 m_diff;
 };
 
+// Jobs shared between the thread that owns them and the updater threads helping out.
+// Every job is claimed exactly once, so the owning thread can always finish the batch alone.
+class WorkerBatch
+{
+    public:
+        WorkerBatch(size_t count, std::function<void(size_t)> job) :
+            m_count(count), m_job(std::move(job)), m_next(0), m_finished(0)
+        {}
+
+        bool ProcessNext()
+        {
+            // late helpers must not touch the job, its data is gone once the owner returned
+            size_t index = m_next++;
+            if (index >= m_count)
+                return false;
+
+            m_job(index);
+
+            std::lock_guard<std::mutex> lock(m_lock);
+            if (++m_finished == m_count)
+                m_condition.notify_all();
+            return true;
+        }
+
+        void Wait()
+        {
+            std::unique_lock<std::mutex> lock(m_lock);
+
+            while (m_finished < m_count)
+                m_condition.wait(lock);
+        }
+
+        // processes all jobs on the calling thread and any updater thread that becomes free meanwhile
+        static void Run(MapUpdater& updater, size_t count, std::function<void(size_t)> job);
+
+    private:
+        size_t m_count;
+        std::function<void(size_t)> m_job;
+        std::atomic<size_t> m_next;
+
+        std::mutex m_lock;
+        std::condition_variable m_condition;
+        size_t m_finished;
+};
+
 class GridCrawler : public Worker
 {
     public:
-        GridCrawler(Map& map, std::vector<Cell> &cells, uint32 diff, MapUpdater& updater) :
-            Worker(updater), m_map(map), m_cells(cells), m_diff(diff)
+        GridCrawler(std::shared_ptr<WorkerBatch> batch, MapUpdater& updater) :
+            Worker(updater), m_batch(std::move(batch))
         {}
 
         void execute() override
         {
-            WorldObjectUnSet objToUpdate;
-            MaNGOS::ObjectUpdater obj_updater(objToUpdate, m_diff);
-            TypeContainerVisitor<MaNGOS::ObjectUpdater, GridTypeMapContainer  > grid_object_update(obj_updater);    // For creature
-            TypeContainerVisitor<MaNGOS::ObjectUpdater, WorldTypeMapContainer > world_object_update(obj_updater);   // For pets
-
-            for (auto &cell : m_cells)
-            {
-                m_map.Visit(cell, grid_object_update);
-                m_map.Visit(cell, world_object_update);
-            }
+            while (m_batch->ProcessNext()) {}
 
             GetWorker().update_finished();
         }
 
     private:
-        Map& m_map;
-        std::vector<Cell> &m_cells;
-        uint32 m_diff;
+        std::shared_ptr<WorkerBatch> m_batch;
 };
 
+inline void WorkerBatch::Run(MapUpdater& updater, size_t count, std::function<void(size_t)> job)
+{
+    auto batch = std::make_shared<WorkerBatch>(count, std::move(job));
+
+    // calling thread takes jobs itself too, so crawlers that start late just find nothing left to do
+    for (size_t i = 1; i < count; ++i)
+        updater.schedule_update(new GridCrawler(batch, updater));
+
+    while (batch->ProcessNext()) {}
+    batch->Wait();
+}
+
+// Runs world tick work that does not touch map state on the updater threads, next to the map updates
+class WorldTaskWorker : public Worker
+{
+    public:
+        WorldTaskWorker(std::function<void()> task, MapUpdater& updater) :
+            Worker(updater), m_task(std::move(task))
+        {}
+
+        void execute() override
+        {
+            m_task();
+
+            GetWorker().update_finished();
+        }
+
+    private:
+        std::function<void()> m_task;
+};
 
 class ObjectUpdateWorker : public Worker
 {
@@ -22,6 +22,11 @@
 #include "MotionGenerators/MoveMap.h"
 #include "MoveMapSharedDefines.h"
 
+#include <algorithm>
+
+// upper bound of tiles read ahead but not yet requested by a grid load
+#define MMAP_MAX_PREFETCHED_TILES 64
+
 namespace MMAP
 {
     // ######################## MMapFactory ########################
@@ -118,6 +123,16 @@ namespace MMAP
     // ######################## MMapManager ########################
     MMapManager::~MMapManager()
     {
+        if (m_prefetchThread.joinable())
+        {
+            {
+                std::lock_guard<std::mutex> guard(m_prefetchLock);
+                m_prefetchStop = true;
+            }
+            m_prefetchCondition.notify_all();
+            m_prefetchThread.join();
+        }
+
         for (auto& loadedMMap : loadedMMaps)
             delete loadedMMap.second;
 
@@ -165,7 +180,7 @@ namespace MMAP
         DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "MMAP:loadMapData: Loaded %03i.mmap", mapId);
 
         // store inside our map list
-        MMapData* mmap_data = new MMapData(mesh);
+        MMapData* mmap_data = new MMapData(mesh, ++m_tileGeneration);
         mmap_data->mmapLoadedTiles.clear();
 
         loadedMMaps.insert(std::pair<uint32, MMapData*>(mapId, mmap_data));
@@ -212,11 +227,81 @@ namespace MMAP
             return false;
         }
 
+        MMapTileData tile;
+        if (!takePrefetchedTile(mapId, packedGridPos, tile) && !readTile(mapId, x, y, tile, false))
+            return false;
+
+        dtMeshHeader* header = (dtMeshHeader*)tile.data;
+        dtTileRef tileRef = 0;
+
+        // memory read into the heap is now managed by detour, and will be deallocated when the tile is removed
+        // a mapped file has to outlive the tile instead, detour writes the tile links into it
+        dtStatus dtResult = mmap->navMesh->addTile(tile.data, tile.size, tile.file ? 0 : DT_TILE_FREE_DATA, 0, &tileRef);
+        if (dtStatusFailed(dtResult))
+        {
+            sLog.outError("MMAP:loadMap: Could not load %03u%02i%02i.mmtile into navmesh", mapId, x, y);
+            return false;
+        }
+
+        if (tile.file)
+            mmap->mmapTileFiles[packedGridPos] = std::move(tile.file);
+        else
+            tile.data = nullptr;
+
+        mmap->mmapLoadedTiles.insert(std::pair<uint32, dtTileRef>(packedGridPos, tileRef));
+        mmap->tileGeneration = ++m_tileGeneration;
+        ++loadedTiles;
+        DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "MMAP:loadMap: Loaded mmtile %03i[%02i,%02i] into %03i[%02i,%02i]", mapId, x, y, mapId, header->x, header->y);
+        return true;
+    }
+
+    bool MMapManager::readTile(uint32 mapId, int32 x, int32 y, MMapTileData& tile, bool preload) const
+    {
         // load this tile :: mmaps/MMMXXYY.mmtile
         uint32 pathLen = sWorld.GetDataPath().length() + strlen("mmaps/%03i%02i%02i.mmtile") + 1;
         char* fileName = new char[pathLen];
         snprintf(fileName, pathLen, (sWorld.GetDataPath() + "mmaps/%03i%02i%02i.mmtile").c_str(), mapId, x, y);
 
+        if (sWorld.getConfig(CONFIG_BOOL_MMAP_MEMORY_MAPPED))
+        {
+            std::unique_ptr<MappedFile> file(new MappedFile());
+            if (!file->Open(fileName, true))
+            {
+                DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "ERROR: MMAP:loadMap: Could not map mmtile file '%s'", fileName);
+                delete[] fileName;
+                return false;
+            }
+            delete[] fileName;
+
+            MmapTileHeader const* fileHeader = reinterpret_cast<MmapTileHeader const*>(file->GetData());
+            if (file->GetSize() < sizeof(MmapTileHeader) || fileHeader->mmapMagic != MMAP_MAGIC)
+            {
+                sLog.outError("MMAP:loadMap: Bad header in mmap %03u%02i%02i.mmtile", mapId, x, y);
+                return false;
+            }
+
+            if (fileHeader->mmapVersion != MMAP_VERSION)
+            {
+                sLog.outError("MMAP:loadMap: %03u%02i%02i.mmtile was built with generator v%i, expected v%i",
+                              mapId, x, y, fileHeader->mmapVersion, MMAP_VERSION);
+                return false;
+            }
+
+            if (file->GetSize() - sizeof(MmapTileHeader) < fileHeader->size)
+            {
+                sLog.outError("MMAP:loadMap: Bad header or data in mmap %03u%02i%02i.mmtile", mapId, x, y);
+                return false;
+            }
+
+            if (preload)
+                file->Preload();
+
+            tile.size = fileHeader->size;
+            tile.data = file->GetWritableData() + sizeof(MmapTileHeader);
+            tile.file = std::move(file);
+            return true;
+        }
+
         FILE* file = fopen(fileName, "rb");
         if (!file)
         {
@@ -253,29 +338,86 @@ namespace MMAP
         {
             sLog.outError("MMAP:loadMap: Bad header or data in mmap %03u%02i%02i.mmtile", mapId, x, y);
             fclose(file);
+            dtFree(data);
             return false;
         }
 
         fclose(file);
 
-        dtMeshHeader* header = (dtMeshHeader*)data;
-        dtTileRef tileRef = 0;
+        tile.data = data;
+        tile.size = fileHeader.size;
+        return true;
+    }
+
+    void MMapManager::PrefetchTile(uint32 mapId, uint32 x, uint32 y)
+    {
+        PrefetchKey key(mapId, packTileID(x, y));
 
-        // memory allocated for data is now managed by detour, and will be deallocated when the tile is removed
-        dtStatus dtResult = mmap->navMesh->addTile(data, fileHeader.size, DT_TILE_FREE_DATA, 0, &tileRef);
-        if (dtStatusFailed(dtResult))
         {
-            sLog.outError("MMAP:loadMap: Could not load %03u%02i%02i.mmtile into navmesh", mapId, x, y);
-            dtFree(data);
-            return false;
+            std::lock_guard<std::mutex> guard(m_prefetchLock);
+            if (m_prefetchedTiles.find(key) != m_prefetchedTiles.end() ||
+                std::find(m_prefetchQueue.begin(), m_prefetchQueue.end(), key) != m_prefetchQueue.end())
+                return;
+
+            m_prefetchQueue.push_back(key);
+
+            if (!m_prefetchThread.joinable())
+                m_prefetchThread = std::thread(&MMapManager::prefetchWorker, this);
         }
 
-        mmap->mmapLoadedTiles.insert(std::pair<uint32, dtTileRef>(packedGridPos, tileRef));
-        ++loadedTiles;
-        DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "MMAP:loadMap: Loaded mmtile %03i[%02i,%02i] into %03i[%02i,%02i]", mapId, x, y, mapId, header->x, header->y);
+        m_prefetchCondition.notify_one();
+    }
+
+    bool MMapManager::takePrefetchedTile(uint32 mapId, uint32 packedGridPos, MMapTileData& tile)
+    {
+        std::lock_guard<std::mutex> guard(m_prefetchLock);
+
+        auto itr = m_prefetchedTiles.find(PrefetchKey(mapId, packedGridPos));
+        if (itr == m_prefetchedTiles.end())
+            return false;
+
+        tile = std::move(itr->second.tile);
+        m_prefetchedTiles.erase(itr);
         return true;
     }
 
+    void MMapManager::prefetchWorker()
+    {
+        std::unique_lock<std::mutex> lock(m_prefetchLock);
+
+        while (true)
+        {
+            m_prefetchCondition.wait(lock, [this] { return m_prefetchStop || !m_prefetchQueue.empty(); });
+            if (m_prefetchStop)
+                return;
+
+            PrefetchKey key = m_prefetchQueue.front();
+            m_prefetchQueue.pop_front();
+
+            lock.unlock();
+            MMapTileData tile;
+            bool read = readTile(key.first, int32(key.second >> 16), int32(key.second & 0x0000FFFF), tile, true);
+            lock.lock();
+
+            if (!read)
+                continue;
+
+            // tiles prefetched for grids that never got loaded must not pile up
+            if (m_prefetchedTiles.size() >= MMAP_MAX_PREFETCHED_TILES)
+            {
+                auto oldest = m_prefetchedTiles.begin();
+                for (auto itr = m_prefetchedTiles.begin(); itr != m_prefetchedTiles.end(); ++itr)
+                    if (itr->second.sequence < oldest->second.sequence)
+                        oldest = itr;
+                m_prefetchedTiles.erase(oldest);
+            }
+
+            PrefetchedTile& prefetched = m_prefetchedTiles[key];
+            prefetched.sequence = ++m_prefetchSequence;
+            prefetched.tile = std::move(tile);
+        }
+    }
+
     void MMapManager::loadAllGameObjectModels(std::vector<uint32> const& displayIds)
     {
         for (uint32 displayId : displayIds)
@@ -385,6 +527,8 @@ namespace MMAP
         else
         {
             mmap->mmapLoadedTiles.erase(packedGridPos);
+            mmap->mmapTileFiles.erase(packedGridPos);
+            mmap->tileGeneration = ++m_tileGeneration;
             --loadedTiles;
             DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "MMAP:unloadMap: Unloaded mmtile %03i[%02i,%02i] from %03i", mapId, x, y, mapId);
             return true;
@@ -493,6 +637,40 @@ namespace MMAP
         return mmap->navMeshQueries[instanceId];
     }
 
+    dtNavMeshQuery const* MMapManager::GetThreadNavMeshQuery(uint32 mapId)
+    {
+        auto itr = loadedMMaps.find(mapId);
+        if (itr == loadedMMaps.end())
+            return nullptr;
+
+        MMapData* mmap = itr->second;
+        auto threadId = std::this_thread::get_id();
+
+        std::lock_guard<std::mutex> guard(m_threadQueriesMutex);
+        auto queryItr = mmap->navMeshThreadQueries.find(threadId);
+        if (queryItr != mmap->navMeshThreadQueries.end())
+            return queryItr->second;
+
+        dtNavMeshQuery* query = dtAllocNavMeshQuery();
+        MANGOS_ASSERT(query);
+        if (dtStatusFailed(query->init(mmap->navMesh, 1024)))
+        {
+            dtFreeNavMeshQuery(query);
+            sLog.outError("MMAP:GetThreadNavMeshQuery: Failed to initialize dtNavMeshQuery for mapId %03u", mapId);
+            return nullptr;
+        }
+
+        DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "MMAP:GetThreadNavMeshQuery: created dtNavMeshQuery for mapId %03u", mapId);
+        mmap->navMeshThreadQueries.insert(std::pair<std::thread::id, dtNavMeshQuery*>(threadId, query));
+        return query;
+    }
+
+    uint32 MMapManager::GetTileGeneration(uint32 mapId) const
+    {
+        auto itr = loadedMMaps.find(mapId);
+        return itr != loadedMMaps.end() ? itr->second->tileGeneration.load() : 0;
+    }
+
     dtNavMeshQuery const* MMapManager::GetModelNavMeshQuery(uint32 displayId)
     {
         if (m_loadedModels.find(displayId) == m_loadedModels.end())
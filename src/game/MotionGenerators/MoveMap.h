@@ -23,7 +23,15 @@
 #include <Detour/Include/DetourAlloc.h>
 #include <Detour/Include/DetourNavMesh.h>
 #include <Detour/Include/DetourNavMeshQuery.h>
+#include "MappedFile.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
 #include <mutex>
+#include <thread>
 
 class Unit;
 
@@ -44,16 +52,45 @@ namespace MMAP
     typedef std::unordered_map<uint32, dtTileRef> MMapTileSet;
     typedef std::unordered_map<uint32, dtNavMeshQuery*> NavMeshQuerySet;
     typedef std::unordered_map<std::thread::id, dtNavMeshQuery*> NavMeshGOQuerySet;
+    typedef std::unordered_map<std::thread::id, dtNavMeshQuery*> NavMeshThreadQuerySet;
+    typedef std::unordered_map<uint32, std::unique_ptr<MappedFile>> MMapTileFileSet;
+
+    // contents of a .mmtile, either read into detour owned memory or pointing into a mapping of the file
+    struct MMapTileData
+    {
+        MMapTileData() : data(nullptr), size(0) {}
+        MMapTileData(MMapTileData&& other) : file(std::move(other.file)), data(other.data), size(other.size) { other.data = nullptr; }
+        ~MMapTileData()
+        {
+            if (data && !file)
+                dtFree(data);
+        }
+
+        MMapTileData& operator=(MMapTileData&& other)
+        {
+            std::swap(file, other.file);
+            std::swap(data, other.data);
+            std::swap(size, other.size);
+            return *this;
+        }
+
+        std::unique_ptr<MappedFile> file;
+        unsigned char* data;
+        uint32 size;
+    };
 
     // dummy struct to hold map's mmap data
     struct MMapData
     {
-        MMapData(dtNavMesh* mesh) : navMesh(mesh) {}
+        MMapData(dtNavMesh* mesh, uint32 generation) : navMesh(mesh), tileGeneration(generation) {}
         ~MMapData()
         {
             for (auto& navMeshQuerie : navMeshQueries)
                 dtFreeNavMeshQuery(navMeshQuerie.second);
 
+            for (auto& navMeshQuerie : navMeshThreadQueries)
+                dtFreeNavMeshQuery(navMeshQuerie.second);
+
             if (navMesh)
                 dtFreeNavMesh(navMesh);
         }
@@ -62,7 +99,12 @@ namespace MMAP
 
         // we have to use single dtNavMeshQuery for every instance, since those are not thread safe
         NavMeshQuerySet navMeshQueries;     // instanceId to query
+        NavMeshThreadQuerySet navMeshThreadQueries; // queries of threads computing queued path requests
         MMapTileSet mmapLoadedTiles;        // maps [map grid coords] to [dtTile]
+        MMapTileFileSet mmapTileFiles;      // mappings backing the tiles not owned by detour, released after the nav mesh
+
+        // changes whenever a tile is added or removed, poly refs cached for an older value may be stale
+        std::atomic<uint32> tileGeneration;
     };
 
     struct MMapGOData
@@ -91,7 +133,7 @@ namespace MMAP
     class MMapManager
     {
         public:
-            MMapManager() : loadedTiles(0) {}
+            MMapManager() : loadedTiles(0), m_tileGeneration(0), m_prefetchSequence(0), m_prefetchStop(false) {}
             ~MMapManager();
 
             bool loadMap(uint32 mapId, int32 x, int32 y);
@@ -102,9 +144,15 @@ namespace MMAP
             bool unloadMapInstance(uint32 mapId, uint32 instanceId);
             bool IsMMapIsLoaded(uint32 mapId, uint32 x, uint32 y) const;
 
+            // reads the tile in the background, so a later loadMap finds it in memory
+            void PrefetchTile(uint32 mapId, uint32 x, uint32 y);
+
             // the returned [dtNavMeshQuery const*] is NOT threadsafe
             dtNavMeshQuery const* GetNavMeshQuery(uint32 mapId, uint32 instanceId);
             dtNavMeshQuery const* GetModelNavMeshQuery(uint32 displayId);
+            // query owned by the calling thread, shared by all instances of the map
+            dtNavMeshQuery const* GetThreadNavMeshQuery(uint32 mapId);
+            uint32 GetTileGeneration(uint32 mapId) const;
             dtNavMesh const* GetNavMesh(uint32 mapId);
             dtNavMesh const* GetGONavMesh(uint32 displayId);
 
@@ -113,12 +161,34 @@ namespace MMAP
         private:
             bool loadMapData(uint32 mapId);
             uint32 packTileID(int32 x, int32 y) const;
+            bool readTile(uint32 mapId, int32 x, int32 y, MMapTileData& tile, bool preload) const;
+            bool takePrefetchedTile(uint32 mapId, uint32 packedGridPos, MMapTileData& tile);
+            void prefetchWorker();
 
             MMapDataSet loadedMMaps;
             uint32 loadedTiles;
 
             std::unordered_map<uint32, MMapGOData*> m_loadedModels;
             std::mutex m_modelsMutex;
+
+            std::mutex m_threadQueriesMutex;
+            std::atomic<uint32> m_tileGeneration;
+
+            typedef std::pair<uint32, uint32> PrefetchKey;  // map id, packed tile position
+
+            struct PrefetchedTile
+            {
+                uint32 sequence;                            // oldest ones are dropped first
+                MMapTileData tile;
+            };
+
+            std::thread m_prefetchThread;
+            std::mutex m_prefetchLock;
+            std::condition_variable m_prefetchCondition;
+            std::deque<PrefetchKey> m_prefetchQueue;
+            std::map<PrefetchKey, PrefetchedTile> m_prefetchedTiles;
+            uint32 m_prefetchSequence;
+            bool m_prefetchStop;
     };
 
     // static class
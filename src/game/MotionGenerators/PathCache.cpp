@@ -0,0 +1,105 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "MotionGenerators/PathCache.h"
+#include "Policies/Singleton.h"
+
+INSTANTIATE_SINGLETON_1(PathCache);
+
+size_t PathCache::KeyHash::operator()(Key const& key) const
+{
+    size_t hash = std::hash<uintptr_t>()(reinterpret_cast<uintptr_t>(key.navMesh));
+    hash = hash * 31 + std::hash<uint64>()(key.startPoly);
+    hash = hash * 31 + std::hash<uint64>()(key.endPoly);
+    hash = hash * 31 + ((size_t(key.includeFlags) << 16) | key.excludeFlags);
+    return hash * 31 + key.maxPathSize;
+}
+
+void PathCache::SetCapacity(uint32 capacity)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    m_capacity = capacity;
+
+    while (m_entries.size() > capacity)
+    {
+        m_index.erase(m_entries.back().key);
+        m_entries.pop_back();
+    }
+}
+
+bool PathCache::Find(Key const& key, uint32 generation, dtPolyRef* path, uint32& pathSize)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    auto itr = m_index.find(key);
+    if (itr == m_index.end())
+    {
+        ++m_misses;
+        return false;
+    }
+
+    EntryList::iterator entry = itr->second;
+    if (entry->generation != generation)
+    {
+        // tiles were added or removed since, the corridor may reference polygons that are gone
+        m_entries.erase(entry);
+        m_index.erase(itr);
+        ++m_misses;
+        return false;
+    }
+
+    m_entries.splice(m_entries.begin(), m_entries, entry);
+
+    pathSize = uint32(entry->path.size());
+    memcpy(path, entry->path.data(), pathSize * sizeof(dtPolyRef));
+    ++m_hits;
+    return true;
+}
+
+void PathCache::Store(Key const& key, uint32 generation, dtPolyRef const* path, uint32 pathSize)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    if (!m_capacity)
+        return;
+
+    auto itr = m_index.find(key);
+    if (itr != m_index.end())
+    {
+        m_entries.splice(m_entries.begin(), m_entries, itr->second);
+        itr->second->generation = generation;
+        itr->second->path.assign(path, path + pathSize);
+        return;
+    }
+
+    if (m_entries.size() >= m_capacity)
+    {
+        m_index.erase(m_entries.back().key);
+        m_entries.pop_back();
+    }
+
+    m_entries.push_front(Entry{ key, generation, std::vector<dtPolyRef>(path, path + pathSize) });
+    m_index.emplace(key, m_entries.begin());
+}
+
+PathCache::Stats PathCache::ConsumeStats()
+{
+    Stats stats;
+    stats.hits = m_hits.exchange(0);
+    stats.misses = m_misses.exchange(0);
+    return stats;
+}
@@ -0,0 +1,97 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_PATH_CACHE_H
+#define MANGOS_PATH_CACHE_H
+
+#include "Common.h"
+#include "Policies/Singleton.h"
+
+#include <Detour/Include/DetourNavMesh.h>
+
+#include <atomic>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+// Least recently used set of poly corridors found by dtNavMeshQuery::findPath, shared by all maps.
+// Repeated repaths between the same start and end polygon reuse the corridor and only rebuild the point path.
+class PathCache
+{
+    public:
+        struct Key
+        {
+            dtNavMesh const* navMesh;
+            dtPolyRef startPoly;
+            dtPolyRef endPoly;
+            uint16 includeFlags;
+            uint16 excludeFlags;
+            uint32 maxPathSize;
+
+            bool operator==(Key const& other) const
+            {
+                return navMesh == other.navMesh && startPoly == other.startPoly && endPoly == other.endPoly &&
+                       includeFlags == other.includeFlags && excludeFlags == other.excludeFlags && maxPathSize == other.maxPathSize;
+            }
+        };
+
+        struct Stats
+        {
+            uint64 hits;
+            uint64 misses;
+        };
+
+        PathCache() : m_capacity(0), m_hits(0), m_misses(0) {}
+
+        void SetCapacity(uint32 capacity);
+        bool IsEnabled() const { return m_capacity != 0; }
+
+        // generation is the tile generation of the nav mesh, entries stored for another one are dropped
+        bool Find(Key const& key, uint32 generation, dtPolyRef* path, uint32& pathSize);
+        void Store(Key const& key, uint32 generation, dtPolyRef const* path, uint32 pathSize);
+
+        Stats ConsumeStats();
+
+    private:
+        struct KeyHash
+        {
+            size_t operator()(Key const& key) const;
+        };
+
+        struct Entry
+        {
+            Key key;
+            uint32 generation;
+            std::vector<dtPolyRef> path;
+        };
+
+        typedef std::list<Entry> EntryList;
+
+        std::mutex m_lock;
+        EntryList m_entries;                                // most recently used first
+        std::unordered_map<Key, EntryList::iterator, KeyHash> m_index;
+        std::atomic<uint32> m_capacity;
+
+        std::atomic<uint64> m_hits;
+        std::atomic<uint64> m_misses;
+};
+
+#define sPathCache MaNGOS::Singleton<PathCache>::Instance()
+
+#endif
@@ -20,6 +20,8 @@
 #include "Maps/GridMap.h"
 #include "Entities/Creature.h"
 #include "MotionGenerators/PathFinder.h"
+#include "MotionGenerators/PathCache.h"
+#include "MotionGenerators/PathRequestQueue.h"
 #include "Log.h"
 #include "World/World.h"
 #include "Metric/Metric.h"
@@ -33,7 +35,8 @@
 PathFinder::PathFinder(Unit const* owner) :
     m_polyLength(0), m_type(PATHFIND_BLANK),
     m_useStraightPath(false), m_forceDestination(false), m_straightLine(false), m_pointPathLimit(MAX_POINT_PATH_LENGTH), // TODO: Fix legitimate long paths
-    m_sourceUnit(owner), m_navMesh(nullptr), m_navMeshQuery(nullptr), m_cachedPoints(m_pointPathLimit * VERTEX_SIZE), m_pathPolyRefs(m_pointPathLimit), m_smoothPathPolyRefs(m_pointPathLimit), m_defaultMapId(m_sourceUnit->GetMapId())
+    m_sourceUnit(owner), m_navMesh(nullptr), m_navMeshQuery(nullptr), m_cachedPoints(m_pointPathLimit * VERTEX_SIZE), m_pathPolyRefs(m_pointPathLimit), m_smoothPathPolyRefs(m_pointPathLimit), m_defaultMapId(m_sourceUnit->GetMapId()),
+    m_pendingQueue(nullptr), m_threadQuery(false)
 {
     DEBUG_FILTER_LOG(LOG_FILTER_PATHFINDING, "++ PathFinder::PathInfo for %u \n", m_sourceUnit->GetGUIDLow());
 
@@ -49,6 +52,26 @@ PathFinder::PathFinder(Unit const* owner) :
 PathFinder::~PathFinder()
 {
     DEBUG_FILTER_LOG(LOG_FILTER_PATHFINDING, "++ PathFinder::~PathInfo() for %u \n", m_sourceUnit->GetGUIDLow());
+
+    cancelRequest();
+}
+
+void PathFinder::calculateAsync(std::function<void(PathFinder&)> work)
+{
+    if (!sWorld.getConfig(CONFIG_BOOL_PATH_FIND_ASYNC) || !m_sourceUnit->IsInWorld())
+    {
+        cancelRequest();
+        work(*this);
+        return;
+    }
+
+    m_sourceUnit->GetMap()->GetPathRequestQueue().Submit(*this, std::move(work));
+}
+
+void PathFinder::cancelRequest()
+{
+    if (m_pendingQueue)
+        m_pendingQueue->Cancel(*this);
 }
 
 void PathFinder::SetCurrentNavMesh()
@@ -60,10 +83,15 @@ void PathFinder::SetCurrentNavMesh()
             m_navMeshQuery = mmap->GetModelNavMeshQuery(transport->GetDisplayId());
         else
         {
-            if (m_defaultMapId != m_sourceUnit->GetMapId())
-                m_defaultNavMeshQuery = mmap->GetNavMeshQuery(m_sourceUnit->GetMapId(), m_sourceUnit->GetInstanceId());
+            if (m_threadQuery)
+                m_navMeshQuery = mmap->GetThreadNavMeshQuery(m_sourceUnit->GetMapId());
+            else
+            {
+                if (m_defaultMapId != m_sourceUnit->GetMapId())
+                    m_defaultNavMeshQuery = mmap->GetNavMeshQuery(m_sourceUnit->GetMapId(), m_sourceUnit->GetInstanceId());
 
-            m_navMeshQuery = m_defaultNavMeshQuery;
+                m_navMeshQuery = m_defaultNavMeshQuery;
+            }
         }
 
         if (m_navMeshQuery)
@@ -454,15 +482,28 @@ void PathFinder::BuildPolyPath(const Vector3& startPos, const Vector3& endPos)
 
         if (!m_straightLine)
         {
-            dtResult = m_navMeshQuery->findPath(
-                    startPoly,          // start polygon
-                    endPoly,            // end polygon
-                    startPoint,         // start position
-                    endPoint,           // end position
-                    &m_filter,          // polygon search filter
-                    m_pathPolyRefs.data(), // [out] path
-                    (int*)&m_polyLength,
-                    m_pointPathLimit);   // max number of polygons in output path
+            // corridors on transports are found on the model mesh, not worth caching
+            bool useCache = sPathCache.IsEnabled() && !m_sourceUnit->GetTransport();
+            PathCache::Key cacheKey = { m_navMesh, startPoly, endPoly, m_filter.getIncludeFlags(), m_filter.getExcludeFlags(), m_pointPathLimit };
+            uint32 tileGeneration = useCache ? MMAP::MMapFactory::createOrGetMMapManager()->GetTileGeneration(m_sourceUnit->GetMapId()) : 0;
+
+            if (useCache && sPathCache.Find(cacheKey, tileGeneration, m_pathPolyRefs.data(), m_polyLength))
+                dtResult = DT_SUCCESS;
+            else
+            {
+                dtResult = m_navMeshQuery->findPath(
+                        startPoly,          // start polygon
+                        endPoly,            // end polygon
+                        startPoint,         // start position
+                        endPoint,           // end position
+                        &m_filter,          // polygon search filter
+                        m_pathPolyRefs.data(), // [out] path
+                        (int*)&m_polyLength,
+                        m_pointPathLimit);   // max number of polygons in output path
+
+                if (useCache && m_polyLength && dtStatusSucceed(dtResult))
+                    sPathCache.Store(cacheKey, tileGeneration, m_pathPolyRefs.data(), m_polyLength);
+            }
         }
         else
         {
@@ -26,10 +26,13 @@
 
 #include "Movement/MoveSplineInitArgs.h"
 
+#include <functional>
+
 using Movement::Vector3;
 using Movement::PointsArray;
 
 class Unit;
+class PathRequestQueue;
 
 // 74*4.0f=296y  number_of_points*interval = max_path_len
 // this is way more than actual evade range
@@ -71,6 +74,13 @@ class PathFinder
         bool calculate(float destX, float destY, float destZ, bool forceDest = false, bool straightLine = false); // transfers coorddinates from global to local space if on transport - use other func if coords are already in transport space
         bool calculate(Vector3 const& start, Vector3 const& dest, bool forceDest = false, bool straightLine = false);
 
+        // Queue work that calculates this path on the map's next path request pass, possibly on a worker thread.
+        // The work runs with a nav mesh query owned by the executing thread and must not touch other objects.
+        // Falls back to running the work immediately when asynchronous pathfinding is disabled.
+        void calculateAsync(std::function<void(PathFinder&)> work);
+        bool isPending() const { return m_pendingQueue != nullptr; }
+        void cancelRequest();
+
         // option setters - use optional
         void setUseStrightPath(bool useStraightPath) { m_useStraightPath = useStraightPath; };
         void setPathLengthLimit(float distance) { m_pointPathLimit = std::min<uint32>(uint32(distance / SMOOTH_PATH_STEP_SIZE * 1.25f), MAX_POINT_PATH_LENGTH); };
@@ -84,8 +94,7 @@ class PathFinder
         PathType getPathType() const { return m_type; }
 
     private:
-
-
+        friend class PathRequestQueue;
 
         PointsArray    m_pathPoints;       // our actual (x,y,z) path to the target
         PathType       m_type;             // tells what kind of path this is
@@ -113,6 +122,9 @@ class PathFinder
 
         dtQueryFilter m_filter;                     // use single filter for all movements, update it when needed
 
+        PathRequestQueue*       m_pendingQueue;     // queue holding our not yet calculated request
+        bool                    m_threadQuery;      // calculating on a path request worker, use the thread's query
+
         void setStartPosition(const Vector3& point) { m_startPosition = point; }
         void setEndPosition(const Vector3& point) { m_actualEndPosition = point; m_endPosition = point; }
         void setActualEndPosition(const Vector3& point) { m_actualEndPosition = point; }
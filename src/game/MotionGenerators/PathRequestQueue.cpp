@@ -0,0 +1,113 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "MotionGenerators/PathRequestQueue.h"
+#include "MotionGenerators/PathFinder.h"
+#include "Entities/Unit.h"
+#include "Maps/Map.h"
+#include "Maps/MapManager.h"
+#include "Maps/MapWorkers.h"
+
+PathRequestQueue::~PathRequestQueue()
+{
+    for (auto& request : m_requests)
+        request.path->m_pendingQueue = nullptr;
+}
+
+void PathRequestQueue::Submit(PathFinder& path, Work work)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    if (path.m_pendingQueue == this)
+    {
+        for (auto& request : m_requests)
+        {
+            if (request.path == &path)
+            {
+                request.work = std::move(work);
+                return;
+            }
+        }
+    }
+
+    path.m_pendingQueue = this;
+    m_requests.push_back({ &path, std::move(work) });
+}
+
+void PathRequestQueue::Cancel(PathFinder& path)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    for (auto itr = m_requests.begin(); itr != m_requests.end(); ++itr)
+    {
+        if (itr->path == &path)
+        {
+            m_requests.erase(itr);
+            break;
+        }
+    }
+
+    path.m_pendingQueue = nullptr;
+}
+
+void PathRequestQueue::Process()
+{
+    std::vector<Request> requests;
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        requests.swap(m_requests);
+    }
+
+    if (requests.empty())
+        return;
+
+    // owner left the map since submitting, it will not pick the result up here
+    for (auto itr = requests.begin(); itr != requests.end();)
+    {
+        Unit const* owner = itr->path->m_sourceUnit;
+        if (owner->IsInWorld() && owner->GetMap() == &m_map)
+        {
+            ++itr;
+            continue;
+        }
+
+        itr->path->m_pendingQueue = nullptr;
+        itr->path->clear();
+        itr->path->m_type = PATHFIND_NOPATH;
+        itr = requests.erase(itr);
+    }
+
+    auto job = [&requests](size_t index)
+    {
+        PathFinder& path = *requests[index].path;
+        path.m_threadQuery = true;
+        requests[index].work(path);
+        path.m_threadQuery = false;
+    };
+
+    if (requests.size() > 1 && sMapMgr.GetUpdater().activated())
+        WorkerBatch::Run(sMapMgr.GetUpdater(), requests.size(), job);
+    else
+    {
+        for (size_t i = 0; i < requests.size(); ++i)
+            job(i);
+    }
+
+    for (auto& request : requests)
+        request.path->m_pendingQueue = nullptr;
+}
@@ -0,0 +1,60 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_PATH_REQUEST_QUEUE_H
+#define MANGOS_PATH_REQUEST_QUEUE_H
+
+#include "Common.h"
+
+#include <functional>
+#include <mutex>
+#include <vector>
+
+class Map;
+class PathFinder;
+
+// Path calculations requested by the movement generators of one map during its object update.
+// They are run together once the objects are updated, spread over the free map updater threads.
+class PathRequestQueue
+{
+    public:
+        typedef std::function<void(PathFinder&)> Work;
+
+        explicit PathRequestQueue(Map& map) : m_map(map) {}
+        ~PathRequestQueue();
+
+        // a newer request for the same path replaces the queued one
+        void Submit(PathFinder& path, Work work);
+        void Cancel(PathFinder& path);
+
+        void Process();
+
+    private:
+        struct Request
+        {
+            PathFinder* path;
+            Work work;
+        };
+
+        Map& m_map;
+
+        std::mutex m_lock;                                  // movement generators submit from parallel update regions
+        std::vector<Request> m_requests;
+};
+
+#endif
@@ -21,6 +21,12 @@
 #include "Movement/MoveSplineInit.h"
 #include "Movement/MoveSpline.h"
 #include "MotionGenerators/RandomMovementGenerator.h"
+#include "MotionGenerators/PathFinder.h"
+#include "World/World.h"
+
+AbstractRandomMovementGenerator::~AbstractRandomMovementGenerator()
+{
+}
 
 void AbstractRandomMovementGenerator::Initialize(Unit& owner)
 {
@@ -48,6 +54,8 @@ void AbstractRandomMovementGenerator::Initialize(Unit& owner)
 
 void AbstractRandomMovementGenerator::Finalize(Unit& owner)
 {
+    _cancelPendingPath();
+
     owner.clearUnitState(i_stateActive | i_stateMotion);
 
     // Client-controlled unit should have control restored
@@ -66,6 +74,8 @@ void AbstractRandomMovementGenerator::Finalize(Unit& owner)
 
 void AbstractRandomMovementGenerator::Interrupt(Unit& owner)
 {
+    _cancelPendingPath();
+
     owner.InterruptMoving();
 
     owner.clearUnitState(i_stateMotion);
@@ -85,6 +95,7 @@ bool AbstractRandomMovementGenerator::Update(Unit& owner, const uint32& diff)
 
     if (owner.hasUnitState(UNIT_STAT_NO_FREE_MOVE & ~i_stateActive))
     {
+        _cancelPendingPath();
         i_nextMoveTimer.Update(diff);
         owner.clearUnitState(i_stateMotion);
         return true;
@@ -92,28 +103,55 @@ bool AbstractRandomMovementGenerator::Update(Unit& owner, const uint32& diff)
 
     if (owner.movespline->Finalized())
     {
+        if (i_pathPending)
+        {
+            // path requested on a previous update, calculated after that map object update
+            if (!i_path->isPending())
+            {
+                i_pathPending = false;
+                _scheduleNextMove(owner, _launchPath(owner, *i_path));
+            }
+            return true;
+        }
+
         i_nextMoveTimer.Update(diff);
 
         if (i_nextMoveTimer.Passed())
         {
-            if (_setLocation(owner))
-            {
-                if (i_nextMoveCount > 1)
-                    --i_nextMoveCount;
-                else
-                {
-                    i_nextMoveCount = urand(1, i_nextMoveCountMax);
-                    i_nextMoveTimer.Reset(urand(i_nextMoveDelayMin, i_nextMoveDelayMax));
-                }
-            }
-            else
-                i_nextMoveTimer.Reset(owner.HasFlag(UNIT_FIELD_FLAGS, UNIT_FLAG_PLAYER_CONTROLLED) ? 100 : 500);
+            int32 duration = _setLocation(owner);
+            if (!i_pathPending)
+                _scheduleNextMove(owner, duration);
         }
     }
 
     return true;
 }
 
+void AbstractRandomMovementGenerator::_scheduleNextMove(Unit& owner, int32 duration)
+{
+    if (duration)
+    {
+        if (i_nextMoveCount > 1)
+            --i_nextMoveCount;
+        else
+        {
+            i_nextMoveCount = urand(1, i_nextMoveCountMax);
+            i_nextMoveTimer.Reset(urand(i_nextMoveDelayMin, i_nextMoveDelayMax));
+        }
+    }
+    else
+        i_nextMoveTimer.Reset(owner.HasFlag(UNIT_FIELD_FLAGS, UNIT_FLAG_PLAYER_CONTROLLED) ? 100 : 500);
+}
+
+void AbstractRandomMovementGenerator::_cancelPendingPath()
+{
+    if (!i_pathPending)
+        return;
+
+    i_path->cancelRequest();
+    i_pathPending = false;
+}
+
 bool AbstractRandomMovementGenerator::_getLocation(Unit& owner, float& x, float& y, float& z)
 {
     return owner.GetMap()->GetReachableRandomPosition(&owner, x, y, z, i_radius);
@@ -127,6 +165,23 @@ int32 AbstractRandomMovementGenerator::_setLocation(Unit& owner)
     if (!_getLocation(owner, x, y, z))
         return 0;
 
+    if (sWorld.getConfig(CONFIG_BOOL_PATH_FIND_ASYNC))
+    {
+        if (!i_path)
+        {
+            i_path.reset(new PathFinder(&owner));
+            if (i_pathLength != 0.0f)
+                i_path->setPathLengthLimit(i_pathLength);
+        }
+
+        i_path->calculateAsync([x, y, z](PathFinder& path) { path.calculate(x, y, z); });
+        i_pathPending = i_path->isPending();
+        if (i_pathPending)
+            return 0;
+
+        return _launchPath(owner, *i_path);
+    }
+
     PathFinder pf(&owner);
 
     if (i_pathLength != 0.0f)
@@ -134,11 +189,16 @@ int32 AbstractRandomMovementGenerator::_setLocation(Unit& owner)
 
     pf.calculate(x, y, z);
 
-    if (pf.getPathType() & PATHFIND_NOPATH)
+    return _launchPath(owner, pf);
+}
+
+int32 AbstractRandomMovementGenerator::_launchPath(Unit& owner, PathFinder& path)
+{
+    if (path.getPathType() & PATHFIND_NOPATH)
         return 0;
 
     Movement::MoveSplineInit init(owner);
-    init.MovebyPath(pf.getPath());
+    init.MovebyPath(path.getPath());
     init.SetWalk(i_walk);
 
     int32 duration = init.Launch();
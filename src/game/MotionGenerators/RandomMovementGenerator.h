@@ -22,6 +22,10 @@
 #include "MotionGenerators/MovementGenerator.h"
 #include "Entities/ObjectGuid.h"
 
+#include <memory>
+
+class PathFinder;
+
 class AbstractRandomMovementGenerator : public MovementGenerator
 {
     public:
@@ -29,9 +33,10 @@ class AbstractRandomMovementGenerator : public MovementGenerator
             i_x(0.0f), i_y(0.0f), i_z(0.0f), i_radius(0.0f), i_verticalZ(0.0f), i_pathLength(0.0f), i_walk(true),
             i_nextMoveTimer(0), i_nextMoveCount(1), i_nextMoveCountMax(movesMax),
             i_nextMoveDelayMin(delayMin), i_nextMoveDelayMax(delayMax),
-            i_stateActive(stateActive), i_stateMotion(stateMotion)
+            i_stateActive(stateActive), i_stateMotion(stateMotion), i_pathPending(false)
         {
         }
+        ~AbstractRandomMovementGenerator();
 
         void Initialize(Unit& owner) override;
         void Finalize(Unit& owner) override;
@@ -42,6 +47,9 @@ class AbstractRandomMovementGenerator : public MovementGenerator
     protected:
         virtual bool _getLocation(Unit& owner, float& x, float& y, float& z);
         virtual int32 _setLocation(Unit& owner);
+        int32 _launchPath(Unit& owner, PathFinder& path);
+        void _scheduleNextMove(Unit& owner, int32 duration);
+        void _cancelPendingPath();
 
         float i_x, i_y, i_z;
         float i_radius;
@@ -52,6 +60,9 @@ class AbstractRandomMovementGenerator : public MovementGenerator
         uint32 i_nextMoveCount, i_nextMoveCountMax;
         uint32 i_nextMoveDelayMin, i_nextMoveDelayMax;
         uint32 i_stateActive, i_stateMotion;
+
+        std::unique_ptr<PathFinder> i_path;                 // kept while the path is calculated asynchronously
+        bool i_pathPending;
 };
 
 class ConfusedMovementGenerator : public AbstractRandomMovementGenerator
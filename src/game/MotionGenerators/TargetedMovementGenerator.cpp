@@ -144,6 +144,7 @@ void ChaseMovementGenerator::Initialize(Unit& owner)
 
 void ChaseMovementGenerator::Finalize(Unit& owner)
 {
+    CancelPendingDispatch();
     owner.clearUnitState(UNIT_STAT_CHASE | UNIT_STAT_CHASE_MOVE);
     if (m_currentMode == CHASE_MODE_DISTANCING) // cleanup in case fanning was removed
         owner.AI()->DistancingEnded();
@@ -151,6 +152,7 @@ void ChaseMovementGenerator::Finalize(Unit& owner)
 
 void ChaseMovementGenerator::Interrupt(Unit& owner)
 {
+    CancelPendingDispatch();
     owner.InterruptMoving();
     owner.clearUnitState(UNIT_STAT_CHASE_MOVE);
     if (m_currentMode == CHASE_MODE_DISTANCING)
@@ -228,6 +230,21 @@ void ChaseMovementGenerator::HandleTargetedMovement(Unit& owner, const uint32& t
         }
         else m_closenessAndFanningTimer -= time_diff;
     }
+
+    if (m_dispatchPending)
+    {
+        // repath requested on a previous update, calculated after that map object update
+        if (this->i_path->isPending())
+            return;
+
+        m_dispatchPending = false;
+        if (LaunchSpline(owner, m_pendingWalk, true, true))
+            HandleTargetDispatched(owner);
+        else
+            HandleTargetUnreachable(owner);
+        return;
+    }
+
     if (!this->i_recheckDistance.Passed())
         return;
 
@@ -261,31 +278,26 @@ void ChaseMovementGenerator::HandleTargetedMovement(Unit& owner, const uint32& t
 
             if (owner.GetDistance(x, y, z, DIST_CALC_NONE) > 0.3f)
             {
-                if (DispatchSplineToPosition(owner, x, y, z, EnableWalking(), true, true))
+                if (sWorld.getConfig(CONFIG_BOOL_PATH_FIND_ASYNC) && !owner.IsDebuggingMovement())
+                {
+                    RequestSplineToTarget(owner, x, y, z, EnableWalking());
+                    if (m_dispatchPending)
+                        return;
+
+                    if (LaunchSpline(owner, EnableWalking(), true, true))
+                    {
+                        HandleTargetDispatched(owner);
+                        return;
+                    }
+                }
+                else if (DispatchSplineToPosition(owner, x, y, z, EnableWalking(), true, true))
                 {
-                    this->i_targetReached = false;
-                    this->i_speedChanged = false;
-                    /* m_prevTargetPos is updated on making new spline (normal and distancing) and also on reaching target
-                    is used for determining if player moved towards target whilst the spline was going on to stop the spline prematurely
-                    and prevent it going behind targets back - it will still occur in rare cases due to PF and lag */
-                    this->i_target->GetPosition(this->i_lastTargetPos.x, this->i_lastTargetPos.y, this->i_lastTargetPos.z, owner.GetTransport());
-                    m_closenessAndFanningTimer = 0;
+                    HandleTargetDispatched(owner);
                     return;
                 }
             }
             // if we arrived here something failed in PF dispatch and target is not reachable
-            if (this->i_offset == 0.f)
-            {
-                if (!owner.CanReachWithMeleeAttack(this->i_target.getTarget()))
-                    if (!i_target->IsFalling())
-                        m_reachable = false;
-            }
-            else
-            {
-                if (owner.GetDistance(this->i_target.getTarget(), true, DIST_CALC_COMBAT_REACH) > this->i_offset)
-                    if (!i_target->IsFalling())
-                        m_reachable = false;
-            }
+            HandleTargetUnreachable(owner);
             return;
         }
         else if (!targetMoved) // we do not need new position and we are reachable
@@ -343,6 +355,33 @@ void ChaseMovementGenerator::HandleTargetedMovement(Unit& owner, const uint32& t
     }
 }
 
+void ChaseMovementGenerator::HandleTargetDispatched(Unit& owner)
+{
+    this->i_targetReached = false;
+    this->i_speedChanged = false;
+    /* m_prevTargetPos is updated on making new spline (normal and distancing) and also on reaching target
+    is used for determining if player moved towards target whilst the spline was going on to stop the spline prematurely
+    and prevent it going behind targets back - it will still occur in rare cases due to PF and lag */
+    this->i_target->GetPosition(this->i_lastTargetPos.x, this->i_lastTargetPos.y, this->i_lastTargetPos.z, owner.GetTransport());
+    m_closenessAndFanningTimer = 0;
+}
+
+void ChaseMovementGenerator::HandleTargetUnreachable(Unit& owner)
+{
+    if (this->i_offset == 0.f)
+    {
+        if (!owner.CanReachWithMeleeAttack(this->i_target.getTarget()))
+            if (!i_target->IsFalling())
+                m_reachable = false;
+    }
+    else
+    {
+        if (owner.GetDistance(this->i_target.getTarget(), true, DIST_CALC_COMBAT_REACH) > this->i_offset)
+            if (!i_target->IsFalling())
+                m_reachable = false;
+    }
+}
+
 void ChaseMovementGenerator::HandleMovementFailure(Unit& owner)
 {
     if (m_currentMode == CHASE_MODE_DISTANCING)
@@ -472,8 +511,46 @@ void ChaseMovementGenerator::FanOut(Unit& owner)
     }
 }
 
+// Straight line when possible, falls back to a full navmesh path. Runs on path request workers too, so only touches the path.
+static bool CalculateChasePath(PathFinder& path, float x, float y, float z, bool tryStraight)
+{
+    if (tryStraight)
+    {
+        path.calculate(x, y, z, false, true);
+        if ((path.getPathType() & (PATHFIND_NOPATH | PATHFIND_INCOMPLETE)) == 0)
+        {
+            bool smooth = true;
+            if (sWorld.getConfig(CONFIG_BOOL_PATH_FIND_NORMALIZE_Z))
+            {
+                auto& points = path.getPath();
+                for (uint32 i = 0; i + 1 < points.size(); ++i)
+                {
+                    if (std::abs(points[i].z - points[i + 1].z) > 1.f)
+                    {
+                        smooth = false;
+                        break;
+                    }
+                }
+            }
+
+            if (smooth)
+                return true;
+        }
+    }
+
+    path.calculate(x, y, z);
+    return false;
+}
+
+bool ChaseMovementGenerator::CanUseStraightPath(Unit& owner, float x, float y, float z) const
+{
+    return owner.IsWithinDist3d(x, y, z, 200.f) && std::abs(owner.GetPositionZ() - z) < 5.f && owner.IsWithinLOS(x, y, z + i_target->GetCollisionHeight()) && !owner.IsInWater() && !i_target->IsInWater();
+}
+
 bool ChaseMovementGenerator::DispatchSplineToPosition(Unit& owner, float x, float y, float z, bool walk, bool cutPath, bool target)
 {
+    CancelPendingDispatch();
+
     if (owner.IsDebuggingMovement())
     {
         for (ObjectGuid guid : m_spawns)
@@ -496,24 +573,7 @@ bool ChaseMovementGenerator::DispatchSplineToPosition(Unit& owner, float x, floa
     if (!this->i_path)
         this->i_path = new PathFinder(&owner);
 
-    bool gen = false;
-    if (owner.IsWithinDist3d(x, y, z, 200.f) && std::abs(owner.GetPositionZ() - z) < 5.f && owner.IsWithinLOS(x, y, z + i_target->GetCollisionHeight()) && !owner.IsInWater() && !i_target->IsInWater())
-    {
-        this->i_path->calculate(x, y, z, false, true);
-        auto& path = this->i_path->getPath();
-        gen = true;
-        if (sWorld.getConfig(CONFIG_BOOL_PATH_FIND_NORMALIZE_Z) && (this->i_path->getPathType() & (PATHFIND_NOPATH | PATHFIND_INCOMPLETE)) == 0)
-        {
-            for (uint32 i = 0; i < path.size() - 1; ++i)
-            {
-                if (std::abs(path[i].z - path[i + 1].z) > 1.f)
-                {
-                    gen = false;
-                    break;
-                }
-            }
-        }
-    }
+    bool straight = CalculateChasePath(*this->i_path, x, y, z, CanUseStraightPath(owner, x, y, z));
 
     if (owner.IsDebuggingMovement())
     {
@@ -523,7 +583,7 @@ bool ChaseMovementGenerator::DispatchSplineToPosition(Unit& owner, float x, floa
             std::string message = "Start X: " + std::to_string(pos.x) + " Y: " + std::to_string(pos.y) + " Z: " + std::to_string(pos.z) + "\n";
             message += "End X: " + std::to_string(x) + " Y: " + std::to_string(y) + " Z: " + std::to_string(z) + "\n";
             message += (owner.IsWithinDist3d(x, y, z, 200.f) ? "Within 200f " : "") + std::string(owner.IsWithinLOS(x, y, z + i_target->GetCollisionHeight()) ? "Within LOS " : "") +
-                ((this->i_path->getPathType() & PATHFIND_NOPATH) ? " No straight path" : "") + "\n";
+                (!straight ? " No straight path" : "") + "\n";
             static_cast<Player*>(i_target.getTarget())->SendMessageToPlayer(message);
             std::ostringstream out;
             out.precision(10);
@@ -533,12 +593,40 @@ bool ChaseMovementGenerator::DispatchSplineToPosition(Unit& owner, float x, floa
         }
     }
 
-    if (!gen || (this->i_path->getPathType() & (PATHFIND_NOPATH | PATHFIND_INCOMPLETE)))
+    return LaunchSpline(owner, walk, cutPath, target);
+}
+
+void ChaseMovementGenerator::RequestSplineToTarget(Unit& owner, float x, float y, float z, bool walk)
+{
+    if (!owner.movespline->Finalized())
+        owner.UpdateSplinePosition();
+
+    if (!this->i_path)
+        this->i_path = new PathFinder(&owner);
+
+    bool tryStraight = CanUseStraightPath(owner, x, y, z);
+    this->i_path->calculateAsync([x, y, z, tryStraight](PathFinder& path)
     {
-        this->i_path->calculate(x, y, z);
-        if (this->i_path->getPathType() & PATHFIND_NOPATH)
-            return false;
-    }
+        CalculateChasePath(path, x, y, z, tryStraight);
+    });
+
+    m_dispatchPending = this->i_path->isPending();
+    m_pendingWalk = walk;
+}
+
+void ChaseMovementGenerator::CancelPendingDispatch()
+{
+    if (!m_dispatchPending)
+        return;
+
+    this->i_path->cancelRequest();
+    m_dispatchPending = false;
+}
+
+bool ChaseMovementGenerator::LaunchSpline(Unit& owner, bool walk, bool cutPath, bool target)
+{
+    if (this->i_path->getPathType() & PATHFIND_NOPATH)
+        return false;
 
     auto& path = this->i_path->getPath();
 
@@ -112,7 +112,8 @@ class ChaseMovementGenerator : public TargetedMovementGeneratorMedium<Unit, Chas
     public:
         ChaseMovementGenerator(Unit& target, float offset, float angle, bool moveFurther = true, bool walk = false, bool combat = true)
             : TargetedMovementGeneratorMedium<Unit, ChaseMovementGenerator >(target, offset, angle), m_moveFurther(moveFurther), m_walk(walk), m_combat(combat), m_currentMode(CHASE_MODE_NORMAL),
-              m_fanningEnabled(true), m_closenessAndFanningTimer(0), m_closenessExpired(false), m_reachable(true) {}
+              m_fanningEnabled(true), m_closenessAndFanningTimer(0), m_closenessExpired(false), m_reachable(true),
+              m_dispatchPending(false), m_pendingWalk(false) {}
         ~ChaseMovementGenerator() {}
 
         MovementGeneratorType GetMovementGeneratorType() const override { return CHASE_MOTION_TYPE; }
@@ -154,6 +155,12 @@ class ChaseMovementGenerator : public TargetedMovementGeneratorMedium<Unit, Chas
         virtual void _setLocation(Unit& owner);
 
         bool DispatchSplineToPosition(Unit& owner, float x, float y, float z, bool walk, bool cutPath, bool target = false);
+        bool CanUseStraightPath(Unit& owner, float x, float y, float z) const;
+        bool LaunchSpline(Unit& owner, bool walk, bool cutPath, bool target);
+        void RequestSplineToTarget(Unit& owner, float x, float y, float z, bool walk);
+        void CancelPendingDispatch();
+        void HandleTargetDispatched(Unit& owner);
+        void HandleTargetUnreachable(Unit& owner);
         void CutPath(Unit& owner, PointsArray& path);
         void Backpedal(Unit& owner);
 
@@ -169,6 +176,9 @@ class ChaseMovementGenerator : public TargetedMovementGeneratorMedium<Unit, Chas
         ChaseMovementMode m_currentMode;
 
         GuidVector m_spawns;
+
+        bool m_dispatchPending;                             // repath to target queued to the map's path requests
+        bool m_pendingWalk;
 };
 
 class FollowMovementGenerator : public TargetedMovementGeneratorMedium<Unit, FollowMovementGenerator>
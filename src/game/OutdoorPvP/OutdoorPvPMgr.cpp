@@ -30,6 +30,7 @@
 #include "OutdoorPvPZM.h"
 #include "Battlefield/Battlefield.h"
 #include "Battlefield/BattlefieldWG.h"
+#include "Server/DBCStores.h"
 
 INSTANTIATE_SINGLETON_1(OutdoorPvPMgr);
 
@@ -220,3 +221,33 @@ Battlefield* OutdoorPvPMgr::GetBattlefieldById(uint32 id)
 
     return nullptr;
 }
+
+/**
+   Function that checks if a map contains a zone handled by an outdoor pvp script
+
+   @param   map id to be checked
+ */
+bool OutdoorPvPMgr::HasScriptOnMap(uint32 mapId)
+{
+    static uint32 const zoneIds[] =
+    {
+        ZONE_ID_SILITHUS, ZONE_ID_TEMPLE_OF_AQ, ZONE_ID_RUINS_OF_AQ, ZONE_ID_GATES_OF_AQ,
+        ZONE_ID_EASTERN_PLAGUELANDS, ZONE_ID_STRATHOLME, ZONE_ID_SCHOLOMANCE,
+        ZONE_ID_HELLFIRE_PENINSULA, ZONE_ID_HELLFIRE_RAMPARTS, ZONE_ID_HELLFIRE_CITADEL, ZONE_ID_BLOOD_FURNACE, ZONE_ID_SHATTERED_HALLS,
+        ZONE_ID_ZANGARMARSH, ZONE_ID_STREAMVAULT, ZONE_ID_UNDERBOG, ZONE_ID_SLAVE_PENS,
+        ZONE_ID_TEROKKAR_FOREST, ZONE_ID_SHADOW_LABYRINTH, ZONE_ID_AUCHENAI_CRYPTS, ZONE_ID_SETHEKK_HALLS, ZONE_ID_MANA_TOMBS,
+        ZONE_ID_NAGRAND, ZONE_ID_GRIZZLY_HILLS, ZONE_ID_WINTERGRASP
+    };
+
+    for (uint32 zoneId : zoneIds)
+    {
+        if (!GetScript(zoneId) && !GetScriptOfAffectedZone(zoneId))
+            continue;
+
+        AreaTableEntry const* zone = GetAreaEntryByAreaID(zoneId);
+        if (zone && zone->mapid == mapId)
+            return true;
+    }
+
+    return false;
+}
@@ -133,6 +133,9 @@ class OutdoorPvPMgr
         // return assigned battlefield script by id
         Battlefield * GetBattlefieldById(uint32 id);
 
+        // true if a zone of the map is handled by an outdoor pvp script
+        bool HasScriptOnMap(uint32 mapId);
+
     private:
         // return assigned outdoor pvp script
         OutdoorPvP* GetScriptOfAffectedZone(uint32 zoneId);
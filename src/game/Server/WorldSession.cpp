@@ -53,6 +53,9 @@
 #include "PlayerBot/Base/PlayerbotAI.h"
 #endif
 
+static const uint32 RECV_PACKET_POOL_SIZE = 32;            // recycled inbound packets kept per session
+static const size_t RECV_PACKET_POOL_MAX_BUFFER = 1024;     // bigger packets are freed instead
+
 // select opcodes appropriate for processing in Map::Update context for current session state
 static bool MapSessionFilterHelper(WorldSession* session, OpcodeHandler const& opHandle)
 {
@@ -99,7 +102,7 @@ WorldSession::WorldSession(uint32 id, WorldSocket* sock, AccountTypes sec, uint8
     m_sessionDbcLocale(sWorld.GetAvailableDbcLocale(locale)), m_sessionDbLocaleIndex(sObjectMgr.GetStorageLocaleIndexFor(locale)),
     m_latency(0), m_clientTimeDelay(0), m_tutorialState(TUTORIALDATA_UNCHANGED), m_sessionState(WORLD_SESSION_STATE_CREATED),
     m_timeSyncClockDeltaQueue(6), m_timeSyncClockDelta(0), m_pendingTimeSyncRequests(), m_timeSyncNextCounter(0), m_timeSyncTimer(0),
-    m_requestSocket(nullptr) {}
+    m_requestSocket(nullptr), m_recvPacketPoolSize(0), m_recvPacketPoolBusy(false) {}
 
 /// WorldSession destructor
 WorldSession::~WorldSession()
@@ -159,7 +162,7 @@ void WorldSession::SetInCharSelection()
 
 bool WorldSession::RequestNewSocket(WorldSocket* socket)
 {
-    std::lock_guard<std::mutex> guard(m_recvQueueLock);
+    std::lock_guard<std::mutex> guard(m_requestSocketLock);
     if (m_requestSocket)
         return false;
 
@@ -254,39 +257,48 @@ void WorldSession::QueuePacket(std::unique_ptr<WorldPacket> new_packet)
         (this->*opHandle.handler)(*new_packet);
         if (new_packet->rpos() < new_packet->wpos() && sLog.HasLogLevelOrHigher(LOG_LVL_DEBUG))
             LogUnprocessedTail(*new_packet);
+        RecycleRecvPacket(std::move(new_packet));
         return;
     }
 
     if (opHandle.packetProcessing == PROCESS_MAP_THREAD)
-    {
-        std::lock_guard<std::mutex> guard(m_recvQueueMapLock);
-        m_recvQueueMap.push_back(std::move(new_packet));
-    }
+        m_recvQueueMap.Push(std::move(new_packet));
     else
+        m_recvQueue.Push(std::move(new_packet));
+}
+
+std::unique_ptr<WorldPacket> WorldSession::AcquireRecvPacket(uint32 opcode, size_t size)
+{
+    std::unique_ptr<WorldPacket> packet;
+    if (!m_recvPacketPoolBusy.exchange(true, std::memory_order_acquire))
     {
-        std::lock_guard<std::mutex> guard(m_recvQueueLock);
-        m_recvQueue.push_back(std::move(new_packet));
+        packet = m_recvPacketPool.Pop();
+        m_recvPacketPoolBusy.store(false, std::memory_order_release);
     }
+
+    if (!packet)
+        return std::unique_ptr<WorldPacket>(new WorldPacket(Opcodes(opcode), size));
+
+    --m_recvPacketPoolSize;
+    packet->Initialize(Opcodes(opcode), size);
+    return packet;
+}
+
+void WorldSession::RecycleRecvPacket(std::unique_ptr<WorldPacket> packet)
+{
+    // keep a handful of ordinary sized buffers, big client packets are rare
+    if (packet->size() > RECV_PACKET_POOL_MAX_BUFFER || m_recvPacketPoolSize >= RECV_PACKET_POOL_SIZE)
+        return;
+
+    ++m_recvPacketPoolSize;
+    m_recvPacketPool.Push(std::move(packet));
 }
 
 void WorldSession::DeleteMovementPackets()
 {
-    std::lock_guard<std::mutex> guard(m_recvQueueMapLock);
-    for (auto itr = m_recvQueueMap.begin(); itr != m_recvQueueMap.end();)
-    {
-        switch ((*itr)->GetOpcode())
-        {
-            case MSG_MOVE_SET_FACING:
-            case MSG_MOVE_HEARTBEAT:
-            {
-                itr = m_recvQueueMap.erase(itr);
-                break;
-            }
-            default:
-                ++itr;
-                break;
-        }
-    }
+    // the map queue can only be read by UpdateMap, leave a marker there instead.
+    // MSG_NULL_ACTION is never queued for the map thread by the client.
+    m_recvQueueMap.Push(std::unique_ptr<WorldPacket>(new WorldPacket(MSG_NULL_ACTION, 0)));
 }
 
 /// Logging helper for unexpected opcodes
@@ -332,22 +344,22 @@ void WorldSession::ProcessByteBufferException(WorldPacket const& packet)
 /// Update the WorldSession (triggered by World update)
 bool WorldSession::Update(uint32 diff)
 {
+    // keep the async character queries and saves of this account in order
+    Database::ShardGuard dbShard(GetAccountId());
+
     GetMessager().Execute(this);
 
-    std::deque<std::unique_ptr<WorldPacket>> recvQueueCopy;
-    {
-        std::lock_guard<std::mutex> guard(m_recvQueueLock);
-        std::swap(recvQueueCopy, m_recvQueue);
-    }
+    // packets arriving while these are handled wait for the next update
+    while (std::unique_ptr<WorldPacket> packet = m_recvQueue.Pop())
+        m_recvBatch.push_back(std::move(packet));
 
     ///- Retrieve packets from the receive queue and call the appropriate handlers
     /// not process packets if socket already closed
-    while (m_Socket && !m_Socket->IsClosed() && !recvQueueCopy.empty())
+    for (size_t i = 0; m_Socket && !m_Socket->IsClosed() && i < m_recvBatch.size(); ++i)
     {
         // sLog.outError("MOEP: %s (0x%.4X)", packet->GetOpcodeName(), packet->GetOpcode());
 
-        auto const packet = std::move(recvQueueCopy.front());
-        recvQueueCopy.pop_front();
+        std::unique_ptr<WorldPacket>& packet = m_recvBatch[i];
 
         OpcodeHandler const& opHandle = opcodeTable[packet->GetOpcode()];
         try
@@ -424,7 +436,10 @@ bool WorldSession::Update(uint32 diff)
         {
             ProcessByteBufferException(*packet);
         }
+
+        RecycleRecvPacket(std::move(packet));
     }
+    m_recvBatch.clear();
 
 #ifdef BUILD_PLAYERBOT
     // Process player bot packets
@@ -438,11 +453,8 @@ bool WorldSession::Update(uint32 diff)
         {
             Player* const botPlayer = itr->second;
             WorldSession* const pBotWorldSession = botPlayer->GetSession();
-            while(!pBotWorldSession->m_recvQueue.empty())
+            while (std::unique_ptr<WorldPacket> const botpacket = pBotWorldSession->m_recvQueue.Pop())
             {
-                auto const botpacket = std::move(pBotWorldSession->m_recvQueue.front());
-                pBotWorldSession->m_recvQueue.pop_front();
-
                 OpcodeHandler const& opHandle = opcodeTable[botpacket->GetOpcode()];
                 pBotWorldSession->ExecuteOpcode(opHandle, *botpacket);
             }
@@ -531,19 +543,39 @@ bool WorldSession::Update(uint32 diff)
 
 void WorldSession::UpdateMap(uint32 diff)
 {
-    std::deque<std::unique_ptr<WorldPacket>> recvQueueMapCopy;
+    Database::ShardGuard dbShard(GetAccountId());
+
+    // movement packets queued before the last DeleteMovementPackets marker are dropped
+    size_t movementDropEnd = 0;
+    while (std::unique_ptr<WorldPacket> packet = m_recvQueueMap.Pop())
     {
-        std::lock_guard<std::mutex> guard(m_recvQueueMapLock);
-        std::swap(recvQueueMapCopy, m_recvQueueMap);
+        if (packet->GetOpcode() == MSG_NULL_ACTION)
+            movementDropEnd = m_recvMapBatch.size();
+        m_recvMapBatch.push_back(std::move(packet));
     }
 
-    for (size_t i = 0; m_Socket && !m_Socket->IsClosed() && i < recvQueueMapCopy.size(); ++i)
+    for (size_t i = 0; m_Socket && !m_Socket->IsClosed() && i < m_recvMapBatch.size(); ++i)
     {
-        auto const packet = std::move(recvQueueMapCopy.front());
-        recvQueueMapCopy.pop_front();
+        std::unique_ptr<WorldPacket>& packet = m_recvMapBatch[i];
+
+        switch (packet->GetOpcode())
+        {
+            case MSG_NULL_ACTION:
+                continue;
+            case MSG_MOVE_SET_FACING:
+            case MSG_MOVE_HEARTBEAT:
+                if (i < movementDropEnd)
+                {
+                    RecycleRecvPacket(std::move(packet));
+                    continue;
+                }
+                break;
+            default:
+                break;
+        }
 
         OpcodeHandler const& opHandle = opcodeTable[packet->GetOpcode()];
-        
+
         try
         {
             if (opHandle.status == STATUS_LOGGEDIN)
@@ -555,12 +587,17 @@ void WorldSession::UpdateMap(uint32 diff)
         {
             ProcessByteBufferException(*packet);
         }
+
+        RecycleRecvPacket(std::move(packet));
     }
+    m_recvMapBatch.clear();
 }
 
 /// %Log the player out
 void WorldSession::LogoutPlayer()
 {
+    Database::ShardGuard dbShard(GetAccountId());
+
     // finish pending transfers before starting the logout
     while (_player && _player->IsBeingTeleportedFar())
         HandleMoveWorldportAckOpcode();
@@ -31,6 +31,7 @@
 #include "Entities/Item.h"
 #include "Server/WorldSocket.h"
 #include "Multithreading/Messager.h"
+#include "Multithreading/MPSCQueue.h"
 
 #include <deque>
 #include <mutex>
@@ -359,6 +360,9 @@ class WorldSession
         void KickPlayer(bool save = false, bool inPlace = false); // inplace variable needed for shutdown
 
         void QueuePacket(std::unique_ptr<WorldPacket> new_packet);
+        // inbound packet buffers, acquired by the network thread and recycled once handled
+        std::unique_ptr<WorldPacket> AcquireRecvPacket(uint32 opcode, size_t size);
+        void RecycleRecvPacket(std::unique_ptr<WorldPacket> packet);
 
         void DeleteMovementPackets();
 
@@ -1046,10 +1050,14 @@ class WorldSession
         uint32 m_timeSyncTimer;
 
         // Thread safety mechanisms
-        std::mutex m_recvQueueLock;
-        std::mutex m_recvQueueMapLock;
-        std::deque<std::unique_ptr<WorldPacket>> m_recvQueue;
-        std::deque<std::unique_ptr<WorldPacket>> m_recvQueueMap;
+        std::mutex m_requestSocketLock;
+        MPSCQueue<WorldPacket> m_recvQueue;                 // consumed by Update
+        MPSCQueue<WorldPacket> m_recvQueueMap;              // consumed by UpdateMap
+        MPSCQueue<WorldPacket> m_recvPacketPool;            // consumed by AcquireRecvPacket
+        std::atomic<uint32> m_recvPacketPoolSize;
+        std::atomic<bool> m_recvPacketPoolBusy;             // AcquireRecvPacket of an old and a new socket may overlap
+        std::vector<std::unique_ptr<WorldPacket>> m_recvBatch;          // packets taken from the queues for one update
+        std::vector<std::unique_ptr<WorldPacket>> m_recvMapBatch;
 
         Messager<WorldSession> m_messager;
 
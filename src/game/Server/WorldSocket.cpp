@@ -98,6 +98,38 @@ std::vector<uint32> InitOpcodeCooldowns()
 
 std::vector<uint32> WorldSocket::m_packetCooldowns = InitOpcodeCooldowns();
 
+std::vector<MaNGOS::SendLatency> InitOpcodeSendLatencies()
+{
+    std::vector<MaNGOS::SendLatency> data(NUM_MSG_TYPES, MaNGOS::SendLatency::Normal);
+
+    // combat and movement feedback the client is waiting for
+    data[SMSG_PONG] = MaNGOS::SendLatency::Immediate;
+    data[SMSG_TIME_SYNC_REQ] = MaNGOS::SendLatency::Immediate;
+    data[SMSG_SPELL_START] = MaNGOS::SendLatency::Immediate;
+    data[SMSG_SPELL_GO] = MaNGOS::SendLatency::Immediate;
+    data[SMSG_CAST_RESULT] = MaNGOS::SendLatency::Immediate;
+    data[SMSG_SPELL_FAILURE] = MaNGOS::SendLatency::Immediate;
+    data[SMSG_ATTACKERSTATEUPDATE] = MaNGOS::SendLatency::Immediate;
+    data[SMSG_MONSTER_MOVE] = MaNGOS::SendLatency::Immediate;
+    data[MSG_MOVE_TELEPORT_ACK] = MaNGOS::SendLatency::Immediate;
+    data[SMSG_MOVE_KNOCK_BACK] = MaNGOS::SendLatency::Immediate;
+    data[SMSG_FORCE_RUN_SPEED_CHANGE] = MaNGOS::SendLatency::Immediate;
+
+    // big answers to queries and lists, nobody notices a few more milliseconds
+    data[SMSG_WHO] = MaNGOS::SendLatency::Bulk;
+    data[SMSG_GUILD_ROSTER] = MaNGOS::SendLatency::Bulk;
+    data[SMSG_AUCTION_LIST_RESULT] = MaNGOS::SendLatency::Bulk;
+    data[SMSG_INITIAL_SPELLS] = MaNGOS::SendLatency::Bulk;
+    data[SMSG_ACCOUNT_DATA_TIMES] = MaNGOS::SendLatency::Bulk;
+    data[SMSG_ITEM_QUERY_SINGLE_RESPONSE] = MaNGOS::SendLatency::Bulk;
+    data[SMSG_CREATURE_QUERY_RESPONSE] = MaNGOS::SendLatency::Bulk;
+    data[SMSG_QUEST_QUERY_RESPONSE] = MaNGOS::SendLatency::Bulk;
+
+    return data;
+}
+
+std::vector<MaNGOS::SendLatency> WorldSocket::m_sendLatencies = InitOpcodeSendLatencies();
+
 std::deque<uint32> WorldSocket::GetOpcodeHistory()
 {
     return m_opcodeHistory;
@@ -122,13 +154,12 @@ void WorldSocket::SendPacket(const WorldPacket& pct, bool immediate)
     ServerPktHeader header(pct.size() + 2, pct.GetOpcode());
     m_crypt.EncryptSend((uint8*)header.header, header.getHeaderLength());
 
+    MaNGOS::SendLatency latency = immediate ? MaNGOS::SendLatency::Immediate : m_sendLatencies[pct.GetOpcode()];
+
     if (!pct.empty())
-        Write(reinterpret_cast<const char*>(&header.header), header.getHeaderLength(), reinterpret_cast<const char*>(pct.contents()), pct.size());
+        Write(reinterpret_cast<const char*>(&header.header), header.getHeaderLength(), reinterpret_cast<const char*>(pct.contents()), pct.size(), latency);
     else
-        Write(reinterpret_cast<const char*>(&header.header), header.getHeaderLength());
-
-    if (immediate)
-        ForceFlushOut();
+        Write(reinterpret_cast<const char*>(&header.header), header.getHeaderLength(), latency);
 
     m_opcodeHistory.push_front(uint32(pct.GetOpcode()));
     if (m_opcodeHistory.size() > 50)
@@ -217,7 +248,7 @@ bool WorldSocket::ProcessIncomingData()
     if (IsClosed())
         return false;
 
-    std::unique_ptr<WorldPacket> pct(new WorldPacket(opcode, validBytesRemaining));
+    std::unique_ptr<WorldPacket> pct = m_session ? m_session->AcquireRecvPacket(opcode, validBytesRemaining) : std::unique_ptr<WorldPacket>(new WorldPacket(opcode, validBytesRemaining));
 
     if (validBytesRemaining)
     {
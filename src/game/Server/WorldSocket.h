@@ -45,21 +45,19 @@ class WorldSession;
  * Most methods return -1 on failure.
  * The class uses reference counting.
  *
- * For output the class uses one buffer (64K usually) and
- * a queue where it stores packet if there is no place on
- * the queue. The reason this is done, is because the server
- * does really a lot of small-size writes to it, and it doesn't
- * scale well to allocate memory for every. When something is
- * written to the output buffer the socket is not immediately
- * activated for output (again for the same reason), there
- * is 10ms celling (thats why there is Update() override method).
- * This concept is similar to TCP_CORK, but TCP_CORK
- * uses 200ms celling. As result overhead generated by
- * sending packets from "producer" threads is minimal,
- * and doing a lot of writes with small size is tolerated.
- *
- * The calls to Update () method are managed by WorldSocketMgr
- * and ReactorRunnable.
+ * For output the class queues packets in a few reused chunks
+ * which are written with one gathering write. The reason this
+ * is done, is because the server does really a lot of
+ * small-size writes to it, and it doesn't scale well to
+ * allocate memory for every. How soon queued packets go out
+ * depends on the latency class of their opcode
+ * (m_sendLatencies) and on how busy the connection is: a quiet
+ * connection sends right away, a busy one coalesces until the
+ * running write completes or the buffer timeout runs out.
+ * This concept is similar to TCP_CORK. As result overhead
+ * generated by sending packets from "producer" threads is
+ * minimal, and doing a lot of writes with small size is
+ * tolerated.
  *
  * For input ,the class uses one 1024 bytes buffer on stack
  * to which it does recv() calls. And then received data is
@@ -140,6 +138,7 @@ class WorldSocket : public MaNGOS::Socket
         std::deque<uint32> GetOpcodeHistory();
 
         static std::vector<uint32> m_packetCooldowns;
+        static std::vector<MaNGOS::SendLatency> m_sendLatencies;
         std::map<uint32, TimePoint> m_lastPacket;
 };
 
@@ -611,6 +611,8 @@ void Spell::FillTargetMap()
                     SpellTargetFilterScheme scheme = filterScheme[rightTarget];
                     if (!unitTargetList.empty()) // Unit case
                     {
+                        PrepareTargetLineOfSight(unitTargetList, SpellEffectIndex(i));
+
                         for (auto itr = unitTargetList.begin(); itr != unitTargetList.end();)
                         {
                             if (!CheckTarget(*itr, SpellEffectIndex(i), bool(rightTarget), CheckException(targetingData.magnet)))
@@ -7700,6 +7702,55 @@ CurrentSpellTypes Spell::GetCurrentContainer() const
     return (CURRENT_GENERIC_SPELL);
 }
 
+// Below this many targets the batch is not worth building
+#define LINE_OF_SIGHT_BATCH_MIN_TARGETS 4
+
+// Checks the line of sight of all area targets in one batch, CheckTarget then finds the results in the map's memo
+void Spell::PrepareTargetLineOfSight(UnitList const& targets, SpellEffectIndex eff) const
+{
+    if (targets.size() < LINE_OF_SIGHT_BATCH_MIN_TARGETS || !sWorld.getConfig(CONFIG_BOOL_VMAP_LOS_MEMO))
+        return;
+
+    // only the normal case of CheckTarget, from the target to the casting object
+    switch (m_spellInfo->Effect[eff])
+    {
+        case SPELL_EFFECT_SUMMON_PLAYER:
+        case SPELL_EFFECT_RESURRECT_NEW:
+            return;
+        default:
+            break;
+    }
+
+    if (IsIgnoreLosSpellEffect(m_spellInfo, eff) || m_spellInfo->EffectImplicitTargetA[eff] == TARGET_LOCATION_DYNOBJ_POSITION)
+        return;
+
+    WorldObject* caster = GetCastingObject();
+    if (!caster)
+        return;
+
+    float casterX, casterY, casterZ;
+    caster->GetPosition(casterX, casterY, casterZ);
+    casterZ += caster->GetCollisionHeight();
+
+    // targets in other phases are left to the single checks
+    uint32 phaseMask = targets.front()->GetPhaseMask();
+
+    std::vector<VMAP::LineOfSightQuery> queries;
+    queries.reserve(targets.size());
+    for (Unit* target : targets)
+    {
+        if (target == m_caster || target->GetPhaseMask() != phaseMask || !target->IsInMap(caster))
+            continue;
+
+        float x, y, z;
+        target->GetPosition(x, y, z);
+        queries.push_back({ x, y, z + target->GetCollisionHeight(), casterX, casterY, casterZ, true });
+    }
+
+    if (queries.size() >= LINE_OF_SIGHT_BATCH_MIN_TARGETS)
+        caster->GetMap()->IsInLineOfSight(queries.data(), queries.size(), phaseMask, true);
+}
+
 bool Spell::CheckTarget(Unit* target, SpellEffectIndex eff, bool targetB, CheckException exception) const
 {
     // Check targets for creature type mask and remove not appropriate (skip explicit self target case, maybe need other explicit targets)
@@ -8082,7 +8133,14 @@ SpellCastResult Spell::CanOpenLock(SpellEffectIndex effIndex, uint32 lockId, Ski
 void Spell::FillAreaTargets(UnitList& targetUnitMap, float radius, float cone, SpellNotifyPushType pushType, SpellTargets spellTargets, WorldObject* originalCaster /*=nullptr*/)
 {
     MaNGOS::SpellNotifierCreatureAndPlayer notifier(*this, targetUnitMap, radius, cone, pushType, spellTargets, originalCaster);
-    Cell::VisitAllObjects(notifier.GetCenterX(), notifier.GetCenterY(), m_caster->GetMap(), notifier, radius);
+    if (sWorld.getConfig(CONFIG_BOOL_GRID_CELL_INDEX))
+    {
+        // only units within radius plus their reach can pass the notifier distance checks
+        CellIndexQuery query(notifier.GetCenterX(), notifier.GetCenterY(), notifier.GetCenterZ(), radius, TYPEMASK_UNIT, pushType != PUSH_SELF_CENTER);
+        Cell::VisitIndexedObjects(m_caster->GetMap(), query, [&notifier](WorldObject* obj) { notifier.VisitTarget(static_cast<Unit*>(obj)); });
+    }
+    else
+        Cell::VisitAllObjects(notifier.GetCenterX(), notifier.GetCenterY(), m_caster->GetMap(), notifier, radius);
 }
 
 void Spell::FillRaidOrPartyTargets(UnitList& targetUnitMap, Unit* member, Unit* center, float radius, bool raid, bool withPets, bool withcaster) const
@@ -22,6 +22,7 @@
 #include "Server/DBCEnums.h"
 #include "Entities/ObjectGuid.h"
 #include "Spells/Scripts/SpellScript.h"
+#include "Maps/MapObjectPool.h"
 
 /**
  * Used to modify what an Aura does to a player/npc.
@@ -94,6 +95,10 @@ class SpellAuraHolder
     public:
         SpellAuraHolder(SpellEntry const* spellproto, Unit* target, WorldObject* caster, Item* castItem, SpellEntry const* triggeredBy);
         ~SpellAuraHolder();
+
+        // allocated from the object pool of the map in update, see MapObjectPool
+        static void* operator new(size_t size) { return MapObjectPool::Allocate(size, MAP_POOL_SPELL_AURA_HOLDER); }
+        static void operator delete(void* ptr) { MapObjectPool::Deallocate(ptr); }
         Aura* m_auras[MAX_EFFECT_INDEX];
 
         void AddAura(Aura* aura, SpellEffectIndex index);
@@ -443,6 +448,10 @@ class Aura
 
         virtual ~Aura();
 
+        // allocated from the object pool of the map in update, see MapObjectPool
+        static void* operator new(size_t size) { return MapObjectPool::Allocate(size, MAP_POOL_AURA); }
+        static void operator delete(void* ptr) { MapObjectPool::Deallocate(ptr); }
+
         void SetModifier(AuraType type, int32 amount, uint32 periodicTime, int32 miscValue);
         Modifier*       GetModifier()       { return &m_modifier; }
         Modifier const* GetModifier() const { return &m_modifier; }
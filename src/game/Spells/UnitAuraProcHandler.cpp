@@ -358,7 +358,7 @@ struct ProcTriggeredData
     SpellAuraHolder* triggeredByHolder;
 };
 
-typedef std::list< ProcTriggeredData > ProcTriggeredList;
+typedef std::vector< ProcTriggeredData > ProcTriggeredList;
 
 uint32 createProcExtendMask(SpellNonMeleeDamage* damageInfo, SpellMissInfo missCondition)
 {
@@ -525,40 +525,96 @@ ProcExecutionData::ProcExecutionData(ProcSystemArguments& data, bool isVictim) :
     }
 }
 
+void Unit::AddProcAuraIndexEntry(SpellAuraHolder* holder)
+{
+    SpellEntry const* spellProto = holder->GetSpellProto();
+
+    uint32 procFlags = spellProto->procFlags;
+    if (SpellProcEventEntry const* spellProcEvent = sSpellMgr.GetSpellProcEvent(spellProto->Id))
+        if (spellProcEvent->procFlags)
+            procFlags = spellProcEvent->procFlags;
+
+    bool removedByDamage = (spellProto->AuraInterruptFlags & AURA_INTERRUPT_FLAG_DAMAGE) != 0;
+    if (!procFlags && !removedByDamage)
+        return;
+
+    // same position as in m_spellAuraHolders: ordered by spell id, equal ids in insertion order
+    auto itr = std::upper_bound(m_procAuraIndex.begin(), m_procAuraIndex.end(), holder->GetId(), [](uint32 spellId, ProcAuraIndexEntry const& entry)
+    {
+        return spellId < entry.holder->GetId();
+    });
+    m_procAuraIndex.insert(itr, ProcAuraIndexEntry{ holder, procFlags, removedByDamage });
+
+    m_procAuraIndexFlags |= procFlags;
+    if (removedByDamage)
+        ++m_procAuraIndexRemovedByDamage;
+}
+
+void Unit::RemoveProcAuraIndexEntry(SpellAuraHolder* holder)
+{
+    auto itr = std::find_if(m_procAuraIndex.begin(), m_procAuraIndex.end(), [holder](ProcAuraIndexEntry const& entry)
+    {
+        return entry.holder == holder;
+    });
+    if (itr == m_procAuraIndex.end())
+        return;
+
+    if (itr->removedByDamage)
+        --m_procAuraIndexRemovedByDamage;
+    m_procAuraIndex.erase(itr);
+
+    m_procAuraIndexFlags = 0;
+    for (auto const& entry : m_procAuraIndex)
+        m_procAuraIndexFlags |= entry.procFlags;
+}
+
 void Unit::ProcDamageAndSpellFor(ProcSystemArguments& argData, bool isVictim)
 {
     ProcExecutionData execData(argData, isVictim);
 
+    // damage taken removes auras with AURA_INTERRUPT_FLAG_DAMAGE that did not proc
+    bool removeByDamage = isVictim && (execData.procFlags & PROC_FLAG_TAKEN_ANY_DAMAGE) && !(execData.procSpell && execData.procSpell->HasAttribute(SPELL_ATTR_EX4_DAMAGE_DOESNT_BREAK_AURAS));
+
+    // Nothing can react
+    if (!(m_procAuraIndexFlags & execData.procFlags) && !(removeByDamage && m_procAuraIndexRemovedByDamage))
+        return;
+
     ProcTriggeredList procTriggered;
     std::vector<SpellAuraHolder*> removedHolders;
-    // Fill procTriggered list
-    for (SpellAuraHolderMap::const_iterator itr = GetSpellAuraHolderMap().begin(); itr != GetSpellAuraHolderMap().end(); ++itr)
+    // Fill procTriggered list, index can change under us in aura scripts so no iterators here
+    for (size_t i = 0; i < m_procAuraIndex.size(); ++i)
     {
+        ProcAuraIndexEntry const& entry = m_procAuraIndex[i];
+        if (!(entry.procFlags & execData.procFlags) && !(removeByDamage && entry.removedByDamage))
+            continue;
+
+        SpellAuraHolder* holder = entry.holder;
+
         // skip deleted auras (possible at recursive triggered call
-        if (itr->second->GetState() != SPELLAURAHOLDER_STATE_READY || itr->second->IsDeleted())
+        if (holder->GetState() != SPELLAURAHOLDER_STATE_READY || holder->IsDeleted())
             continue;
 
         SpellProcEventEntry const* spellProcEvent = nullptr;
-        if (!IsTriggeredAtSpellProcEvent(execData, itr->second, spellProcEvent))
+        if (!IsTriggeredAtSpellProcEvent(execData, holder, spellProcEvent))
         {
             // spell seem not managed by proc system, although some case need to be handled
 
             // only process damage case on victim
-            if (!isVictim || !(execData.procFlags & PROC_FLAG_TAKEN_ANY_DAMAGE) || (execData.procSpell && execData.procSpell->HasAttribute(SPELL_ATTR_EX4_DAMAGE_DOESNT_BREAK_AURAS)))
+            if (!removeByDamage)
                 continue;
 
-            const SpellEntry* se = itr->second->GetSpellProto();
+            const SpellEntry* se = holder->GetSpellProto();
 
             // check if the aura is interruptible by damage and if its not just added by this spell (spell who is responsible for this damage is procSpell)
             if (se->AuraInterruptFlags & AURA_INTERRUPT_FLAG_DAMAGE && (!execData.procSpell || execData.procSpell->Id != se->Id))
             {
                 DEBUG_FILTER_LOG(LOG_FILTER_SPELL_CAST, "ProcDamageAndSpell: Added Spell %u to 'remove aura due to spell' list! Reason: Damage received.", se->Id);
-                removedHolders.push_back(itr->second);
+                removedHolders.push_back(holder);
             }
             continue;
         }
 
-        procTriggered.push_back(ProcTriggeredData(spellProcEvent, itr->second));
+        procTriggered.push_back(ProcTriggeredData(spellProcEvent, holder));
     }
 
     for (auto holder : removedHolders)
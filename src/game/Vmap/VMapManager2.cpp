@@ -171,6 +171,26 @@ namespace VMAP
         }
         return result;
     }
+
+    void VMapManager2::isInLineOfSight(unsigned int pMapId, LineOfSightQuery* queries, size_t count, bool ignoreM2Model)
+    {
+        InstanceTreeMap::iterator instanceTree = iInstanceMapTrees.find(pMapId);
+        if (!isLineOfSightCalcEnabled() || instanceTree == iInstanceMapTrees.end())
+        {
+            for (size_t i = 0; i < count; ++i)
+                queries[i].inLineOfSight = true;
+            return;
+        }
+
+        StaticMapTree const* tree = instanceTree->second;
+        for (size_t i = 0; i < count; ++i)
+        {
+            LineOfSightQuery& query = queries[i];
+            Vector3 pos1 = convertPositionToInternalRep(query.x1, query.y1, query.z1);
+            Vector3 pos2 = convertPositionToInternalRep(query.x2, query.y2, query.z2);
+            query.inLineOfSight = pos1 == pos2 || tree->isInLineOfSight(pos1, pos2, ignoreM2Model);
+        }
+    }
     //=========================================================
     /**
     get the hit position and return true if we hit something
@@ -45,6 +45,7 @@
 #include "Loot/LootMgr.h"
 #include "Entities/ItemEnchantmentMgr.h"
 #include "Maps/MapManager.h"
+#include "Maps/MapWorkers.h"
 #include "DBScripts/ScriptMgr.h"
 #include "AI/ScriptDevAI/ScriptDevAIMgr.h"
 #include "AI/CreatureAIRegistry.h"
@@ -53,6 +54,7 @@
 #include "OutdoorPvP/OutdoorPvP.h"
 #include "Vmap/VMapFactory.h"
 #include "MotionGenerators/MoveMap.h"
+#include "MotionGenerators/PathCache.h"
 #include "GameEvents/GameEventMgr.h"
 #include "Pools/PoolManager.h"
 #include "Database/DatabaseImpl.h"
@@ -67,6 +69,7 @@
 #include "Calendar/Calendar.h"
 #include "Weather/Weather.h"
 #include "World/WorldState.h"
+#include "World/WorldLoader.h"
 #include "Cinematics/CinematicMgr.h"
 
 #ifdef BUILD_AHBOT
@@ -99,7 +102,7 @@ TimePoint World::m_currentTime = TimePoint();
 uint32 World::m_currentDiff = 0;
 
 /// World constructor
-World::World() : mail_timer(0), mail_timer_expires(0), m_NextDailyQuestReset(0), m_NextWeeklyQuestReset(0), m_NextMonthlyQuestReset(0), m_opcodeCounters(NUM_MSG_TYPES)
+World::World() : mail_timer(0), mail_timer_expires(0), m_mapIndependentTime(0), m_NextDailyQuestReset(0), m_NextWeeklyQuestReset(0), m_NextMonthlyQuestReset(0), m_opcodeCounters(NUM_MSG_TYPES)
 {
     m_playerLimit = 0;
     m_allowMovement = true;
@@ -488,6 +491,11 @@ void World::LoadConfigSettings(bool reload)
     setConfig(CONFIG_BOOL_ADDON_CHANNEL, "AddonChannel", true);
     setConfig(CONFIG_BOOL_CLEAN_CHARACTER_DB, "CleanCharacterDB", true);
     setConfig(CONFIG_BOOL_GRID_UNLOAD, "GridUnload", true);
+    if (configNoReload(reload, CONFIG_BOOL_GRID_CELL_INDEX, "GridCellIndex", false))
+        setConfig(CONFIG_BOOL_GRID_CELL_INDEX, "GridCellIndex", false);
+    if (configNoReload(reload, CONFIG_BOOL_MAP_OBJECT_POOL, "MapObjectPool", false))
+        setConfig(CONFIG_BOOL_MAP_OBJECT_POOL, "MapObjectPool", false);
+    setConfig(CONFIG_BOOL_GRID_PREFETCH, "GridPrefetch", false);
     setConfig(CONFIG_UINT32_MAX_WHOLIST_RETURNS, "MaxWhoListReturns", 49);
 
     std::string forceLoadGridOnMaps = sConfig.GetStringDefault("LoadAllGridsOnMaps");
@@ -633,6 +641,9 @@ void World::LoadConfigSettings(bool reload)
     }
 
     setConfig(CONFIG_UINT32_NUM_MAP_THREADS, "MapUpdate.Threads", 3);
+    setConfig(CONFIG_UINT32_MAP_PARALLEL_UPDATE_THRESHOLD, "MapUpdate.ParallelThreshold", 0);
+    setConfig(CONFIG_UINT32_COMPRESSION_PARALLEL_THRESHOLD, "Compression.ParallelThreshold", 0);
+    setConfig(CONFIG_UINT32_LOADING_THREADS, "LoadingThreads", 1);
     setConfig(CONFIG_UINT32_SKILL_CHANCE_ORANGE, "SkillChance.Orange", 100);
     setConfig(CONFIG_UINT32_SKILL_CHANCE_YELLOW, "SkillChance.Yellow", 75);
     setConfig(CONFIG_UINT32_SKILL_CHANCE_GREEN,  "SkillChance.Green",  25);
@@ -793,6 +804,7 @@ void World::LoadConfigSettings(bool reload)
     setConfig(CONFIG_BOOL_AUTO_DOWNRANK,              "AutoDownrank", true);
 
     m_relocation_ai_notify_delay = sConfig.GetIntDefault("Visibility.AIRelocationNotifyDelay", 1000u);
+    setConfig(CONFIG_BOOL_AI_NOTIFY_BATCH, "Visibility.AIRelocationNotifyBatch", false);
     m_relocation_lower_limit_sq = pow(sConfig.GetFloatDefault("Visibility.RelocationLowerLimit", 10), 2);
 
     // Visibility on Continents
@@ -868,6 +880,8 @@ void World::LoadConfigSettings(bool reload)
     }
 
     setConfig(CONFIG_BOOL_VMAP_INDOOR_CHECK, "vmap.enableIndoorCheck", true);
+    setConfig(CONFIG_BOOL_VMAP_LOS_MEMO, "vmap.lineOfSightMemo", false);
+    setConfig(CONFIG_BOOL_MAP_FILES_MEMORY_MAPPED, "MapFiles.MemoryMapped", false);
     bool enableLOS = sConfig.GetBoolDefault("vmap.enableLOS", false);
     bool enableHeight = sConfig.GetBoolDefault("vmap.enableHeight", false);
     std::string ignoreSpellIds = sConfig.GetStringDefault("vmap.ignoreSpellIds");
@@ -883,12 +897,17 @@ void World::LoadConfigSettings(bool reload)
     sLog.outString("WORLD: VMap data directory is: %svmaps", m_dataPath.c_str());
 
     setConfig(CONFIG_BOOL_MMAP_ENABLED, "mmap.enabled", true);
+    setConfig(CONFIG_BOOL_MMAP_MEMORY_MAPPED, "mmap.memoryMapped", false);
+    setConfig(CONFIG_BOOL_MMAP_PREFETCH, "mmap.prefetchTiles", false);
     std::string ignoreMapIds = sConfig.GetStringDefault("mmap.ignoreMapIds");
     MMAP::MMapFactory::preventPathfindingOnMaps(ignoreMapIds.c_str());
     sLog.outString("WORLD: MMap pathfinding %sabled", getConfig(CONFIG_BOOL_MMAP_ENABLED) ? "en" : "dis");
 
     setConfig(CONFIG_BOOL_PATH_FIND_OPTIMIZE, "PathFinder.OptimizePath", true);
     setConfig(CONFIG_BOOL_PATH_FIND_NORMALIZE_Z, "PathFinder.NormalizeZ", false);
+    setConfig(CONFIG_BOOL_PATH_FIND_ASYNC, "PathFinder.Async", false);
+    setConfig(CONFIG_UINT32_PATH_FIND_CACHE_SIZE, "PathFinder.CacheSize", 0);
+    sPathCache.SetCapacity(getConfig(CONFIG_UINT32_PATH_FIND_CACHE_SIZE));
 
     sLog.outString();
 }
@@ -908,6 +927,10 @@ void World::SetInitialWorldSettings()
     ///- Initialize config settings
     LoadConfigSettings();
 
+    // the fields that existed before were sent as text, keep them that way for existing series
+    m_updateMetric.reset(new metric::handle("world.update", { "total", "presession", "premap", "map", "singletons", "cleanup", "concurrent" }, {}, 0x3F));
+    m_playerSaveMetric.reset(new metric::handle("player.save", { "statements", "bytes" }));
+
     ///- Check the existence of the map files for all races start areas.
     if (!MapManager::ExistMapAndVMap(0, -6240.32f, 331.033f) ||                     // Dwarf/ Gnome
             !MapManager::ExistMapAndVMap(0, -8949.95f, -132.493f) ||                // Human
@@ -994,100 +1017,198 @@ void World::SetInitialWorldSettings()
     sObjectMgr.SetHighestGuids();                           // must be after PackInstances() and PackGroupIds()
     sLog.outString();
 
-    sLog.outString("Loading Page Texts...");
-    sObjectMgr.LoadPageTexts();
+    ///- Templates and spell data below only depend on the DBC stores and each other, independent steps are loaded concurrently
+    WorldLoader templateLoader(getConfig(CONFIG_UINT32_LOADING_THREADS));
 
-    sLog.outString("Loading Game Object Templates...");     // must be after LoadPageTexts
-    std::vector<uint32> transportDisplayIds = sObjectMgr.LoadGameobjectInfo();
-    MMAP::MMapFactory::createOrGetMMapManager()->loadAllGameObjectModels(transportDisplayIds);
+    templateLoader.AddStep("PageTexts", {}, []()
+    {
+        sLog.outString("Loading Page Texts...");
+        sObjectMgr.LoadPageTexts();
+    });
 
-    sLog.outString("Loading GameObject models...");
-    LoadGameObjectModelList();
-    sLog.outString();
+    templateLoader.AddStep("GameObjectTemplates", { "PageTexts" }, []()
+    {
+        sLog.outString("Loading Game Object Templates...");     // must be after LoadPageTexts
+        std::vector<uint32> transportDisplayIds = sObjectMgr.LoadGameobjectInfo();
+        MMAP::MMapFactory::createOrGetMMapManager()->loadAllGameObjectModels(transportDisplayIds);
+    });
+
+    templateLoader.AddStep("GameObjectModels", { "GameObjectTemplates" }, []()
+    {
+        sLog.outString("Loading GameObject models...");
+        LoadGameObjectModelList();
+    });
 
     // loads GO data
-    sTransportMgr.LoadTransportAnimationAndRotation();
+    templateLoader.AddStep("TransportAnimation", { "GameObjectTemplates" }, []()
+    {
+        sTransportMgr.LoadTransportAnimationAndRotation();
+    });
+
+    templateLoader.AddStep("SpellChains", {}, []()
+    {
+        sLog.outString("Loading Spell Chain Data...");
+        sSpellMgr.LoadSpellChains();
+    });
 
-    sLog.outString("Loading Spell Chain Data...");
-    sSpellMgr.LoadSpellChains();
+    templateLoader.AddStep("SpellCones", { "SpellChains" }, []()
+    {
+        sLog.outString("Checking Spell Cone Data...");
+        sObjectMgr.CheckSpellCones();
+    });
 
-    sLog.outString("Checking Spell Cone Data...");
-    sObjectMgr.CheckSpellCones();
+    templateLoader.AddStep("SpellElixirs", {}, []()
+    {
+        sLog.outString("Loading Spell Elixir types...");
+        sSpellMgr.LoadSpellElixirs();
+    });
 
-    sLog.outString("Loading Spell Elixir types...");
-    sSpellMgr.LoadSpellElixirs();
+    templateLoader.AddStep("SpellLearnSkills", { "SpellChains" }, []()
+    {
+        sLog.outString("Loading Spell Learn Skills...");
+        sSpellMgr.LoadSpellLearnSkills();                       // must be after LoadSpellChains
+    });
 
-    sLog.outString("Loading Spell Learn Skills...");
-    sSpellMgr.LoadSpellLearnSkills();                       // must be after LoadSpellChains
+    templateLoader.AddStep("SpellLearnSpells", { "SpellChains" }, []()
+    {
+        sLog.outString("Loading Spell Learn Spells...");
+        sSpellMgr.LoadSpellLearnSpells();
+    });
 
-    sLog.outString("Loading Spell Learn Spells...");
-    sSpellMgr.LoadSpellLearnSpells();
+    templateLoader.AddStep("SpellProcEvents", { "SpellChains" }, []()
+    {
+        sLog.outString("Loading Spell Proc Event conditions...");
+        sSpellMgr.LoadSpellProcEvents();
+    });
 
-    sLog.outString("Loading Spell Proc Event conditions...");
-    sSpellMgr.LoadSpellProcEvents();
+    templateLoader.AddStep("SpellBonuses", { "SpellChains" }, []()
+    {
+        sLog.outString("Loading Spell Bonus Data...");
+        sSpellMgr.LoadSpellBonuses();                           // must be after LoadSpellChains
+    });
 
-    sLog.outString("Loading Spell Bonus Data...");
-    sSpellMgr.LoadSpellBonuses();                           // must be after LoadSpellChains
+    templateLoader.AddStep("SpellProcItemEnchant", { "SpellChains" }, []()
+    {
+        sLog.outString("Loading Spell Proc Item Enchant...");
+        sSpellMgr.LoadSpellProcItemEnchant();                   // must be after LoadSpellChains
+    });
 
-    sLog.outString("Loading Spell Proc Item Enchant...");
-    sSpellMgr.LoadSpellProcItemEnchant();                   // must be after LoadSpellChains
+    templateLoader.AddStep("SpellThreats", { "SpellChains" }, []()
+    {
+        sLog.outString("Loading Aggro Spells Definitions...");
+        sSpellMgr.LoadSpellThreats();
+    });
 
-    sLog.outString("Loading Aggro Spells Definitions...");
-    sSpellMgr.LoadSpellThreats();
+    templateLoader.AddStep("GossipText", {}, []()
+    {
+        sLog.outString("Loading NPC Texts...");
+        sObjectMgr.LoadGossipText();
+    });
 
-    sLog.outString("Loading NPC Texts...");
-    sObjectMgr.LoadGossipText();
+    templateLoader.AddStep("RandomEnchantments", {}, []()
+    {
+        sLog.outString("Loading Item Random Enchantments Table...");
+        LoadRandomEnchantmentsTable();
+    });
 
-    sLog.outString("Loading Item Random Enchantments Table...");
-    LoadRandomEnchantmentsTable();
+    templateLoader.AddStep("ItemTemplates", { "RandomEnchantments", "PageTexts" }, []()
+    {
+        sLog.outString("Loading Item Templates...");            // must be after LoadRandomEnchantmentsTable and LoadPageTexts
+        sObjectMgr.LoadItemPrototypes();
+    });
 
-    sLog.outString("Loading Item Templates...");            // must be after LoadRandomEnchantmentsTable and LoadPageTexts
-    sObjectMgr.LoadItemPrototypes();
+    templateLoader.AddStep("ItemConverts", { "ItemTemplates" }, []()
+    {
+        sLog.outString("Loading Item converts...");             // must be after LoadItemPrototypes
+        sObjectMgr.LoadItemConverts();
+    });
 
-    sLog.outString("Loading Item converts...");             // must be after LoadItemPrototypes
-    sObjectMgr.LoadItemConverts();
+    templateLoader.AddStep("ItemExpireConverts", { "ItemTemplates" }, []()
+    {
+        sLog.outString("Loading Item expire converts...");      // must be after LoadItemPrototypes
+        sObjectMgr.LoadItemExpireConverts();
+    });
 
-    sLog.outString("Loading Item expire converts...");      // must be after LoadItemPrototypes
-    sObjectMgr.LoadItemExpireConverts();
+    templateLoader.AddStep("CreatureModelInfo", {}, []()
+    {
+        sLog.outString("Loading Creature Model Based Info Data...");
+        sObjectMgr.LoadCreatureModelInfo();
+    });
 
-    sLog.outString("Loading Creature Model Based Info Data...");
-    sObjectMgr.LoadCreatureModelInfo();
+    templateLoader.AddStep("EquipmentTemplates", {}, []()
+    {
+        sLog.outString("Loading Equipment templates...");
+        sObjectMgr.LoadEquipmentTemplates();
+    });
 
-    sLog.outString("Loading Equipment templates...");
-    sObjectMgr.LoadEquipmentTemplates();
+    templateLoader.AddStep("CreatureStats", {}, []()
+    {
+        sLog.outString("Loading Creature Stats...");
+        sObjectMgr.LoadCreatureClassLvlStats();
+    });
 
-    sLog.outString("Loading Creature Stats...");
-    sObjectMgr.LoadCreatureClassLvlStats();
+    // must be after model info, equipment templates and class level stats, it validates against all of them
+    templateLoader.AddStep("CreatureTemplates", { "CreatureModelInfo", "EquipmentTemplates", "CreatureStats" }, []()
+    {
+        sLog.outString("Loading Creature templates...");
+        sObjectMgr.LoadCreatureTemplates();
+    });
 
-    sLog.outString("Loading Creature templates...");
-    sObjectMgr.LoadCreatureTemplates();
+    templateLoader.AddStep("CreatureTemplateSpells", { "CreatureTemplates" }, []()
+    {
+        sLog.outString("Loading Creature template spells...");
+        sObjectMgr.LoadCreatureTemplateSpells();
+    });
 
-    sLog.outString("Loading Creature template spells...");
-    sObjectMgr.LoadCreatureTemplateSpells();
+    templateLoader.AddStep("CreatureCooldowns", { "CreatureTemplates" }, []()
+    {
+        sLog.outString("Loading Creature cooldowns...");
+        sObjectMgr.LoadCreatureCooldowns();
+    });
 
-    sLog.outString("Loading Creature cooldowns...");
-    sObjectMgr.LoadCreatureCooldowns();
+    templateLoader.AddStep("CreatureModelRace", { "CreatureTemplates" }, []()
+    {
+        sLog.outString("Loading Creature Model for race...");   // must be after creature templates
+        sObjectMgr.LoadCreatureModelRace();
+    });
 
-    sLog.outString("Loading Creature Model for race...");   // must be after creature templates
-    sObjectMgr.LoadCreatureModelRace();
+    templateLoader.AddStep("VehicleAccessory", { "CreatureTemplates" }, []()
+    {
+        sLog.outString("Loading Vehicle Accessory...");         // must be after LoadCreatureTemplates
+        sObjectMgr.LoadVehicleAccessory();
+    });
 
-    sLog.outString("Loading Vehicle Accessory...");         // must be after LoadCreatureTemplates
-    sObjectMgr.LoadVehicleAccessory();
+    templateLoader.AddStep("ItemRequiredTarget", { "ItemTemplates", "CreatureTemplates" }, []()
+    {
+        sLog.outString("Loading ItemRequiredTarget...");
+        sObjectMgr.LoadItemRequiredTarget();
+    });
 
-    sLog.outString("Loading ItemRequiredTarget...");
-    sObjectMgr.LoadItemRequiredTarget();
+    templateLoader.AddStep("ReputationRewardRate", {}, []()
+    {
+        sLog.outString("Loading Reputation Reward Rates...");
+        sObjectMgr.LoadReputationRewardRate();
+    });
 
-    sLog.outString("Loading Reputation Reward Rates...");
-    sObjectMgr.LoadReputationRewardRate();
+    templateLoader.AddStep("ReputationOnKill", { "CreatureTemplates" }, []()
+    {
+        sLog.outString("Loading Creature Reputation OnKill Data...");
+        sObjectMgr.LoadReputationOnKill();
+    });
 
-    sLog.outString("Loading Creature Reputation OnKill Data...");
-    sObjectMgr.LoadReputationOnKill();
+    templateLoader.AddStep("ReputationSpillover", {}, []()
+    {
+        sLog.outString("Loading Reputation Spillover Data...");
+        sObjectMgr.LoadReputationSpilloverTemplate();
+    });
 
-    sLog.outString("Loading Reputation Spillover Data...");
-    sObjectMgr.LoadReputationSpilloverTemplate();
+    templateLoader.AddStep("PointsOfInterest", {}, []()
+    {
+        sLog.outString("Loading Points Of Interest Data...");
+        sObjectMgr.LoadPointsOfInterest();
+    });
 
-    sLog.outString("Loading Points Of Interest Data...");
-    sObjectMgr.LoadPointsOfInterest();
+    templateLoader.Run();
 
     sLog.outString("Loading Creature Conditional Spawn Data...");  // must be after LoadCreatureTemplates and before LoadCreatures
     sObjectMgr.LoadCreatureConditionalSpawn();
@@ -1584,11 +1705,11 @@ void World::Update(uint32 diff)
         if (++mail_timer > mail_timer_expires)
         {
             mail_timer = 0;
-            sObjectMgr.ReturnOrDeleteOldMails(true);
+            m_mapIndependentTasks.push_back([]() { sObjectMgr.ReturnOrDeleteOldMails(true); });
         }
 
         ///- Handle expired auctions
-        sAuctionMgr.Update();
+        m_mapIndependentTasks.push_back([]() { sAuctionMgr.Update(); });
     }
 
 #ifdef BUILD_AHBOT
@@ -1615,8 +1736,12 @@ void World::Update(uint32 diff)
     }
     auto preMapTime = std::chrono::time_point_cast<std::chrono::milliseconds>(Clock::now());
     /// <li> Handle all other objects
+    ///- Start work that does not touch map state, it runs next to the map updates
+    bool tasksScheduled = ScheduleMapIndependentTasks();
     ///- Update objects (maps, transport, creatures,...)
     sMapMgr.Update(diff);
+    if (tasksScheduled)
+        sMapMgr.GetUpdater().wait();
     auto postMapTime = std::chrono::time_point_cast<std::chrono::milliseconds>(Clock::now());
     sBattleGroundMgr.Update(diff);
     sOutdoorPvPMgr.Update(diff);
@@ -1688,13 +1813,33 @@ void World::Update(uint32 diff)
     long long singletons = (postSingletonTime - postMapTime).count();
     long long cleanup = (updateEndTime - postSingletonTime).count();
 
-    metric::measurement meas("world.update");
-    meas.add_field("total", std::to_string(total));
-    meas.add_field("presession", std::to_string(presession));
-    meas.add_field("premap", std::to_string(premap));
-    meas.add_field("map", std::to_string(map));
-    meas.add_field("singletons", std::to_string(singletons));
-    meas.add_field("cleanup", std::to_string(cleanup));
+    m_updateMetric->record({ total, presession, premap, map, singletons, cleanup, int64(m_mapIndependentTime.exchange(0)) });
+}
+
+bool World::ScheduleMapIndependentTasks()
+{
+    if (m_mapIndependentTasks.empty())
+        return false;
+
+    MapUpdater& updater = sMapMgr.GetUpdater();
+    bool concurrent = updater.activated();
+    for (auto& task : m_mapIndependentTasks)
+    {
+        auto timedTask = [this, task]()
+        {
+            auto startTime = std::chrono::steady_clock::now();
+            task();
+            m_mapIndependentTime += uint32(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime).count());
+        };
+
+        if (concurrent)
+            updater.schedule_update(new WorldTaskWorker(timedTask, updater));
+        else
+            timedTask();
+    }
+
+    m_mapIndependentTasks.clear();
+    return concurrent;
 }
 
 namespace MaNGOS
@@ -2725,6 +2870,24 @@ void World::GeneratePacketMetrics()
         m_opcodeCounters[i] = 0;
     }
 
+    UpdateData::CompressionStats compression = UpdateData::ConsumeCompressionStats();
+    metric::measurement meas_compression("world.metrics.compression");
+    meas_compression.add_field("bytes_in", std::to_string(compression.bytesIn));
+    meas_compression.add_field("bytes_out", std::to_string(compression.bytesOut));
+    meas_compression.add_field("time", std::to_string(compression.time));
+
+    Object::SharedUpdateStats sharedUpdates = Object::ConsumeSharedUpdateStats();
+    metric::measurement meas_shared_updates("world.metrics.shared_updates");
+    meas_shared_updates.add_field("built", std::to_string(sharedUpdates.blocksBuilt));
+    meas_shared_updates.add_field("sent", std::to_string(sharedUpdates.blocksSent));
+    if (sharedUpdates.blocksBuilt)
+        meas_shared_updates.add_field("ratio", std::to_string(float(sharedUpdates.blocksSent) / sharedUpdates.blocksBuilt));
+
+    PathCache::Stats pathCache = sPathCache.ConsumeStats();
+    metric::measurement meas_path_cache("world.metrics.path_cache");
+    meas_path_cache.add_field("hits", std::to_string(pathCache.hits));
+    meas_path_cache.add_field("misses", std::to_string(pathCache.misses));
+
     metric::measurement meas_players("world.metrics.players");
     meas_players.add_field("online", std::to_string(GetActiveSessionCount()));
     meas_players.add_field("unique", std::to_string(GetUniqueSessionCount()));
@@ -38,6 +38,7 @@
 #include <utility>
 #include <vector>
 #include <array>
+#include <atomic>
 
 class Object;
 class ObjectGuid;
@@ -147,6 +148,10 @@ enum eConfigUInt32Values
     CONFIG_UINT32_MASS_MAILER_SEND_PER_TICK,
     CONFIG_UINT32_UPTIME_UPDATE,
     CONFIG_UINT32_NUM_MAP_THREADS,
+    CONFIG_UINT32_MAP_PARALLEL_UPDATE_THRESHOLD,
+    CONFIG_UINT32_COMPRESSION_PARALLEL_THRESHOLD,
+    CONFIG_UINT32_LOADING_THREADS,
+    CONFIG_UINT32_PATH_FIND_CACHE_SIZE,
     CONFIG_UINT32_AUCTION_DEPOSIT_MIN,
     CONFIG_UINT32_SKILL_CHANCE_ORANGE,
     CONFIG_UINT32_SKILL_CHANCE_YELLOW,
@@ -306,6 +311,9 @@ enum eConfigFloatValues
 enum eConfigBoolValues
 {
     CONFIG_BOOL_GRID_UNLOAD = 0,
+    CONFIG_BOOL_GRID_CELL_INDEX,
+    CONFIG_BOOL_MAP_OBJECT_POOL,
+    CONFIG_BOOL_GRID_PREFETCH,
     CONFIG_BOOL_SAVE_RESPAWN_TIME_IMMEDIATELY,
     CONFIG_BOOL_OFFHAND_CHECK_AT_TALENTS_RESET,
     CONFIG_BOOL_ALLOW_TWO_SIDE_ACCOUNTS,
@@ -371,14 +379,20 @@ enum eConfigBoolValues
     CONFIG_BOOL_STATS_SAVE_ONLY_ON_LOGOUT,
     CONFIG_BOOL_CLEAN_CHARACTER_DB,
     CONFIG_BOOL_VMAP_INDOOR_CHECK,
+    CONFIG_BOOL_VMAP_LOS_MEMO,
+    CONFIG_BOOL_AI_NOTIFY_BATCH,
+    CONFIG_BOOL_MAP_FILES_MEMORY_MAPPED,
     CONFIG_BOOL_PET_UNSUMMON_AT_MOUNT,
     CONFIG_BOOL_PET_ATTACK_FROM_BEHIND,
     CONFIG_BOOL_AUTO_DOWNRANK,
     CONFIG_BOOL_MMAP_ENABLED,
+    CONFIG_BOOL_MMAP_MEMORY_MAPPED,
+    CONFIG_BOOL_MMAP_PREFETCH,
     CONFIG_BOOL_PLAYER_COMMANDS,
     CONFIG_BOOL_AUTOLOAD_ACTIVE,
     CONFIG_BOOL_PATH_FIND_OPTIMIZE,
     CONFIG_BOOL_PATH_FIND_NORMALIZE_Z,
+    CONFIG_BOOL_PATH_FIND_ASYNC,
     CONFIG_BOOL_VALUE_COUNT
 };
 
@@ -471,6 +485,8 @@ struct CliCommandHolder
     }
 };
 
+namespace metric { class handle; }
+
 /// The World
 class World
 {
@@ -661,6 +677,8 @@ class World
         Messager<World>& GetMessager() { return m_messager; }
 
         void IncrementOpcodeCounter(uint32 opcodeId); // thread safe due to atomics
+        // recorded by Player::SaveToDB
+        metric::handle const& GetPlayerSaveMetric() const { return *m_playerSaveMetric; }
     protected:
         void _UpdateGameTime();
         // callback for UpdateRealmCharacters
@@ -681,6 +699,9 @@ class World
 
         void GeneratePacketMetrics(); // thread safe due to atomics
 
+        // work of the tick that does not touch map state, its effects on players are posted through the messagers
+        bool ScheduleMapIndependentTasks();
+
     private:
         void setConfig(eConfigUInt32Values index, char const* fieldname, uint32 defvalue);
         void setConfig(eConfigInt32Values index, char const* fieldname, int32 defvalue);
@@ -709,6 +730,13 @@ class World
         uint32 mail_timer;
         uint32 mail_timer_expires;
 
+        std::vector<std::function<void()>> m_mapIndependentTasks;
+        std::atomic<uint32> m_mapIndependentTime;
+
+        // built once the config is loaded, metric settings are read on first use
+        std::unique_ptr<metric::handle> m_updateMetric;
+        std::unique_ptr<metric::handle> m_playerSaveMetric;
+
         typedef std::unordered_map<uint32, WorldSession*> SessionMap;
         typedef std::unordered_set<uint32> UniqueSessions;
         SessionMap m_sessions;
@@ -0,0 +1,160 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "World/WorldLoader.h"
+#include "Database/DatabaseEnv.h"
+#include "ProgressBar.h"
+#include "Timer.h"
+#include "Log.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <set>
+#include <thread>
+
+void WorldLoader::AddStep(char const* name, std::function<void()> work)
+{
+    Step step;
+    step.name = name;
+    step.work = std::move(work);
+    step.prerequisites = 0;
+    step.duration = 0;
+
+    if (!m_steps.empty())
+    {
+        m_steps.back().dependents.push_back(m_steps.size());
+        step.prerequisites = 1;
+    }
+
+    m_steps.push_back(std::move(step));
+}
+
+void WorldLoader::AddStep(char const* name, std::initializer_list<char const*> after, std::function<void()> work)
+{
+    Step step;
+    step.name = name;
+    step.work = std::move(work);
+    step.prerequisites = 0;
+    step.duration = 0;
+
+    for (char const* prerequisite : after)
+    {
+        auto itr = std::find_if(m_steps.begin(), m_steps.end(), [prerequisite](Step const& s) { return strcmp(s.name, prerequisite) == 0; });
+        MANGOS_ASSERT(itr != m_steps.end());                // prerequisites must be added first, this keeps the graph acyclic
+
+        itr->dependents.push_back(m_steps.size());
+        ++step.prerequisites;
+    }
+
+    m_steps.push_back(std::move(step));
+}
+
+void WorldLoader::Run()
+{
+    uint32 startTime = WorldTimer::getMSTime();
+
+    if (m_threads > 1 && m_steps.size() > 1)
+        RunParallel();
+    else
+    {
+        // steps are added in an order that already satisfies all prerequisites
+        for (Step& step : m_steps)
+        {
+            uint32 stepStart = WorldTimer::getMSTime();
+            step.work();
+            step.duration = WorldTimer::getMSTimeDiff(stepStart, WorldTimer::getMSTime());
+        }
+    }
+
+    LogTimings(WorldTimer::getMSTimeDiff(startTime, WorldTimer::getMSTime()));
+}
+
+void WorldLoader::RunParallel()
+{
+    std::mutex lock;
+    std::condition_variable condition;
+    std::set<size_t> ready;                                 // lowest index first, stays close to the serial order
+    size_t finished = 0;
+
+    for (size_t i = 0; i < m_steps.size(); ++i)
+        if (!m_steps[i].prerequisites)
+            ready.insert(i);
+
+    auto worker = [&]()
+    {
+        WorldDatabase.ThreadStart();
+
+        std::unique_lock<std::mutex> guard(lock);
+        while (true)
+        {
+            condition.wait(guard, [&]() { return !ready.empty() || finished == m_steps.size(); });
+            if (ready.empty())
+                break;
+
+            size_t index = *ready.begin();
+            ready.erase(ready.begin());
+
+            guard.unlock();
+            uint32 stepStart = WorldTimer::getMSTime();
+            m_steps[index].work();
+            uint32 duration = WorldTimer::getMSTimeDiff(stepStart, WorldTimer::getMSTime());
+            guard.lock();
+
+            m_steps[index].duration = duration;
+            ++finished;
+            for (size_t dependent : m_steps[index].dependents)
+                if (--m_steps[dependent].prerequisites == 0)
+                    ready.insert(dependent);
+
+            condition.notify_all();
+        }
+        guard.unlock();
+
+        WorldDatabase.ThreadEnd();
+    };
+
+    // progress bars of concurrent steps would overwrite each other
+    bool showProgress = BarGoLink::GetOutputState();
+    BarGoLink::SetOutputState(false);
+
+    std::vector<std::thread> threads;
+    threads.reserve(m_threads);
+    for (uint32 i = 0; i < m_threads; ++i)
+        threads.emplace_back(worker);
+    for (std::thread& thread : threads)
+        thread.join();
+
+    BarGoLink::SetOutputState(showProgress);
+}
+
+void WorldLoader::LogTimings(uint32 totalTime) const
+{
+    std::vector<Step const*> steps;
+    steps.reserve(m_steps.size());
+    for (Step const& step : m_steps)
+        steps.push_back(&step);
+
+    std::stable_sort(steps.begin(), steps.end(), [](Step const* a, Step const* b) { return a->duration > b->duration; });
+
+    sLog.outString(">> Loaded %u steps in %u ms using %u thread(s), time per step:", uint32(m_steps.size()), totalTime, m_threads > 1 ? m_threads : 1);
+    for (Step const* step : steps)
+        sLog.outString("   %-32s %6u ms", step->name, step->duration);
+    sLog.outString();
+}
@@ -0,0 +1,64 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_WORLDLOADER_H
+#define MANGOS_WORLDLOADER_H
+
+#include "Common.h"
+
+#include <functional>
+#include <initializer_list>
+#include <vector>
+
+/**
+ * Runs a group of startup load steps, each declaring the steps it must run after.
+ * Steps without unfinished prerequisites are executed concurrently on the loading threads,
+ * a step added without explicit prerequisites runs after the step added before it.
+ * With a single thread all steps run on the calling thread in the order they were added.
+ */
+class WorldLoader
+{
+    public:
+        explicit WorldLoader(uint32 threads) : m_threads(threads) {}
+
+        // runs after the previously added step
+        void AddStep(char const* name, std::function<void()> work);
+        // runs after all named steps, which must be added before
+        void AddStep(char const* name, std::initializer_list<char const*> after, std::function<void()> work);
+
+        // blocks until all steps are done and logs the time spent in each of them
+        void Run();
+
+    private:
+        struct Step
+        {
+            char const* name;
+            std::function<void()> work;
+            std::vector<size_t> dependents;
+            uint32 prerequisites;
+            uint32 duration;
+        };
+
+        void RunParallel();
+        void LogTimings(uint32 totalTime) const;
+
+        std::vector<Step> m_steps;
+        uint32 m_threads;
+};
+
+#endif
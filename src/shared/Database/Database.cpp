@@ -97,7 +97,7 @@ Database::~Database()
     StopServer();
 }
 
-bool Database::Initialize(const char* infoString, int nConns /*= 1*/)
+bool Database::Initialize(const char* infoString, int nConns /*= 1*/, int nAsyncConns /*= 1*/)
 {
     // Enable logging of SQL commands (usually only GM commands)
     // (See method: PExecuteLog)
@@ -110,6 +110,7 @@ bool Database::Initialize(const char* infoString, int nConns /*= 1*/)
     }
 
     m_pingIntervallms = sConfig.GetIntDefault("MaxPingTime", 30) * (MINUTE * 1000);
+    m_binaryResults = sConfig.GetBoolDefault("BinaryResultSets", false);
 
     // create DB connections
 
@@ -134,10 +135,21 @@ bool Database::Initialize(const char* infoString, int nConns /*= 1*/)
         m_pQueryConnections.push_back(pConn);
     }
 
-    // create and initialize connection for async requests
-    m_pAsyncConn = CreateConnection();
-    if (!m_pAsyncConn->Initialize(infoString))
-        return false;
+    // create and initialize connections for async requests, each one gets its own delay thread
+    nAsyncConns = std::min(std::max(nAsyncConns, MIN_CONNECTION_POOL_SIZE), MAX_CONNECTION_POOL_SIZE);
+    for (int i = 0; i < nAsyncConns; ++i)
+    {
+        SqlConnection* pConn = CreateConnection();
+        if (!pConn->Initialize(infoString))
+        {
+            delete pConn;
+            return false;
+        }
+
+        m_pAsyncConns.push_back(pConn);
+    }
+
+    m_pAsyncConn = m_pAsyncConns[0];
 
     m_pResultQueue = new SqlResultQueue;
 
@@ -150,9 +162,12 @@ void Database::StopServer()
     HaltDelayThread();
 
     delete m_pResultQueue;
-    delete m_pAsyncConn;
+
+    for (auto& m_pAsyncConnection : m_pAsyncConns)
+        delete m_pAsyncConnection;
 
     m_pResultQueue = nullptr;
+    m_pAsyncConns.clear();
     m_pAsyncConn = nullptr;
 
     for (auto& m_pQueryConnection : m_pQueryConnections)
@@ -161,30 +176,67 @@ void Database::StopServer()
     m_pQueryConnections.clear();
 }
 
-SqlDelayThread* Database::CreateDelayThread()
+SqlDelayThread* Database::CreateDelayThread(SqlConnection* conn, bool pingDatabase)
 {
-    assert(m_pAsyncConn);
-    return new SqlDelayThread(this, m_pAsyncConn);
+    assert(conn);
+    return new SqlDelayThread(this, conn, pingDatabase);
 }
 
 void Database::InitDelayThread()
 {
-    assert(!m_delayThread);
+    assert(m_delayThreads.empty());
+
+    // New delay thread for delay execute on every async connection, the first one pings all connections
+    for (size_t i = 0; i < m_pAsyncConns.size(); ++i)
+        m_threadBodies.push_back(CreateDelayThread(m_pAsyncConns[i], i == 0));
 
-    // New delay thread for delay execute
-    m_threadBody = CreateDelayThread();              // will deleted at m_delayThread delete
-    m_delayThread = new MaNGOS::Thread(m_threadBody);
+    // the first thread is ordered against the writes of all shards, the shards against its writes
+    std::vector<SqlDelayThread*> const shards(m_threadBodies.begin() + 1, m_threadBodies.end());
+    m_threadBodies[0]->SetFenceThreads(shards);
+    for (size_t i = 1; i < m_threadBodies.size(); ++i)
+        m_threadBodies[i]->SetFenceThreads({ m_threadBodies[0] });
+
+    for (auto threadBody : m_threadBodies)
+        m_delayThreads.push_back(new MaNGOS::Thread(threadBody));   // will delete the thread body
 }
 
 void Database::HaltDelayThread()
 {
-    if (!m_threadBody || !m_delayThread) return;
+    if (m_threadBodies.empty() || m_delayThreads.empty()) return;
+
+    for (auto threadBody : m_threadBodies)
+        threadBody->Stop();                                 // Stop event
+
+    // the first thread is drained first, a thread waiting for writes of a stopped one does not block
+    for (auto delayThread : m_delayThreads)
+        delayThread->wait();                                // Wait for flush to DB
+
+    // requests queued meanwhile are executed on delete, the first thread first
+    for (auto threadBody : m_threadBodies)
+        threadBody->SetFenceThreads({});
+
+    for (auto delayThread : m_delayThreads)
+        delete delayThread;                                 // This also deletes its thread body
+
+    m_delayThreads.clear();
+    m_threadBodies.clear();
+}
+
+static thread_local uint32 s_asyncShardKey = 0;
+
+Database::ShardGuard::ShardGuard(uint32 key) : m_previousKey(s_asyncShardKey)
+{
+    s_asyncShardKey = key;
+}
+
+Database::ShardGuard::~ShardGuard()
+{
+    s_asyncShardKey = m_previousKey;
+}
 
-    m_threadBody->Stop();                                   // Stop event
-    m_delayThread->wait();                                  // Wait for flush to DB
-    delete m_delayThread;                                   // This also deletes m_threadBody
-    m_delayThread = nullptr;
-    m_threadBody = nullptr;
+SqlDelayThread* Database::getDelayThread() const
+{
+    return m_threadBodies[s_asyncShardKey % m_threadBodies.size()];
 }
 
 void Database::ThreadStart()
@@ -229,8 +281,9 @@ void Database::Ping()
 {
     const char* sql = "SELECT 1";
 
+    for (auto& m_pAsyncConnection : m_pAsyncConns)
     {
-        SqlConnection::Lock guard(m_pAsyncConn);
+        SqlConnection::Lock guard(m_pAsyncConnection);
         delete guard->Query(sql);
     }
 
@@ -330,7 +383,7 @@ bool Database::Execute(const char* sql)
     if (pTrans)
     {
         // add SQL request to trans queue
-        pTrans->DelayExecute(new SqlPlainRequest(sql));
+        pTrans->DelayExecute(new SqlPlainRequest(sql), strlen(sql));
     }
     else
     {
@@ -339,7 +392,7 @@ bool Database::Execute(const char* sql)
             return DirectExecute(sql);
 
         // Simple sql statement
-        m_threadBody->Delay(new SqlPlainRequest(sql));
+        getDelayThread()->Delay(new SqlPlainRequest(sql), true);
     }
 
     return true;
@@ -408,7 +461,7 @@ bool Database::CommitTransaction()
         return CommitTransactionDirect();
 
     // add SqlTransaction to the async queue
-    m_threadBody->Delay(m_currentTransaction.release());
+    getDelayThread()->Delay(m_currentTransaction.release(), true);
     return true;
 }
 
@@ -443,6 +496,17 @@ bool Database::RollbackTransaction()
     return true;
 }
 
+bool Database::GetTransactionVolume(size_t& statements, size_t& bytes) const
+{
+    SqlTransaction const* pTrans = m_currentTransaction.get();
+    if (!pTrans)
+        return false;
+
+    statements = pTrans->GetStatementCount();
+    bytes = pTrans->GetByteCount();
+    return true;
+}
+
 bool Database::CheckRequiredField(char const* table_name, char const* required_name)
 {
     // check required field
@@ -554,7 +618,11 @@ bool Database::ExecuteStmt(const SqlStatementID& id, SqlStmtParameters* params)
     if (pTrans)
     {
         // add SQL request to trans queue
-        pTrans->DelayExecute(new SqlPreparedRequest(id.ID(), params));
+        size_t bytes = 0;
+        for (SqlStmtFieldData const& param : params->params())
+            bytes += param.size();
+
+        pTrans->DelayExecute(new SqlPreparedRequest(id.ID(), params), bytes);
     }
     else
     {
@@ -563,7 +631,7 @@ bool Database::ExecuteStmt(const SqlStatementID& id, SqlStmtParameters* params)
             return DirectExecuteStmt(id, params);
 
         // Simple sql statement
-        m_threadBody->Delay(new SqlPreparedRequest(id.ID(), params));
+        getDelayThread()->Delay(new SqlPreparedRequest(id.ID(), params), true);
     }
 
     return true;
@@ -595,6 +663,7 @@ SqlStatement Database::CreateStatement(SqlStatementID& index, const char* fmt)
         {
             nId = ++m_iStmtIndex;
             m_stmtRegistry[szFmt] = nId;
+            m_stmtStrings.push_back(szFmt);
         }
         else
             nId = iter->second;
@@ -613,13 +682,6 @@ std::string Database::GetStmtString(const int stmtId) const
     if (stmtId == -1 || stmtId > m_iStmtIndex)
         return std::string();
 
-    PreparedStmtRegistry::const_iterator iter_last = m_stmtRegistry.end();
-    for (PreparedStmtRegistry::const_iterator iter = m_stmtRegistry.begin(); iter != iter_last; ++iter)
-    {
-        if (iter->second == stmtId)
-            return iter->first;
-    }
-
-    return std::string();
+    return m_stmtStrings[stmtId];
 }
 
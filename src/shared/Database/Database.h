@@ -104,12 +104,26 @@ class Database
     public:
         virtual ~Database();
 
-        virtual bool Initialize(const char* infoString, int nConns = 1);
-        // start worker thread for async DB request execution
+        virtual bool Initialize(const char* infoString, int nConns = 1, int nAsyncConns = 1);
+        // start worker threads for async DB request execution
         virtual void InitDelayThread();
-        // stop worker thread
+        // stop worker threads
         virtual void HaltDelayThread();
 
+        // Async queries and writes issued by this thread while the guard is alive are executed by the
+        // delay thread owning the key (account id), in the order they were issued. Key 0 and requests
+        // without a guard go to the first delay thread, which orders them against the writes of all
+        // shards; writes touching rows of other characters (mail, auctions) must use key 0.
+        class ShardGuard
+        {
+            public:
+                explicit ShardGuard(uint32 key);
+                ~ShardGuard();
+
+            private:
+                uint32 m_previousKey;
+        };
+
         /// Synchronous DB queries
         inline QueryResult* Query(const char* sql)
         {
@@ -188,6 +202,8 @@ class Database
         bool RollbackTransaction();
         // for sync transaction execution
         bool CommitTransactionDirect();
+        // statements and bytes queued so far in the transaction of the calling thread
+        bool GetTransactionVolume(size_t& statements, size_t& bytes) const;
 
         // PREPARED STATEMENT API
 
@@ -211,6 +227,8 @@ class Database
 
         bool CheckRequiredField(char const* table_name, char const* required_name);
         uint32 GetPingIntervall() const { return m_pingIntervallms; }
+        // SELECTs are executed as server side statements and read in the binary protocol
+        bool UseBinaryResults() const { return m_binaryResults; }
 
         // function to ping database connections
         void Ping();
@@ -223,8 +241,8 @@ class Database
     protected:
         Database() :
             m_nQueryConnPoolSize(1), m_pAsyncConn(nullptr), m_pResultQueue(nullptr),
-            m_threadBody(nullptr), m_delayThread(nullptr), m_bAllowAsyncTransactions(false),
-            m_iStmtIndex(-1), m_logSQL(false), m_pingIntervallms(0)
+            m_bAllowAsyncTransactions(false),
+            m_iStmtIndex(-1), m_logSQL(false), m_pingIntervallms(0), m_binaryResults(false)
         {
             m_nQueryCounter = -1;
         }
@@ -234,7 +252,7 @@ class Database
         // factory method to create SqlConnection objects
         virtual SqlConnection* CreateConnection() = 0;
         // factory method to create SqlDelayThread objects
-        virtual SqlDelayThread* CreateDelayThread();
+        virtual SqlDelayThread* CreateDelayThread(SqlConnection* conn, bool pingDatabase);
 
         // per-thread based storage for SqlTransaction object initialization - no locking is required
         boost::thread_specific_ptr<SqlTransaction> m_currentTransaction;
@@ -243,8 +261,10 @@ class Database
 
         // round-robin connection selection
         SqlConnection* getQueryConnection();
-        // for now return one single connection for async requests
+        // connection used for direct execution of async requests
         SqlConnection* getAsyncConnection() const { return m_pAsyncConn; }
+        // delay thread owning the shard key of the calling thread, used for async reads and writes
+        SqlDelayThread* getDelayThread() const;
 
         friend class SqlStatement;
         // PREPARED STATEMENT API
@@ -260,12 +280,14 @@ class Database
         typedef std::vector< SqlConnection* > SqlConnectionContainer;
         SqlConnectionContainer m_pQueryConnections;
 
-        // only one single DB connection for transactions
+        // one DB connection per delay thread for transactions and async requests
+        SqlConnectionContainer m_pAsyncConns;
+        // first async connection, used for direct execution
         SqlConnection* m_pAsyncConn;
 
         SqlResultQueue*     m_pResultQueue;                 ///< Transaction queues from diff. threads
-        SqlDelayThread*     m_threadBody;                   ///< Pointer to delay sql executer (owned by m_delayThread)
-        MaNGOS::Thread*     m_delayThread;                  ///< Pointer to executer thread
+        std::vector<SqlDelayThread*> m_threadBodies;        ///< Delay sql executers (owned by m_delayThreads)
+        std::vector<MaNGOS::Thread*> m_delayThreads;        ///< Executer threads, one per async connection
 
         bool m_bAllowAsyncTransactions;                     ///< flag which specifies if async transactions are enabled
 
@@ -277,6 +299,7 @@ class Database
 
         typedef std::unordered_map<std::string, int> PreparedStmtRegistry;
         PreparedStmtRegistry m_stmtRegistry;                ///<
+        std::vector<std::string> m_stmtStrings;             ///< registry strings indexed by statement ID
 
         int m_iStmtIndex;
 
@@ -285,5 +308,6 @@ class Database
         bool m_logSQL;
         std::string m_logsDir;
         uint32 m_pingIntervallms;
+        bool m_binaryResults;
 };
 #endif
@@ -204,8 +204,75 @@ bool MySQLConnection::_Query(const char* sql, MYSQL_RES** pResult, MYSQL_FIELD**
     return true;
 }
 
+bool MySQLConnection::_QueryBinary(const char* sql, QueryResult** pResult, QueryFieldNames* pNames)
+{
+    if (!mMysql)
+        return false;
+
+    uint32 _s = WorldTimer::getMSTime();
+
+    MYSQL_STMT* stmt = mysql_stmt_init(mMysql);
+    if (!stmt)
+        return false;
+
+    // statements the server can not prepare and queries without result set go the text way
+    MYSQL_RES* metadata = nullptr;
+    if (mysql_stmt_prepare(stmt, sql, strlen(sql)) || !(metadata = mysql_stmt_result_metadata(stmt)))
+    {
+        mysql_stmt_close(stmt);
+        return false;
+    }
+
+    // make mysql_stmt_store_result() fill max_length, text buffers are sized by it
+    my_bool updateMaxLength = 1;
+    mysql_stmt_attr_set(stmt, STMT_ATTR_UPDATE_MAX_LENGTH, &updateMaxLength);
+
+    if (mysql_stmt_execute(stmt) || mysql_stmt_store_result(stmt))
+    {
+        sLog.outErrorDb("SQL: %s", sql);
+        sLog.outErrorDb("query ERROR: %s", mysql_stmt_error(stmt));
+        mysql_free_result(metadata);
+        mysql_stmt_close(stmt);
+        return true;
+    }
+    DEBUG_FILTER_LOG(LOG_FILTER_SQL_TEXT, "[%u ms] SQL: %s", WorldTimer::getMSTimeDiff(_s, WorldTimer::getMSTime()), sql);
+
+    uint64 rowCount = mysql_stmt_num_rows(stmt);
+    uint32 fieldCount = mysql_stmt_field_count(stmt);
+    if (!rowCount)
+    {
+        mysql_free_result(metadata);
+        mysql_stmt_close(stmt);
+        return true;
+    }
+
+    // the metadata only carries max_length once the result is stored
+    mysql_free_result(metadata);
+    metadata = mysql_stmt_result_metadata(stmt);
+
+    if (pNames)
+    {
+        MYSQL_FIELD* fields = mysql_fetch_fields(metadata);
+        pNames->resize(fieldCount);
+        for (uint32 i = 0; i < fieldCount; ++i)
+            (*pNames)[i] = fields[i].name;
+    }
+
+    QueryResultMysqlStmt* queryResult = new QueryResultMysqlStmt(this, stmt, metadata, rowCount, fieldCount);
+    queryResult->NextRow();
+    *pResult = queryResult;
+    return true;
+}
+
 QueryResult* MySQLConnection::Query(const char* sql)
 {
+    if (m_db.UseBinaryResults())
+    {
+        QueryResult* queryResult = nullptr;
+        if (_QueryBinary(sql, &queryResult, nullptr))
+            return queryResult;
+    }
+
     MYSQL_RES* result = nullptr;
     MYSQL_FIELD* fields = nullptr;
     uint64 rowCount = 0;
@@ -222,6 +289,14 @@ QueryResult* MySQLConnection::Query(const char* sql)
 
 QueryNamedResult* MySQLConnection::QueryNamed(const char* sql)
 {
+    if (m_db.UseBinaryResults())
+    {
+        QueryResult* queryResult = nullptr;
+        QueryFieldNames names;
+        if (_QueryBinary(sql, &queryResult, &names))
+            return queryResult ? new QueryNamedResult(queryResult, names) : nullptr;
+    }
+
     MYSQL_RES* result = nullptr;
     MYSQL_FIELD* fields = nullptr;
     uint64 rowCount = 0;
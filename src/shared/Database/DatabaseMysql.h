@@ -85,6 +85,9 @@ class MySQLConnection : public SqlConnection
     private:
         bool _TransactionCmd(const char* sql);
         bool _Query(const char* sql, MYSQL_RES** pResult, MYSQL_FIELD** pFields, uint64* pRowCount, uint32* pFieldCount);
+        // runs a SELECT as server side statement to receive the result in the binary protocol,
+        // returns false if the statement can not be prepared and the text protocol has to be used
+        bool _QueryBinary(const char* sql, QueryResult** pResult, QueryFieldNames* pNames);
 
         MYSQL* mMysql;
 };
@@ -52,6 +52,7 @@ SqlConnection* DatabasePostgre::CreateConnection()
 
 PostgreSQLConnection::~PostgreSQLConnection()
 {
+    FreePreparedStatements();
     PQfinish(mPGconn);
 }
 
@@ -237,4 +238,219 @@ unsigned long PostgreSQLConnection::escape_string(char* to, const char* from, un
     return PQescapeString(to, from, length);
 }
 
+//////////////////////////////////////////////////////////////////////////
+SqlPreparedStatement* PostgreSQLConnection::CreateStatement(const std::string& fmt)
+{
+    return new PostgreSQLPreparedStatement(fmt, *this, mPGconn);
+}
+
+//////////////////////////////////////////////////////////////////////////
+PostgreSQLPreparedStatement::PostgreSQLPreparedStatement(const std::string& fmt, SqlConnection& conn, PGconn* pgconn) : SqlPreparedStatement(fmt, conn),
+    m_pPGconn(pgconn), m_bServerPrepared(false)
+{
+    // a process wide counter keeps the names unique on every connection
+    static std::atomic<uint32> stmtCounter(0);
+    m_szName = "mangos_stmt_" + std::to_string(++stmtCounter);
+}
+
+PostgreSQLPreparedStatement::~PostgreSQLPreparedStatement()
+{
+    Deallocate();
+}
+
+bool PostgreSQLPreparedStatement::prepare()
+{
+    if (isPrepared())
+        return true;
+
+    // PostgreSQL numbers its placeholders, skip question marks inside string literals
+    m_szQuery.clear();
+    m_szQuery.reserve(m_szFmt.length() + 16);
+    m_nParams = 0;
+
+    bool inLiteral = false;
+    for (char c : m_szFmt)
+    {
+        if (c == '\'')
+            inLiteral = !inLiteral;
+
+        if (c == '?' && !inLiteral)
+            m_szQuery += "$" + std::to_string(++m_nParams);
+        else
+            m_szQuery += c;
+    }
+
+    m_paramTypes.assign(m_nParams, 0);
+    m_paramValues.assign(m_nParams, nullptr);
+    m_paramLengths.assign(m_nParams, 0);
+    m_paramFormats.assign(m_nParams, 0);
+    m_paramBuffer.assign(m_nParams * sizeof(uint64), 0);
+
+    m_bIsQuery = strnicmp(m_szFmt.c_str(), "select", 6) == 0;
+    m_bPrepared = true;
+    return true;
+}
+
+void PostgreSQLPreparedStatement::bind(const SqlStmtParameters& holder)
+{
+    if (!isPrepared())
+    {
+        MANGOS_ASSERT(false);
+        return;
+    }
+
+    // verify if we bound all needed input parameters
+    if (m_nParams != holder.boundParams())
+    {
+        MANGOS_ASSERT(false);
+        return;
+    }
+
+    unsigned int nIndex = 0;
+    for (SqlStmtFieldData const& data : holder.params())
+        addParam(nIndex++, data);
+}
+
+void PostgreSQLPreparedStatement::addParam(unsigned int nIndex, const SqlStmtFieldData& data)
+{
+    MANGOS_ASSERT(nIndex < m_nParams);
+
+    // the server side statement is typed, a caller binding other types needs a new one
+    Oid type = ToPostgreSQLType(data);
+    if (m_paramTypes[nIndex] != type)
+    {
+        m_paramTypes[nIndex] = type;
+        Deallocate();
+    }
+
+    if (data.type() == FIELD_NONE)
+    {
+        m_paramValues[nIndex] = nullptr;
+        m_paramLengths[nIndex] = 0;
+        m_paramFormats[nIndex] = 0;
+        return;
+    }
+
+    if (data.type() == FIELD_STRING)
+    {
+        // text format, the value never passes through the SQL parser so no escaping is needed
+        m_paramValues[nIndex] = data.toStr();
+        m_paramLengths[nIndex] = 0;
+        m_paramFormats[nIndex] = 0;
+        return;
+    }
+
+    uint64 value = 0;
+    int length = 0;
+    switch (data.type())
+    {
+        case FIELD_BOOL:    value = uint16(data.toBool());      length = 2; break;
+        case FIELD_UI8:     value = uint16(data.toUint8());     length = 2; break;
+        case FIELD_I8:      value = uint16(data.toInt8());      length = 2; break;
+        case FIELD_I16:     value = uint16(data.toInt16());     length = 2; break;
+        case FIELD_UI16:    value = uint32(data.toUint16());    length = 4; break;
+        case FIELD_I32:     value = uint32(data.toInt32());     length = 4; break;
+        case FIELD_UI32:    value = uint64(data.toUint32());    length = 8; break;
+        case FIELD_I64:     value = uint64(data.toInt64());     length = 8; break;
+        case FIELD_UI64:    value = data.toUint64();            length = 8; break;
+        case FIELD_FLOAT:
+        {
+            float f = data.toFloat();
+            uint32 bits;
+            memcpy(&bits, &f, sizeof(bits));
+            value = bits;
+            length = 4;
+            break;
+        }
+        case FIELD_DOUBLE:
+        {
+            double d = data.toDouble();
+            memcpy(&value, &d, sizeof(value));
+            length = 8;
+            break;
+        }
+        default:
+            break;
+    }
+
+    // binary format is network byte order
+    char* buff = &m_paramBuffer[nIndex * sizeof(uint64)];
+    for (int i = 0; i < length; ++i)
+        buff[i] = char(value >> (8 * (length - 1 - i)));
+
+    m_paramValues[nIndex] = buff;
+    m_paramLengths[nIndex] = length;
+    m_paramFormats[nIndex] = 1;
+}
+
+bool PostgreSQLPreparedStatement::PrepareOnServer()
+{
+    PGresult* res = PQprepare(m_pPGconn, m_szName.c_str(), m_szQuery.c_str(), m_nParams, m_paramTypes.data());
+    if (PQresultStatus(res) != PGRES_COMMAND_OK)
+    {
+        sLog.outError("SQL: PQprepare() failed for '%s'", m_szQuery.c_str());
+        sLog.outError("SQL ERROR: %s", PQresultErrorMessage(res));
+        PQclear(res);
+        return false;
+    }
+
+    PQclear(res);
+    m_bServerPrepared = true;
+    return true;
+}
+
+void PostgreSQLPreparedStatement::Deallocate()
+{
+    if (!m_bServerPrepared)
+        return;
+
+    m_bServerPrepared = false;
+    if (PQstatus(m_pPGconn) != CONNECTION_OK)
+        return;
+
+    std::string sql = "DEALLOCATE " + m_szName;
+    PQclear(PQexec(m_pPGconn, sql.c_str()));
+}
+
+bool PostgreSQLPreparedStatement::execute()
+{
+    if (!isPrepared())
+        return false;
+
+    if (!m_bServerPrepared && !PrepareOnServer())
+        return false;
+
+    PGresult* res = PQexecPrepared(m_pPGconn, m_szName.c_str(), m_nParams, m_paramValues.data(), m_paramLengths.data(), m_paramFormats.data(), 0);
+    ExecStatusType status = PQresultStatus(res);
+    if (status != PGRES_COMMAND_OK && status != PGRES_TUPLES_OK)
+    {
+        sLog.outError("SQL: cannot execute '%s'", m_szQuery.c_str());
+        sLog.outError("SQL ERROR: %s", PQresultErrorMessage(res));
+        PQclear(res);
+        return false;
+    }
+
+    PQclear(res);
+    return true;
+}
+
+Oid PostgreSQLPreparedStatement::ToPostgreSQLType(const SqlStmtFieldData& data)
+{
+    // values of pg_type, unsigned types use the next wider signed type
+    switch (data.type())
+    {
+        case FIELD_BOOL:
+        case FIELD_UI8:
+        case FIELD_I8:
+        case FIELD_I16:     return 21;      // int2
+        case FIELD_UI16:
+        case FIELD_I32:     return 23;      // int4
+        case FIELD_UI32:
+        case FIELD_I64:
+        case FIELD_UI64:    return 20;      // int8
+        case FIELD_FLOAT:   return 700;     // float4
+        case FIELD_DOUBLE:  return 701;     // float8
+        default:            return 0;       // let the server infer strings and NULLs
+    }
+}
 #endif
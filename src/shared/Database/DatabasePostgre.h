@@ -32,6 +32,45 @@
 #include <libpq-fe.h>
 #endif
 
+// PostgreSQL prepared statement class
+class PostgreSQLPreparedStatement : public SqlPreparedStatement
+{
+    public:
+        PostgreSQLPreparedStatement(const std::string& fmt, SqlConnection& conn, PGconn* pgconn);
+        ~PostgreSQLPreparedStatement();
+
+        // rewrite '?' placeholders to $n, the server side statement is created by the first execute
+        // since the parameter types are only known once parameters are bound
+        virtual bool prepare() override;
+
+        // bind input parameters, numbers are sent in binary format
+        virtual void bind(const SqlStmtParameters& holder) override;
+
+        // execute DML statement
+        virtual bool execute() override;
+
+    protected:
+        // bind parameters
+        void addParam(unsigned int nIndex, const SqlStmtFieldData& data);
+
+        static Oid ToPostgreSQLType(const SqlStmtFieldData& data);
+
+    private:
+        bool PrepareOnServer();
+        void Deallocate();
+
+        PGconn* m_pPGconn;
+        std::string m_szName;
+        std::string m_szQuery;
+        bool m_bServerPrepared;
+
+        std::vector<Oid> m_paramTypes;
+        std::vector<const char*> m_paramValues;
+        std::vector<int> m_paramLengths;
+        std::vector<int> m_paramFormats;
+        std::vector<char> m_paramBuffer;
+};
+
 class PostgreSQLConnection : public SqlConnection
 {
     public:
@@ -50,6 +89,9 @@ class PostgreSQLConnection : public SqlConnection
         bool CommitTransaction() override;
         bool RollbackTransaction() override;
 
+    protected:
+        SqlPreparedStatement* CreateStatement(const std::string& fmt) override;
+
     private:
         bool _TransactionCmd(const char* sql);
         bool _Query(const char* sql, PGresult** pResult, uint64* pRowCount, uint32* pFieldCount) override;
@@ -16,5 +16,25 @@
  * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
  */
 
-//#include "DatabaseEnv.h"
+#include "Field.h"
+
+#include <cfloat>
+
+const char* Field::FormatBinaryValue() const
+{
+    if (mText[0])
+        return mText;
+
+    // same precision the text protocol of the server uses
+    switch (mStorage)
+    {
+        case STORAGE_INT:    snprintf(mText, sizeof(mText), SI64FMTD, mBinary.i); break;
+        case STORAGE_UINT:   snprintf(mText, sizeof(mText), UI64FMTD, mBinary.u); break;
+        case STORAGE_FLOAT:  snprintf(mText, sizeof(mText), "%.*g", FLT_DIG, mBinary.d); break;
+        case STORAGE_DOUBLE: snprintf(mText, sizeof(mText), "%.*g", DBL_DIG, mBinary.d); break;
+        default: break;
+    }
+
+    return mText;
+}
 
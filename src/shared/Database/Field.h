@@ -34,8 +34,8 @@ class Field
             DB_TYPE_BOOL    = 0x04
         };
 
-        Field() : mValue(nullptr), mType(DB_TYPE_UNKNOWN) {}
-        Field(const char* value, enum DataTypes type) : mValue(value), mType(type) {}
+        Field() : mValue(nullptr), mType(DB_TYPE_UNKNOWN), mStorage(STORAGE_TEXT) {}
+        Field(const char* value, enum DataTypes type) : mValue(value), mType(type), mStorage(STORAGE_TEXT) {}
 
         ~Field() {}
 
@@ -44,21 +44,43 @@ class Field
 
         const char* GetString() const
         {
+            if (mStorage != STORAGE_TEXT && mValue)
+                return FormatBinaryValue();
             return mValue ? mValue : ""; // We need this null check as we do not always null check what we get back from the database everywhere
         }
         std::string GetCppString() const
         {
-            return mValue ? mValue : "";                    // std::string s = 0 have undefine result in C++
+            return GetString();
+        }
+        float GetFloat() const
+        {
+            if (mStorage != STORAGE_TEXT)
+                return mValue ? static_cast<float>(GetBinaryDouble()) : 0.0f;
+            return mValue ? static_cast<float>(atof(mValue)) : 0.0f;
+        }
+        bool GetBool() const
+        {
+            if (mStorage != STORAGE_TEXT)
+                return mValue ? GetBinaryInt() > 0 : false;
+            return mValue ? atoi(mValue) > 0 : false;
+        }
+        int32 GetInt32() const { return static_cast<int32>(GetInteger()); }
+        uint8 GetUInt8() const { return static_cast<uint8>(GetInteger()); }
+        uint16 GetUInt16() const { return static_cast<uint16>(GetInteger()); }
+        int16 GetInt16() const { return static_cast<int16>(GetInteger()); }
+        uint32 GetUInt32() const
+        {
+            if (mStorage != STORAGE_TEXT)
+                return mValue ? static_cast<uint32>(GetBinaryInt()) : uint32(0);
+            return mValue ? static_cast<uint32>(atoll(mValue)) : uint32(0);
         }
-        float GetFloat() const { return mValue ? static_cast<float>(atof(mValue)) : 0.0f; }
-        bool GetBool() const { return mValue ? atoi(mValue) > 0 : false; }
-        int32 GetInt32() const { return mValue ? static_cast<int32>(atol(mValue)) : int32(0); }
-        uint8 GetUInt8() const { return mValue ? static_cast<uint8>(atol(mValue)) : uint8(0); }
-        uint16 GetUInt16() const { return mValue ? static_cast<uint16>(atol(mValue)) : uint16(0); }
-        int16 GetInt16() const { return mValue ? static_cast<int16>(atol(mValue)) : int16(0); }
-        uint32 GetUInt32() const { return mValue ? static_cast<uint32>(atoll(mValue)) : uint32(0); }
         uint64 GetUInt64() const
         {
+            if (mStorage == STORAGE_UINT)
+                return mValue ? mBinary.u : 0;
+            if (mStorage != STORAGE_TEXT)
+                return mValue ? static_cast<uint64>(GetBinaryInt()) : 0;
+
             uint64 value = 0;
             if (!mValue || sscanf(mValue, UI64FMTD, &value) == -1)
                 return 0;
@@ -69,13 +91,72 @@ class Field
         void SetType(enum DataTypes type) { mType = type; }
         // no need for memory allocations to store resultset field strings
         // all we need is to cache pointers returned by different DBMS APIs
-        void SetValue(const char* value) { mValue = value; }
+        void SetValue(const char* value) { mValue = value; mStorage = STORAGE_TEXT; }
+
+        // values already decoded by a binary protocol, the text form is only built if asked for
+        void SetBinaryValue(int64 value) { mBinary.i = value; SetBinaryStorage(STORAGE_INT); }
+        void SetBinaryValue(uint64 value) { mBinary.u = value; SetBinaryStorage(STORAGE_UINT); }
+        void SetBinaryValue(float value) { mBinary.d = value; SetBinaryStorage(STORAGE_FLOAT); }
+        void SetBinaryValue(double value) { mBinary.d = value; SetBinaryStorage(STORAGE_DOUBLE); }
+        void SetBinaryNull() { mValue = nullptr; mStorage = STORAGE_INT; }
 
     private:
         Field(Field const&);
         Field& operator=(Field const&);
 
+        enum StorageTypes
+        {
+            STORAGE_TEXT,
+            STORAGE_INT,
+            STORAGE_UINT,
+            STORAGE_FLOAT,
+            STORAGE_DOUBLE
+        };
+
+        // binary values point mValue at the (lazily filled) text buffer so IsNULL keeps working
+        void SetBinaryStorage(StorageTypes storage) { mStorage = storage; mText[0] = '\0'; mValue = mText; }
+
+        // text getters truncate the same way atol does
+        int64 GetInteger() const
+        {
+            if (mStorage != STORAGE_TEXT)
+                return mValue ? GetBinaryInt() : 0;
+            return mValue ? atol(mValue) : 0;
+        }
+
+        int64 GetBinaryInt() const
+        {
+            switch (mStorage)
+            {
+                case STORAGE_UINT:   return static_cast<int64>(mBinary.u);
+                case STORAGE_FLOAT:
+                case STORAGE_DOUBLE: return static_cast<int64>(mBinary.d);
+                default:             return mBinary.i;
+            }
+        }
+
+        double GetBinaryDouble() const
+        {
+            switch (mStorage)
+            {
+                case STORAGE_UINT:   return static_cast<double>(mBinary.u);
+                case STORAGE_FLOAT:
+                case STORAGE_DOUBLE: return mBinary.d;
+                default:             return static_cast<double>(mBinary.i);
+            }
+        }
+
+        const char* FormatBinaryValue() const;
+
         const char* mValue;
         enum DataTypes mType;
+        StorageTypes mStorage;
+        union
+        {
+            int64 i;
+            uint64 u;
+            double d;
+        } mBinary;
+        mutable char mText[32];
 };
 #endif
@@ -66,7 +66,7 @@ void QueryResultMysql::EndQuery()
     }
 }
 
-enum Field::DataTypes QueryResultMysql::ConvertNativeType(enum_field_types mysqlType) const
+enum Field::DataTypes QueryResultMysql::ConvertNativeType(enum_field_types mysqlType)
 {
     switch (mysqlType)
     {
@@ -96,4 +96,168 @@ enum Field::DataTypes QueryResultMysql::ConvertNativeType(enum_field_types mysql
             return Field::DB_TYPE_UNKNOWN;
     }
 }
+
+QueryResultMysqlStmt::QueryResultMysqlStmt(SqlConnection* conn, MYSQL_STMT* stmt, MYSQL_RES* metadata, uint64 rowCount, uint32 fieldCount) :
+    QueryResult(rowCount, fieldCount), mConn(conn), mStmt(stmt), mColumns(fieldCount), mBinds(fieldCount)
+{
+    mCurrentRow = new Field[mFieldCount];
+    MANGOS_ASSERT(mCurrentRow);
+
+    MYSQL_FIELD* fields = mysql_fetch_fields(metadata);
+    for (uint32 i = 0; i < mFieldCount; ++i)
+    {
+        mCurrentRow[i].SetType(QueryResultMysql::ConvertNativeType(fields[i].type));
+
+        Column& column = mColumns[i];
+        switch (fields[i].type)
+        {
+            case MYSQL_TYPE_TINY:
+            case MYSQL_TYPE_SHORT:
+            case MYSQL_TYPE_INT24:
+            case MYSQL_TYPE_LONG:
+            case MYSQL_TYPE_LONGLONG:
+                column.storage = (fields[i].flags & UNSIGNED_FLAG) ? COLUMN_UINT : COLUMN_INT;
+                break;
+            case MYSQL_TYPE_FLOAT:
+                column.storage = COLUMN_FLOAT;
+                break;
+            case MYSQL_TYPE_DOUBLE:
+                column.storage = COLUMN_DOUBLE;
+                break;
+            default:
+                // decimals, temporal types and strings are converted to text by the client library
+                column.storage = COLUMN_TEXT;
+                column.text.resize(std::max<unsigned long>(fields[i].max_length, 32) + 1);
+                break;
+        }
+
+        BindColumn(i);
+    }
+
+    mysql_free_result(metadata);
+
+    if (mysql_stmt_bind_result(mStmt, mBinds.data()))
+    {
+        sLog.outErrorDb("SQL ERROR: mysql_stmt_bind_result() failed: %s", mysql_stmt_error(mStmt));
+        EndQuery();
+    }
+}
+
+QueryResultMysqlStmt::~QueryResultMysqlStmt()
+{
+    EndQuery();
+}
+
+void QueryResultMysqlStmt::BindColumn(uint32 index)
+{
+    Column& column = mColumns[index];
+    MYSQL_BIND& bind = mBinds[index];
+
+    memset(&bind, 0, sizeof(MYSQL_BIND));
+    bind.is_null = &column.isNull;
+    bind.error = &column.error;
+    bind.length = &column.length;
+
+    switch (column.storage)
+    {
+        case COLUMN_INT:
+        case COLUMN_UINT:
+            bind.buffer_type = MYSQL_TYPE_LONGLONG;
+            bind.buffer = &column.number.i;
+            bind.is_unsigned = column.storage == COLUMN_UINT;
+            break;
+        case COLUMN_FLOAT:
+            bind.buffer_type = MYSQL_TYPE_FLOAT;
+            bind.buffer = &column.number.f;
+            break;
+        case COLUMN_DOUBLE:
+            bind.buffer_type = MYSQL_TYPE_DOUBLE;
+            bind.buffer = &column.number.d;
+            break;
+        case COLUMN_TEXT:
+            bind.buffer_type = MYSQL_TYPE_STRING;
+            bind.buffer = column.text.data();
+            bind.buffer_length = column.text.size() - 1;    // keep room for the terminator
+            break;
+    }
+}
+
+bool QueryResultMysqlStmt::NextRow()
+{
+    if (!mStmt)
+        return false;
+
+    int status = mysql_stmt_fetch(mStmt);
+    if (status == MYSQL_DATA_TRUNCATED)
+    {
+        // text longer than reported by the metadata, grow the buffer and fetch the column again
+        bool rebind = false;
+        for (uint32 i = 0; i < mFieldCount; ++i)
+        {
+            Column& column = mColumns[i];
+            if (!column.error || column.storage != COLUMN_TEXT)
+                continue;
+
+            column.text.resize(column.length + 1);
+            BindColumn(i);
+            mysql_stmt_fetch_column(mStmt, &mBinds[i], i, 0);
+            rebind = true;
+        }
+
+        if (rebind)
+            mysql_stmt_bind_result(mStmt, mBinds.data());
+    }
+    else if (status != 0)
+    {
+        if (status == 1)
+            sLog.outErrorDb("SQL ERROR: mysql_stmt_fetch() failed: %s", mysql_stmt_error(mStmt));
+
+        EndQuery();
+        return false;
+    }
+
+    for (uint32 i = 0; i < mFieldCount; ++i)
+    {
+        Column& column = mColumns[i];
+        Field& field = mCurrentRow[i];
+
+        if (column.isNull)
+        {
+            if (column.storage == COLUMN_TEXT)
+                field.SetValue(nullptr);
+            else
+                field.SetBinaryNull();
+            continue;
+        }
+
+        switch (column.storage)
+        {
+            case COLUMN_INT:    field.SetBinaryValue(column.number.i); break;
+            case COLUMN_UINT:   field.SetBinaryValue(uint64(column.number.i)); break;
+            case COLUMN_FLOAT:  field.SetBinaryValue(column.number.f); break;
+            case COLUMN_DOUBLE: field.SetBinaryValue(column.number.d); break;
+            case COLUMN_TEXT:
+                column.text[std::min<size_t>(column.length, column.text.size() - 1)] = '\0';
+                field.SetValue(column.text.data());
+                break;
+        }
+    }
+
+    return true;
+}
+
+void QueryResultMysqlStmt::EndQuery()
+{
+    delete[] mCurrentRow;
+    mCurrentRow = nullptr;
+
+    if (mStmt)
+    {
+        // closing sends COM_STMT_CLOSE, other threads may be using the connection by now
+        SqlConnection::Lock guard(mConn);
+        mysql_stmt_free_result(mStmt);
+        mysql_stmt_close(mStmt);
+        mStmt = nullptr;
+    }
+}
 #endif
@@ -29,6 +29,10 @@
 
 #include <mysql.h>
 
+#include <vector>
+
+class SqlConnection;
+
 class QueryResultMysql : public QueryResult
 {
     public:
@@ -38,11 +42,59 @@ class QueryResultMysql : public QueryResult
 
         bool NextRow() override;
 
+        static enum Field::DataTypes ConvertNativeType(enum_field_types mysqlType);
+
     private:
-        enum Field::DataTypes ConvertNativeType(enum_field_types mysqlType) const;
         void EndQuery();
 
         MYSQL_RES* mResult;
 };
+
+// Result of a query executed as server side statement, rows arrive in the binary protocol
+// and numeric columns are bound to typed buffers so Field getters do not parse text
+class QueryResultMysqlStmt : public QueryResult
+{
+    public:
+        // takes ownership of an executed statement with stored result, the statement is closed
+        // under the lock of the connection it was prepared on
+        QueryResultMysqlStmt(SqlConnection* conn, MYSQL_STMT* stmt, MYSQL_RES* metadata, uint64 rowCount, uint32 fieldCount);
+
+        ~QueryResultMysqlStmt();
+
+        bool NextRow() override;
+
+    private:
+        enum ColumnStorage
+        {
+            COLUMN_INT,
+            COLUMN_UINT,
+            COLUMN_FLOAT,
+            COLUMN_DOUBLE,
+            COLUMN_TEXT
+        };
+
+        struct Column
+        {
+            ColumnStorage storage;
+            union
+            {
+                int64 i;
+                float f;
+                double d;
+            } number;
+            std::vector<char> text;
+            unsigned long length;
+            my_bool isNull;
+            my_bool error;
+        };
+
+        void EndQuery();
+        void BindColumn(uint32 index);
+
+        SqlConnection* mConn;
+        MYSQL_STMT* mStmt;
+        std::vector<Column> mColumns;
+        std::vector<MYSQL_BIND> mBinds;
+};
 #endif
 #endif
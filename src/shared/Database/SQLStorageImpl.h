@@ -22,6 +22,7 @@
 #include "ProgressBar.h"
 #include "Log.h"
 #include "DBCFileLoader.h"
+#include "SQLStorageSnapshot.h"
 
 template<class DerivedLoader, class StorageClass>
 template<class S, class D>                                  // S source-type, D destination-type
@@ -214,28 +215,35 @@ template<class DerivedLoader, class StorageClass>
 void SQLStorageLoaderBase<DerivedLoader, StorageClass>::Load(StorageClass& store, bool error_at_empty /*= true*/)
 {
     Field* fields = nullptr;
-    QueryResult* result  = WorldDatabase.PQuery("SELECT MAX(%s) FROM %s", store.EntryFieldName(), store.GetTableName());
-    if (!result)
-    {
-        sLog.outError("Error loading %s table (not exist?)\n", store.GetTableName());
-        Log::WaitBeforeContinueIfNeed();
-        exit(1);                                            // Stop server at loading non exited table or not accessable table
-    }
-
-    uint32 maxRecordId = (*result)[0].GetUInt32() + 1;
+    uint32 maxRecordId = 0;
     uint32 recordCount = 0;
     uint32 recordsize = 0;
-    delete result;
 
-    result = WorldDatabase.PQuery("SELECT COUNT(*) FROM %s", store.GetTableName());
-    if (result)
+    SQLStorageSnapshot snapshot(store.GetTableName(), store.GetSrcFormat());
+    QueryResult* result = snapshot.Read(maxRecordId, recordCount);
+    if (!result)
     {
-        fields = result->Fetch();
-        recordCount = fields[0].GetUInt32();
+        result = WorldDatabase.PQuery("SELECT MAX(%s) FROM %s", store.EntryFieldName(), store.GetTableName());
+        if (!result)
+        {
+            sLog.outError("Error loading %s table (not exist?)\n", store.GetTableName());
+            Log::WaitBeforeContinueIfNeed();
+            exit(1);                                        // Stop server at loading non exited table or not accessable table
+        }
+
+        maxRecordId = (*result)[0].GetUInt32() + 1;
         delete result;
-    }
 
-    result = WorldDatabase.PQuery("SELECT * FROM %s", store.GetTableName());
+        result = WorldDatabase.PQuery("SELECT COUNT(*) FROM %s", store.GetTableName());
+        if (result)
+        {
+            fields = result->Fetch();
+            recordCount = fields[0].GetUInt32();
+            delete result;
+        }
+
+        result = WorldDatabase.PQuery("SELECT * FROM %s", store.GetTableName());
+    }
 
     if (!result)
     {
@@ -301,6 +309,7 @@ void SQLStorageLoaderBase<DerivedLoader, StorageClass>::Load(StorageClass& store
     {
         fields = result->Fetch();
         bar.step();
+        snapshot.AddRow(fields);
 
         char* record = store.createRecord(fields[0].GetUInt32());
         offset = 0;
@@ -353,6 +362,7 @@ void SQLStorageLoaderBase<DerivedLoader, StorageClass>::Load(StorageClass& store
     while (result->NextRow());
 
     delete result;
+    snapshot.Write(maxRecordId);
 }
 
 #endif
@@ -0,0 +1,294 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "SQLStorageSnapshot.h"
+#include "DatabaseEnv.h"
+#include "DBCFileLoader.h"
+#include "Config/Config.h"
+#include "Log.h"
+
+#include <cstdio>
+
+#define SNAPSHOT_MAGIC      0x504E5353                      // "SSNP"
+#define SNAPSHOT_VERSION    1
+
+namespace
+{
+    // magic, version, table checksum, payload hash, max record id, row count
+    size_t const SNAPSHOT_HEADER_SIZE = 4 + 4 + 8 + 8 + 4 + 4;
+
+    uint64 HashPayload(char const* data, size_t size)
+    {
+        // FNV-1a, only has to notice truncated or damaged files
+        uint64 hash = 14695981039346656037ULL;
+        for (size_t i = 0; i < size; ++i)
+        {
+            hash ^= uint8(data[i]);
+            hash *= 1099511628211ULL;
+        }
+        return hash;
+    }
+
+    template<typename T>
+    void Append(std::vector<char>& buffer, T value)
+    {
+        char const* bytes = reinterpret_cast<char const*>(&value);
+        buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+    }
+
+    template<typename T>
+    bool Extract(std::vector<char> const& buffer, size_t& pos, T& value)
+    {
+        if (buffer.size() - pos < sizeof(T))
+            return false;
+
+        memcpy(&value, &buffer[pos], sizeof(T));
+        pos += sizeof(T);
+        return true;
+    }
+}
+
+// decodes the rows of a snapshot into binary fields, strings point into the file buffer
+class SQLStorageSnapshotResult : public QueryResult
+{
+    public:
+        SQLStorageSnapshotResult(std::vector<char>& buffer, size_t payloadPos, uint32 rowCount, char const* srcFormat) :
+            QueryResult(rowCount, strlen(srcFormat)), m_srcFormat(srcFormat), m_pos(payloadPos), m_rowsLeft(rowCount)
+        {
+            m_buffer.swap(buffer);
+            m_fields = new Field[mFieldCount];
+            mCurrentRow = m_fields;
+        }
+
+        ~SQLStorageSnapshotResult() { delete[] m_fields; }
+
+        bool NextRow() override
+        {
+            if (!m_rowsLeft)
+                return false;
+
+            --m_rowsLeft;
+            for (uint32 i = 0; i < mFieldCount; ++i)
+            {
+                Field& field = m_fields[i];
+                switch (m_srcFormat[i])
+                {
+                    case FT_LOGIC:
+                    case FT_INT:
+                    {
+                        uint32 value = 0;
+                        Extract(m_buffer, m_pos, value);
+                        field.SetBinaryValue(uint64(value));
+                        break;
+                    }
+                    case FT_BYTE:
+                    {
+                        uint8 value = 0;
+                        Extract(m_buffer, m_pos, value);
+                        field.SetBinaryValue(uint64(value));
+                        break;
+                    }
+                    case FT_FLOAT:
+                    {
+                        float value = 0.0f;
+                        Extract(m_buffer, m_pos, value);
+                        field.SetBinaryValue(value);
+                        break;
+                    }
+                    case FT_64BITINT:
+                    {
+                        uint64 value = 0;
+                        Extract(m_buffer, m_pos, value);
+                        field.SetBinaryValue(value);
+                        break;
+                    }
+                    case FT_STRING:
+                    {
+                        // the payload hash was checked, so the stored lengths stay inside the buffer
+                        uint32 length = 0;
+                        Extract(m_buffer, m_pos, length);
+                        field.SetValue(&m_buffer[m_pos]);
+                        m_pos += length + 1;
+                        break;
+                    }
+                    default:
+                        // columns the loader skips are not stored
+                        field.SetValue(nullptr);
+                        break;
+                }
+            }
+            return true;
+        }
+
+    private:
+        char const* m_srcFormat;
+        std::vector<char> m_buffer;
+        size_t m_pos;
+        uint32 m_rowsLeft;
+        Field* m_fields;
+};
+
+SQLStorageSnapshot::SQLStorageSnapshot(char const* tableName, char const* srcFormat) :
+    m_tableName(tableName), m_srcFormat(srcFormat), m_tableChecksum(0), m_collect(false), m_rowCount(0)
+{
+}
+
+QueryResult* SQLStorageSnapshot::Read(uint32& maxRecordId, uint32& recordCount)
+{
+    std::string dir = sConfig.GetStringDefault("WorldSnapshotDir");
+    if (dir.empty())
+        return nullptr;
+
+    if (dir.at(dir.length() - 1) != '/' && dir.at(dir.length() - 1) != '\\')
+        dir.append("/");
+    m_fileName = dir + m_tableName + ".snapshot";
+
+    // MySQL only, other databases just keep loading from the tables
+    QueryResult* result = WorldDatabase.PQuery("CHECKSUM TABLE %s", m_tableName);
+    if (!result)
+        return nullptr;
+
+    Field* fields = result->Fetch();
+    bool known = result->GetFieldCount() > 1 && !fields[1].IsNULL();
+    m_tableChecksum = known ? fields[1].GetUInt64() : 0;
+    delete result;
+
+    if (!known)
+        return nullptr;
+
+    // from here on rows read from the database replace a missing or outdated file
+    m_collect = true;
+
+    FILE* file = fopen(m_fileName.c_str(), "rb");
+    if (!file)
+        return nullptr;
+
+    std::vector<char> buffer;
+    fseek(file, 0, SEEK_END);
+    long fileSize = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    if (fileSize > 0)
+    {
+        buffer.resize(fileSize);
+        if (fread(&buffer[0], 1, buffer.size(), file) != buffer.size())
+            buffer.clear();
+    }
+    fclose(file);
+
+    size_t pos = 0;
+    uint32 magic = 0, version = 0, rowCount = 0, maxEntry = 0;
+    uint64 tableChecksum = 0, payloadHash = 0;
+    if (!Extract(buffer, pos, magic) || magic != SNAPSHOT_MAGIC ||
+            !Extract(buffer, pos, version) || version != SNAPSHOT_VERSION ||
+            !Extract(buffer, pos, tableChecksum) || tableChecksum != m_tableChecksum ||
+            !Extract(buffer, pos, payloadHash) ||
+            !Extract(buffer, pos, maxEntry) ||
+            !Extract(buffer, pos, rowCount) || !rowCount)
+        return nullptr;
+
+    // the source format is part of the file so changed column layouts are never mixed up
+    size_t formatLength = strlen(m_srcFormat) + 1;
+    if (buffer.size() - pos < formatLength || memcmp(&buffer[pos], m_srcFormat, formatLength) != 0)
+        return nullptr;
+    pos += formatLength;
+
+    if (HashPayload(buffer.data() + pos, buffer.size() - pos) != payloadHash)
+    {
+        sLog.outError("Snapshot %s is damaged, reading `%s` from the database", m_fileName.c_str(), m_tableName);
+        return nullptr;
+    }
+
+    m_collect = false;
+    maxRecordId = maxEntry;
+    recordCount = rowCount;
+
+    result = new SQLStorageSnapshotResult(buffer, pos, rowCount, m_srcFormat);
+    result->NextRow();
+
+    DETAIL_LOG("Table `%s` loaded from snapshot %s", m_tableName, m_fileName.c_str());
+    return result;
+}
+
+void SQLStorageSnapshot::AddRow(Field const* fields)
+{
+    if (!m_collect)
+        return;
+
+    ++m_rowCount;
+    for (uint32 i = 0; m_srcFormat[i]; ++i)
+    {
+        switch (m_srcFormat[i])
+        {
+            case FT_LOGIC:
+            case FT_INT:        Append(m_rows, fields[i].GetUInt32());  break;
+            case FT_BYTE:       Append(m_rows, fields[i].GetUInt8());   break;
+            case FT_FLOAT:      Append(m_rows, fields[i].GetFloat());   break;
+            case FT_64BITINT:   Append(m_rows, fields[i].GetUInt64());  break;
+            case FT_STRING:
+            {
+                char const* value = fields[i].GetString();
+                uint32 length = strlen(value);
+                Append(m_rows, length);
+                m_rows.insert(m_rows.end(), value, value + length + 1);
+                break;
+            }
+            default:
+                break;
+        }
+    }
+}
+
+void SQLStorageSnapshot::Write(uint32 maxRecordId)
+{
+    if (!m_collect || !m_rowCount)
+        return;
+
+    std::vector<char> header;
+    header.reserve(SNAPSHOT_HEADER_SIZE + strlen(m_srcFormat) + 1);
+    Append(header, uint32(SNAPSHOT_MAGIC));
+    Append(header, uint32(SNAPSHOT_VERSION));
+    Append(header, m_tableChecksum);
+    Append(header, HashPayload(m_rows.data(), m_rows.size()));
+    Append(header, maxRecordId);
+    Append(header, m_rowCount);
+    header.insert(header.end(), m_srcFormat, m_srcFormat + strlen(m_srcFormat) + 1);
+
+    // write next to the old file and swap, a crash while writing leaves no half file behind
+    std::string tmpName = m_fileName + ".tmp";
+    FILE* file = fopen(tmpName.c_str(), "wb");
+    if (!file)
+    {
+        sLog.outError("Can't write snapshot %s, check WorldSnapshotDir", tmpName.c_str());
+        return;
+    }
+
+    bool written = fwrite(header.data(), 1, header.size(), file) == header.size() &&
+                   fwrite(m_rows.data(), 1, m_rows.size(), file) == m_rows.size();
+    written = fclose(file) == 0 && written;
+
+    std::remove(m_fileName.c_str());
+    if (!written || std::rename(tmpName.c_str(), m_fileName.c_str()) != 0)
+    {
+        sLog.outError("Can't write snapshot %s, check WorldSnapshotDir", m_fileName.c_str());
+        std::remove(tmpName.c_str());
+        return;
+    }
+
+    std::vector<char>().swap(m_rows);
+    DETAIL_LOG("Table `%s` written to snapshot %s", m_tableName, m_fileName.c_str());
+}
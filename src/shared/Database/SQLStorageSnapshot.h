@@ -0,0 +1,53 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef SQLSTORAGESNAPSHOT_H
+#define SQLSTORAGESNAPSHOT_H
+
+#include "Common.h"
+#include "Database/QueryResult.h"
+
+// Raw rows of one SQLStorage table, kept in a file in WorldSnapshotDir next to the
+// checksum the database reported for the table when they were read. The rows are
+// fed through the regular loader again, so conversions that depend on other data
+// (script names, defaults of derived loaders) are redone at every start.
+class SQLStorageSnapshot
+{
+    public:
+        SQLStorageSnapshot(char const* tableName, char const* srcFormat);
+
+        // rows of an up to date snapshot positioned at the first row,
+        // nullptr if the table has to be read from the database
+        QueryResult* Read(uint32& maxRecordId, uint32& recordCount);
+
+        // rows read from the database are collected and written by Write when the snapshot was outdated
+        void AddRow(Field const* fields);
+        void Write(uint32 maxRecordId);
+
+    private:
+        char const* m_tableName;
+        char const* m_srcFormat;
+        std::string m_fileName;
+
+        uint64 m_tableChecksum;
+        bool m_collect;
+        uint32 m_rowCount;
+        std::vector<char> m_rows;
+};
+
+#endif
@@ -20,7 +20,10 @@
 #include "Database/SqlOperations.h"
 #include "DatabaseEnv.h"
 
-SqlDelayThread::SqlDelayThread(Database* db, SqlConnection* conn) : m_dbEngine(db), m_dbConnection(conn), m_running(true)
+#include <chrono>
+
+SqlDelayThread::SqlDelayThread(Database* db, SqlConnection* conn, bool pingDatabase) : m_queuedWrites(0), m_doneWrites(0),
+    m_dbEngine(db), m_dbConnection(conn), m_pingDatabase(pingDatabase), m_running(true), m_stopped(false)
 {
 }
 
@@ -36,39 +39,71 @@ void SqlDelayThread::run()
     mysql_thread_init();
 #endif
 
-    const uint32 loopSleepms = 10;
-
-    const uint32 pingEveryLoop = m_dbEngine->GetPingIntervall() / loopSleepms;
+    // MaxPingTime = 0 used to ping on every 10ms loop, keep a sane lower bound now that the loop only wakes on demand
+    const std::chrono::milliseconds pingInterval(std::max(m_dbEngine->GetPingIntervall(), uint32(1000)));
+    auto nextPing = std::chrono::steady_clock::now() + pingInterval;
 
-    uint32 loopCounter = 0;
     while (m_running)
     {
+        // sleep until there is something to execute, a ping is due or the thread is stopped
+        {
+            std::unique_lock<std::mutex> lock(m_queueMutex);
+            m_queueCondition.wait_until(lock, nextPing, [this] { return !m_sqlQueue.empty() || !m_running; });
+        }
+
         // if the running state gets turned off while sleeping
         // empty the queue before exiting
-        MaNGOS::Thread::Sleep(loopSleepms);
-
         ProcessRequests();
 
-        if ((loopCounter++) >= pingEveryLoop)
+        if (std::chrono::steady_clock::now() >= nextPing)
         {
-            loopCounter = 0;
-            m_dbEngine->Ping();
+            nextPing = std::chrono::steady_clock::now() + pingInterval;
+            if (m_pingDatabase)
+                m_dbEngine->Ping();
         }
     }
 
+    // requests queued after the last pass are executed on delete, threads waiting for writes of this one give up
+    {
+        std::lock_guard<std::mutex> guard(m_queueMutex);
+        m_stopped = true;
+    }
+    m_doneCondition.notify_all();
+
 #ifndef DO_POSTGRESQL
     mysql_thread_end();
 #endif
 }
 
+bool SqlDelayThread::Delay(SqlOperation* sql, bool write)
+{
+    std::vector<uint64> fences;
+    fences.reserve(m_fenceThreads.size());
+    for (SqlDelayThread* thread : m_fenceThreads)
+        fences.push_back(thread->GetQueuedWrites());
+
+    {
+        std::lock_guard<std::mutex> guard(m_queueMutex);
+        m_sqlQueue.push({ std::move(fences), std::unique_ptr<SqlOperation>(sql), write });
+        if (write)
+            ++m_queuedWrites;
+    }
+    m_queueCondition.notify_one();
+    return true;
+}
+
 void SqlDelayThread::Stop()
 {
-    m_running = false;
+    {
+        std::lock_guard<std::mutex> guard(m_queueMutex);
+        m_running = false;
+    }
+    m_queueCondition.notify_one();
 }
 
 void SqlDelayThread::ProcessRequests()
 {
-    std::queue<std::unique_ptr<SqlOperation>> sqlQueue;
+    std::queue<QueuedOperation> sqlQueue;
 
     // we need to move the contents of the queue to a local copy because executing these statements with the
     // lock in place can result in a deadlock with the world thread which calls Database::ProcessResultQueue()
@@ -79,8 +114,23 @@ void SqlDelayThread::ProcessRequests()
 
     while (!sqlQueue.empty())
     {
-        auto const s = std::move(sqlQueue.front());
+        QueuedOperation const op = std::move(sqlQueue.front());
         sqlQueue.pop();
-        s->Execute(m_dbConnection);
+
+        // a statement must see the writes its caller issued before it on the other threads
+        for (size_t i = 0; i < op.fences.size() && i < m_fenceThreads.size(); ++i)
+            if (op.fences[i])
+                m_fenceThreads[i]->WaitForWrites(op.fences[i]);
+
+        op.sql->Execute(m_dbConnection);
+
+        if (op.write)
+        {
+            {
+                std::lock_guard<std::mutex> guard(m_queueMutex);
+                ++m_doneWrites;
+            }
+            m_doneCondition.notify_all();
+        }
     }
 }
@@ -22,9 +22,11 @@
 #include "Threading.h"
 #include "SqlOperations.h"
 
+#include <condition_variable>
 #include <mutex>
 #include <queue>
 #include <memory>
+#include <vector>
 
 class Database;
 class SqlOperation;
@@ -33,26 +35,51 @@ class SqlConnection;
 class SqlDelayThread : public MaNGOS::Runnable
 {
     private:
+        struct QueuedOperation
+        {
+            std::vector<uint64> fences;                         ///< Writes of each fence thread to wait for
+            std::unique_ptr<SqlOperation> sql;
+            bool write;
+        };
+
         std::mutex m_queueMutex;
-        std::queue<std::unique_ptr<SqlOperation>> m_sqlQueue;   ///< Queue of SQL statements
+        std::condition_variable m_queueCondition;               ///< Signaled on new statements and on stop
+        std::queue<QueuedOperation> m_sqlQueue;                 ///< Queue of SQL statements and their write fences
+        std::condition_variable m_doneCondition;                ///< Signaled when a write was executed and on exit
+        uint64 m_queuedWrites;                                  ///< Writes queued so far
+        uint64 m_doneWrites;                                    ///< Writes executed so far
+        std::vector<SqlDelayThread*> m_fenceThreads;            ///< Threads whose earlier writes run before the statements of this one
         Database* m_dbEngine;                                   ///< Pointer to used Database engine
         SqlConnection* m_dbConnection;                          ///< Pointer to DB connection
+        bool m_pingDatabase;                                    ///< Only one delay thread per Database keeps the connections alive
         volatile bool m_running;
+        bool m_stopped;                                         ///< Run loop has exited, nothing waits for its writes anymore
 
         // process all enqueued requests
         void ProcessRequests();
 
+        uint64 GetQueuedWrites()
+        {
+            std::lock_guard<std::mutex> guard(m_queueMutex);
+            return m_queuedWrites;
+        }
+
+        ///< Block until the first count writes of this thread were executed or the thread has stopped
+        void WaitForWrites(uint64 count)
+        {
+            std::unique_lock<std::mutex> lock(m_queueMutex);
+            m_doneCondition.wait(lock, [this, count] { return m_doneWrites >= count || m_stopped; });
+        }
+
     public:
-        SqlDelayThread(Database* db, SqlConnection* conn);
+        SqlDelayThread(Database* db, SqlConnection* conn, bool pingDatabase = true);
         ~SqlDelayThread();
 
+        ///< Statements of this thread wait for the writes these threads had queued when they were delayed
+        void SetFenceThreads(std::vector<SqlDelayThread*> const& threads) { m_fenceThreads = threads; }
+
         ///< Put sql statement to delay queue
-        bool Delay(SqlOperation* sql)
-        {
-            std::lock_guard<std::mutex> guard(m_queueMutex);
-            m_sqlQueue.push(std::unique_ptr<SqlOperation>(sql));
-            return true;
-        }
+        bool Delay(SqlOperation* sql, bool write = false);
 
         virtual void Stop();                                ///< Stop event
         virtual void run();                                 ///< Main Thread loop
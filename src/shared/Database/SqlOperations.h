@@ -58,12 +58,16 @@ class SqlTransaction : public SqlOperation
 {
     private:
         std::vector<SqlOperation* > m_queue;
+        size_t m_bytes;                                     // query text and bound parameters
 
     public:
-        SqlTransaction() {}
+        SqlTransaction() : m_bytes(0) {}
         ~SqlTransaction();
 
-        void DelayExecute(SqlOperation* sql) { m_queue.push_back(sql); }
+        void DelayExecute(SqlOperation* sql, size_t bytes) { m_queue.push_back(sql); m_bytes += bytes; }
+
+        size_t GetStatementCount() const { return m_queue.size(); }
+        size_t GetByteCount() const { return m_bytes; }
 
         bool Execute(SqlConnection* conn) override;
 };
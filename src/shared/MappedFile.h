@@ -0,0 +1,61 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_MAPPEDFILE_H
+#define MANGOS_MAPPEDFILE_H
+
+#include "Platform/Define.h"
+
+#include <cstddef>
+
+// View of a whole file mapped into memory. The pages are backed by the file itself,
+// so they are loaded on first access and shared with every other mapping of the same file.
+// A copy on write view may be modified, only the pages written to get private copies.
+class MappedFile
+{
+    public:
+        MappedFile();
+        ~MappedFile();
+
+        MappedFile(MappedFile const&) = delete;
+        MappedFile& operator=(MappedFile const&) = delete;
+
+        // returns false if the file does not exist, is empty or can not be mapped
+        bool Open(char const* filename, bool copyOnWrite = false);
+        void Close();
+
+        bool IsOpen() const { return m_data != nullptr; }
+        uint8 const* GetData() const { return m_data; }
+        size_t GetSize() const { return m_size; }
+
+        // nullptr unless opened copy on write, writes are never stored to the file
+        uint8* GetWritableData() const { return m_copyOnWrite ? m_data : nullptr; }
+
+        // reads every page once, so later accesses do not block on disk
+        void Preload() const;
+
+    private:
+        uint8* m_data;
+        size_t m_size;
+        bool m_copyOnWrite;
+#ifdef _WIN32
+        void* m_mapping;
+#endif
+};
+
+#endif
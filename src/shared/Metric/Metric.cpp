@@ -17,9 +17,11 @@
  */
 
 #include <boost/date_time/posix_time/posix_time.hpp>
+#include <algorithm>
 #include <functional>
 
 #include "Config/Config.h"
+#include "Errors.h"
 #include "Log.h"
 #include "Metric.h"
 
@@ -74,13 +76,43 @@ void metric::measurement::set_condition(std::function<bool()> condition)
     m_condition = std::move(condition);
 }
 
+// handles owned by singletons can be destroyed after the metric instance at exit
+static std::atomic<bool> s_metricAlive(false);
+
+metric::handle::handle(std::string name, std::vector<std::string> fields, std::map<std::string, std::string> tags, uint32 textFields)
+    : m_id(metric::instance().register_handle(std::move(name), std::move(fields), std::move(tags), textFields))
+{
+}
+
+metric::handle::~handle()
+{
+    if (m_id && s_metricAlive)
+        metric::instance().release_handle(m_id);
+}
+
+void metric::handle::record(std::initializer_list<int64> values) const
+{
+    record(values.begin(), values.size());
+}
+
+void metric::handle::record(int64 const* values, size_t count) const
+{
+    if (m_id)
+        metric::instance().record(m_id, values, count);
+}
+
+const size_t metric::metric::MAX_HANDLE_FIELDS;
+
 metric::metric::metric()
 {
     initialize();
+    s_metricAlive = true;
 }
 
 metric::metric::~metric()
 {
+    s_metricAlive = false;
+
     if (!m_enabled)
         return;
 
@@ -147,6 +179,135 @@ void metric::metric::report(std::string measurement, std::map<std::string, boost
     });
 }
 
+uint32 metric::metric::register_handle(std::string name, std::vector<std::string> fields, std::map<std::string, std::string> tags, uint32 textFields)
+{
+    if (!m_enabled)
+        return 0;
+
+    MANGOS_ASSERT(!fields.empty() && fields.size() <= MAX_HANDLE_FIELDS);
+
+    std::lock_guard<std::mutex> guard(m_handleLock);
+
+    auto key = std::make_pair(name, tags);
+    auto itr = m_handleIds.find(key);
+    if (itr != m_handleIds.end())
+    {
+        ++m_handles[itr->second - 1].references;
+        return itr->second;
+    }
+
+    handle_info info = { std::move(name), std::move(tags), std::move(fields), textFields, 1 };
+
+    uint32 id;
+    if (!m_freeHandleIds.empty())
+    {
+        id = m_freeHandleIds.back();
+        m_freeHandleIds.pop_back();
+        m_handles[id - 1] = std::move(info);
+    }
+    else
+    {
+        m_handles.push_back(std::move(info));
+        id = uint32(m_handles.size());
+    }
+
+    m_handleIds.emplace(std::move(key), id);
+    return id;
+}
+
+void metric::metric::release_handle(uint32 id)
+{
+    std::lock_guard<std::mutex> guard(m_handleLock);
+
+    handle_info& info = m_handles[id - 1];
+    if (--info.references)
+        return;
+
+    // samples may still wait in the rings, the id is freed by the next drain
+    m_handleIds.erase(std::make_pair(info.name, info.tags));
+    m_releasedHandleIds.push_back(id);
+}
+
+metric::metric::sample_ring* metric::metric::thread_ring()
+{
+    static thread_local sample_ring* ring = nullptr;
+    if (!ring)
+    {
+        std::unique_ptr<sample_ring> newRing(new sample_ring);
+        ring = newRing.get();
+
+        std::lock_guard<std::mutex> guard(m_ringLock);
+        m_rings.push_back(std::move(newRing));
+    }
+
+    return ring;
+}
+
+void metric::metric::record(uint32 id, int64 const* values, size_t count)
+{
+    sample_ring* ring = thread_ring();
+
+    uint32 head = ring->head.load(std::memory_order_relaxed);
+    if (head - ring->tail.load(std::memory_order_acquire) >= SAMPLE_RING_SIZE)
+    {
+        ++ring->dropped;
+        return;
+    }
+
+    sample& entry = ring->samples[head % SAMPLE_RING_SIZE];
+    entry.handle = id;
+    entry.count = uint32(std::min(count, MAX_HANDLE_FIELDS));
+    entry.timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+    std::copy(values, values + entry.count, entry.values);
+
+    ring->head.store(head + 1, std::memory_order_release);
+}
+
+void metric::metric::drain_rings(std::vector<std::unique_ptr<Measurement>>& measurements)
+{
+    std::lock_guard<std::mutex> ringGuard(m_ringLock);
+    std::lock_guard<std::mutex> handleGuard(m_handleLock);
+
+    uint64 dropped = 0;
+    for (auto const& ring : m_rings)
+    {
+        uint32 tail = ring->tail.load(std::memory_order_relaxed);
+        uint32 head = ring->head.load(std::memory_order_acquire);
+
+        for (; tail != head; ++tail)
+        {
+            sample const& entry = ring->samples[tail % SAMPLE_RING_SIZE];
+            handle_info const& info = m_handles[entry.handle - 1];
+
+            std::map<std::string, boost::any> fields;
+            for (uint32 i = 0; i < entry.count && i < info.fields.size(); ++i)
+            {
+                if (info.textFields & (1 << i))
+                    fields.emplace(info.fields[i], std::to_string(entry.values[i]));
+                else
+                    fields.emplace(info.fields[i], entry.values[i]);
+            }
+
+            if (!fields.empty())
+                measurements.push_back(std::unique_ptr<Measurement>(new Measurement(info.name, info.tags, std::move(fields), entry.timestamp)));
+        }
+
+        ring->tail.store(tail, std::memory_order_release);
+        dropped += ring->dropped.exchange(0);
+    }
+
+    // everything recorded before these were released has been drained now
+    for (uint32 id : m_releasedHandleIds)
+    {
+        m_handles[id - 1] = handle_info();
+        m_freeHandleIds.push_back(id);
+    }
+    m_releasedHandleIds.clear();
+
+    if (dropped)
+        sLog.outDetail("metric::metric::drain_rings dropped %llu samples, rings were full", (unsigned long long)dropped);
+}
+
 void metric::metric::schedule_timer()
 {
     using namespace std::placeholders;
@@ -182,6 +343,8 @@ void metric::metric::send()
         std::swap(measurements, m_measurementQueue);
     }
 
+    drain_rings(measurements);
+
     sLog.outDetail("Sending %zu measurements!", measurements.size());
 
     using boost::asio::ip::tcp;
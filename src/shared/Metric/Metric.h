@@ -21,8 +21,12 @@
 
 #include <boost/any.hpp>
 #include <boost/asio.hpp>
+#include <array>
+#include <atomic>
 #include <chrono>
+#include <deque>
 #include <functional>
+#include <initializer_list>
 #include <iostream>
 #include <map>
 #include <thread>
@@ -105,8 +109,73 @@ namespace metric
             std::chrono::high_resolution_clock::time_point m_startTime;
     };
 
+    // Pre-registered measurement with a fixed tag set and numeric fields.
+    // Recording only copies the values into a ring buffer owned by the calling thread,
+    // the strings are built by the writer thread when the ring is drained.
+    // Fields whose bit is set in textFields are sent as text like the std::to_string values
+    // of older measurements, so series that already exist keep their field type.
+    // The registration is released when the last handle of a name and tag set is destroyed.
+    class handle
+    {
+        public:
+            handle() : m_id(0) {}
+            handle(std::string name, std::vector<std::string> fields, std::map<std::string, std::string> tags = {}, uint32 textFields = 0);
+            ~handle();
+
+            handle(handle const&) = delete;
+            handle& operator=(handle const&) = delete;
+
+            void record(std::initializer_list<int64> values) const;
+            void record(int64 const* values, size_t count) const;
+            bool enabled() const { return m_id != 0; }
+
+        private:
+            uint32 m_id;
+    };
+
+    // records the elapsed time into the first field of the handle, following fields can be set meanwhile
+    template <class precision>
+    class scoped_duration
+    {
+        public:
+            static const size_t MAX_FIELDS = 8;
+
+            scoped_duration(handle const& target)
+                : m_handle(target), m_count(1), m_startTime(std::chrono::high_resolution_clock::now())
+            {}
+
+            ~scoped_duration()
+            {
+                if (!m_handle.enabled())
+                    return;
+
+                auto endTime = std::chrono::high_resolution_clock::now();
+                m_values[0] = static_cast<int64>(std::chrono::duration_cast<precision>(endTime - m_startTime).count());
+                m_handle.record(m_values.data(), m_count);
+            }
+
+            void set(size_t index, int64 value)
+            {
+                if (index == 0 || index >= MAX_FIELDS)
+                    return;
+
+                m_values[index] = value;
+                if (index >= m_count)
+                    m_count = index + 1;
+            }
+
+        private:
+            handle const& m_handle;
+            std::array<int64, MAX_FIELDS> m_values = {};
+            size_t m_count;
+            std::chrono::high_resolution_clock::time_point m_startTime;
+    };
+
     class metric
     {
+        friend class handle;
+
+
         public:
             metric();
             ~metric();
@@ -133,6 +202,53 @@ namespace metric
             std::mutex m_queueWriteLock;
             std::vector<std::unique_ptr<Measurement>> m_measurementQueue;
 
+            static const size_t MAX_HANDLE_FIELDS = 8;
+            static const uint32 SAMPLE_RING_SIZE = 2048;
+
+            struct handle_info
+            {
+                std::string name;
+                std::map<std::string, std::string> tags;
+                std::vector<std::string> fields;
+                uint32 textFields;
+                uint32 references;
+            };
+
+            struct sample
+            {
+                uint32 handle;
+                uint32 count;
+                uint64 timestamp;
+                int64 values[MAX_HANDLE_FIELDS];
+            };
+
+            // written only by its owner thread, read only by the writer thread
+            struct sample_ring
+            {
+                std::array<sample, SAMPLE_RING_SIZE> samples;
+                std::atomic<uint32> head{0};
+                std::atomic<uint32> tail{0};
+                std::atomic<uint64> dropped{0};
+            };
+
+            // handles are interned by name and tags, re-registering an existing one returns the same id
+            // ids of released handles are reused once the samples recorded before the release were drained
+            std::mutex m_handleLock;
+            std::deque<handle_info> m_handles;
+            std::map<std::pair<std::string, std::map<std::string, std::string>>, uint32> m_handleIds;
+            std::vector<uint32> m_releasedHandleIds;
+            std::vector<uint32> m_freeHandleIds;
+
+            // rings outlive their threads, worker threads are long lived so there are few of them
+            std::mutex m_ringLock;
+            std::vector<std::unique_ptr<sample_ring>> m_rings;
+
+            uint32 register_handle(std::string name, std::vector<std::string> fields, std::map<std::string, std::string> tags, uint32 textFields);
+            void release_handle(uint32 id);
+            void record(uint32 id, int64 const* values, size_t count);
+            sample_ring* thread_ring();
+            void drain_rings(std::vector<std::unique_ptr<Measurement>>& measurements);
+
             void schedule_timer();
             void prepare_send(const boost::system::error_code& ec);
             void send();
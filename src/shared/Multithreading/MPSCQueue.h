@@ -0,0 +1,108 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_MPSCQUEUE_H
+#define MANGOS_MPSCQUEUE_H
+
+#include <atomic>
+#include <memory>
+
+template <class T>
+class MPSCQueue;
+
+// Link for MPSCQueue, queued types derive from it. Copies never share the link.
+class MPSCQueueNode
+{
+    public:
+        MPSCQueueNode() : m_queueNext(nullptr) {}
+        MPSCQueueNode(MPSCQueueNode const&) : m_queueNext(nullptr) {}
+        MPSCQueueNode& operator=(MPSCQueueNode const&) { return *this; }
+
+    private:
+        template <class T>
+        friend class MPSCQueue;
+
+        std::atomic<MPSCQueueNode*> m_queueNext;
+};
+
+// Intrusive lock free queue for any number of producer threads and one consumer thread at a time.
+// Push is a single exchange, Pop never blocks. The queue owns the queued items.
+template <class T>
+class MPSCQueue
+{
+    public:
+        MPSCQueue() : m_head(&m_stub), m_tail(&m_stub) {}
+        ~MPSCQueue()
+        {
+            while (Pop())
+                ;
+        }
+
+        MPSCQueue(MPSCQueue const&) = delete;
+        MPSCQueue& operator=(MPSCQueue const&) = delete;
+
+        // any thread
+        void Push(std::unique_ptr<T> item)
+        {
+            Link(item.release());
+        }
+
+        // consumer thread only, returns nullptr when empty or when the only pending push did not finish linking yet
+        std::unique_ptr<T> Pop()
+        {
+            MPSCQueueNode* tail = m_tail;
+            MPSCQueueNode* next = tail->m_queueNext.load(std::memory_order_acquire);
+            if (tail == &m_stub)
+            {
+                if (!next)
+                    return nullptr;
+                m_tail = next;
+                tail = next;
+                next = next->m_queueNext.load(std::memory_order_acquire);
+            }
+
+            if (!next)
+            {
+                if (tail != m_head.load(std::memory_order_acquire))
+                    return nullptr;
+
+                // last item, put the stub behind it so it can be unlinked
+                Link(&m_stub);
+                next = tail->m_queueNext.load(std::memory_order_acquire);
+                if (!next)
+                    return nullptr;
+            }
+
+            m_tail = next;
+            return std::unique_ptr<T>(static_cast<T*>(tail));
+        }
+
+    private:
+        void Link(MPSCQueueNode* node)
+        {
+            node->m_queueNext.store(nullptr, std::memory_order_relaxed);
+            MPSCQueueNode* prev = m_head.exchange(node, std::memory_order_acq_rel);
+            prev->m_queueNext.store(node, std::memory_order_release);
+        }
+
+        MPSCQueueNode m_stub;
+        std::atomic<MPSCQueueNode*> m_head;                 // last pushed node, producers side
+        MPSCQueueNode* m_tail;                              // next node to pop, consumer side
+};
+
+#endif
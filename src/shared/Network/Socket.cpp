@@ -34,7 +34,7 @@ namespace MaNGOS
 {
     Socket::Socket(boost::asio::io_service& service, std::function<void (Socket*)> closeHandler)
         : m_writeState(WriteState::Idle), m_readState(ReadState::Idle), m_socket(service),
-          m_closeHandler(std::move(closeHandler)), m_outBufferFlushTimer(service), m_address("0.0.0.0") {}
+          m_closeHandler(std::move(closeHandler)), m_sendQueueBytes(0), m_outBufferFlushTimer(service), m_address("0.0.0.0") {}
 
     bool Socket::Open()
     {
@@ -49,8 +49,6 @@ namespace MaNGOS
             return false;
         }
 
-        m_outBuffer.reset(new PacketBuffer);
-        m_secondaryOutBuffer.reset(new PacketBuffer);
         m_inBuffer.reset(new PacketBuffer);
 
         StartAsyncRead();
@@ -165,37 +163,106 @@ namespace MaNGOS
         return true;
     }
 
-    void Socket::Write(const char* header, int headerSize, const char* content, int contentSize)
+    void Socket::Write(const char* header, int headerSize, const char* content, int contentSize, SendLatency latency)
     {
         std::lock_guard<std::mutex> guard(m_mutex);
 
-        // get the correct buffer depending on the current writing state
-        PacketBuffer* outBuffer = m_writeState == WriteState::Sending ? m_secondaryOutBuffer.get() : m_outBuffer.get();
+        PacketBuffer* chunk = GetSendChunk(headerSize + contentSize);
 
         // write the header
-        outBuffer->Write(header, headerSize);
+        chunk->Write(header, headerSize);
 
         // write the content
-        outBuffer->Write(content, contentSize);
+        if (contentSize)
+            chunk->Write(content, contentSize);
 
-        // flush data if need
-        if (m_writeState == WriteState::Idle)
-            StartWriteFlushTimer();
+        m_sendQueueBytes += headerSize + contentSize;
+        ScheduleSend(latency);
     }
 
-    void Socket::Write(const char* buffer, int length)
+    void Socket::Write(const char* buffer, int length, SendLatency latency)
     {
         std::lock_guard<std::mutex> guard(m_mutex);
 
-        // get the correct buffer depending on the current writing state
-        PacketBuffer* outBuffer = m_writeState == WriteState::Sending ? m_secondaryOutBuffer.get() : m_outBuffer.get();
+        GetSendChunk(length)->Write(buffer, length);
 
-        // write the header
-        outBuffer->Write(buffer, length);
+        m_sendQueueBytes += length;
+        ScheduleSend(latency);
+    }
+
+// note that this function assumes that the socket mutex is locked
+    PacketBuffer* Socket::GetSendChunk(size_t length)
+    {
+        // small writes share the last queued chunk as long as it has room
+        if (!m_sendQueue.empty())
+        {
+            PacketBuffer* last = m_sendQueue.back().get();
+            if (last->m_buffer.size() - last->m_writePosition >= length)
+                return last;
+        }
 
-        // flush data if need
-        if (m_writeState == WriteState::Idle)
-            StartWriteFlushTimer();
+        std::unique_ptr<PacketBuffer> chunk;
+        if (!m_sendChunkPool.empty())
+        {
+            chunk = std::move(m_sendChunkPool.back());
+            m_sendChunkPool.pop_back();
+        }
+        else
+            chunk.reset(new PacketBuffer);
+
+        m_sendQueue.push_back(std::move(chunk));
+        return m_sendQueue.back().get();
+    }
+
+// note that this function assumes that the socket mutex is locked
+    void Socket::ScheduleSend(SendLatency latency)
+    {
+        bool sendNow = latency == SendLatency::Immediate || m_sendQueueBytes >= SendCoalesceLimit;
+
+        switch (m_writeState)
+        {
+            case WriteState::Sending:
+                // goes out with the next send started by OnWriteComplete
+                break;
+            case WriteState::Buffering:
+                if (sendNow)
+                    ForceFlushOut();
+                break;
+            case WriteState::Idle:
+                // a connection that has been quiet for a while has nothing to coalesce with
+                if (!sendNow && latency == SendLatency::Normal)
+                    sendNow = std::chrono::steady_clock::now() - m_lastSendTime >= std::chrono::milliseconds(BufferTimeout);
+
+                if (sendNow)
+                    StartSend();
+                else
+                    StartWriteFlushTimer();
+                break;
+        }
+    }
+
+// note that this function assumes that the socket mutex is locked
+    void Socket::StartSend()
+    {
+        // if the socket is closed, silently fail
+        if (IsClosed() || m_sendQueue.empty())
+        {
+            m_writeState = WriteState::Idle;
+            return;
+        }
+
+        m_writeState = WriteState::Sending;
+
+        std::swap(m_sendInFlight, m_sendQueue);
+        m_sendQueueBytes = 0;
+
+        m_sendBuffers.clear();
+        for (auto const& chunk : m_sendInFlight)
+            m_sendBuffers.push_back(boost::asio::buffer(chunk->m_buffer.data(), chunk->m_writePosition));
+
+        std::shared_ptr<Socket> ptr = shared<Socket>();
+        boost::asio::async_write(m_socket, m_sendBuffers, make_custom_alloc_handler(m_allocator,
+        [ptr](const boost::system::error_code & error, size_t length) { ptr->OnWriteComplete(error, length); }));
     }
 
 // note that this function assumes that the socket mutex is locked
@@ -231,13 +298,8 @@ namespace MaNGOS
 
         assert(m_writeState == WriteState::Buffering);
 
-        // at this point we are guarunteed that there is data to send in the primary buffer.  send it.
-        m_writeState = WriteState::Sending;
-
-        std::shared_ptr<Socket> ptr = shared<Socket>();
-        m_socket.async_write_some(boost::asio::buffer(m_outBuffer->m_buffer, m_outBuffer->m_writePosition),
-                                  make_custom_alloc_handler(m_allocator,
-        [ptr](const boost::system::error_code & error, size_t length) { ptr->OnWriteComplete(error, length); }));
+        // at this point we are guarunteed that there is data to send in the queue.  send it.
+        StartSend();
     }
 
 // if the write state is idle, this will do nothing, which is correct
@@ -248,7 +310,7 @@ namespace MaNGOS
         m_outBufferFlushTimer.cancel();
     }
 
-    void Socket::OnWriteComplete(const boost::system::error_code& error, size_t length)
+    void Socket::OnWriteComplete(const boost::system::error_code& error, size_t /*length*/)
     {
         // we must check this before locking the mutex because the connection will be closed,
         // which leads to a locked mutex being destroyed.  not good!
@@ -267,38 +329,21 @@ namespace MaNGOS
         std::lock_guard<std::mutex> guard(m_mutex);
 
         assert(m_writeState == WriteState::Sending);
-        assert(length <= m_outBuffer->m_writePosition);
-
-        // if there is data left to write, move it to the start of the buffer
-        if (length < m_outBuffer->m_writePosition)
-        {
-            memcpy(&(m_outBuffer->m_buffer[0]), &(m_outBuffer->m_buffer[length]), (m_outBuffer->m_writePosition - length) * sizeof(m_outBuffer->m_buffer[0]));
-            m_outBuffer->m_writePosition -= length;
-        }
-        // if not, reset the write pointer
-        else
-            m_outBuffer->m_writePosition = 0;
 
-        // if there is data in the secondary buffer, append it to the primary buffer
-        if (m_secondaryOutBuffer->m_writePosition > 0)
+        // async_write only completes once everything is written, the chunks can be reused
+        for (auto& chunk : m_sendInFlight)
         {
-            // do we have enough space? if not, resize
-            if (m_outBuffer->m_buffer.size() < (m_outBuffer->m_writePosition + m_secondaryOutBuffer->m_writePosition))
-                m_outBuffer->m_buffer.resize(m_outBuffer->m_writePosition + m_secondaryOutBuffer->m_writePosition);
-
-            memcpy(&(m_outBuffer->m_buffer[m_outBuffer->m_writePosition]), &(m_secondaryOutBuffer->m_buffer[0]), (m_secondaryOutBuffer->m_writePosition) * sizeof(m_secondaryOutBuffer->m_buffer[0]));
-
-            m_outBuffer->m_writePosition += m_secondaryOutBuffer->m_writePosition;
-            m_secondaryOutBuffer->m_writePosition = 0;
+            // do not keep chunks that grew for a single big packet
+            if (m_sendChunkPool.size() < SendChunkPoolSize && chunk->m_buffer.size() <= DEFAULT_BUFFER_SIZE)
+            {
+                chunk->m_writePosition = 0;
+                m_sendChunkPool.push_back(std::move(chunk));
+            }
         }
+        m_sendInFlight.clear();
+        m_lastSendTime = std::chrono::steady_clock::now();
 
-        std::shared_ptr<Socket> ptr = shared<Socket>();
-        // if there is any data to write, do so immediately
-        if (m_outBuffer->m_writePosition > 0)
-            m_socket.async_write_some(boost::asio::buffer(m_outBuffer->m_buffer, m_outBuffer->m_writePosition),
-                                      make_custom_alloc_handler(m_allocator,
-            [ptr](const boost::system::error_code & error, size_t length) { ptr->OnWriteComplete(error, length);}));
-        else
-            m_writeState = WriteState::Idle;
+        // everything written in the meantime goes out in one go
+        StartSend();
     }
 }
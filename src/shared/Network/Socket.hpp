@@ -29,9 +29,19 @@
 #include <string>
 #include <mutex>
 #include <functional>
+#include <chrono>
+#include <vector>
 
 namespace MaNGOS
 {
+    // how eagerly written data is put on the wire
+    enum class SendLatency
+    {
+        Bulk,       // always waits for the buffer timeout so it can be coalesced with other data
+        Normal,     // sent right away on a connection that was quiet for a buffer timeout, coalesced otherwise
+        Immediate,  // sent right away unless a send is already underway, it then goes out right after it
+    };
+
     class Socket : public std::enable_shared_from_this<Socket>
     {
         private:
@@ -39,6 +49,12 @@ namespace MaNGOS
             // ingame but increase bandwidth efficiency by reducing tcp overhead.
             static const int BufferTimeout = 50;
 
+            // queued bytes that trigger a send without waiting for the buffer timeout
+            static const size_t SendCoalesceLimit = 16 * 1024;
+
+            // emptied send chunks kept for reuse
+            static const size_t SendChunkPoolSize = 4;
+
             enum class WriteState
             {
                 Idle,       // no write operation is currently underway
@@ -60,8 +76,15 @@ namespace MaNGOS
             std::function<void(Socket *)> m_closeHandler;
 
             std::unique_ptr<PacketBuffer> m_inBuffer;
-            std::unique_ptr<PacketBuffer> m_outBuffer;
-            std::unique_ptr<PacketBuffer> m_secondaryOutBuffer;
+
+            // written data waits in m_sendQueue, a send moves the chunks to m_sendInFlight and
+            // writes all of them with one gathering async_write, so nothing is copied again
+            std::vector<std::unique_ptr<PacketBuffer>> m_sendQueue;
+            std::vector<std::unique_ptr<PacketBuffer>> m_sendInFlight;
+            std::vector<std::unique_ptr<PacketBuffer>> m_sendChunkPool;
+            std::vector<boost::asio::const_buffer> m_sendBuffers;
+            size_t m_sendQueueBytes;
+            std::chrono::steady_clock::time_point m_lastSendTime;
 
             std::mutex m_mutex;
             std::mutex m_closeMutex;
@@ -70,6 +93,9 @@ namespace MaNGOS
             void StartAsyncRead();
             void OnRead(const boost::system::error_code &error, size_t length);
 
+            PacketBuffer* GetSendChunk(size_t length);
+            void ScheduleSend(SendLatency latency);
+            void StartSend();
             void StartWriteFlushTimer();
             void OnWriteComplete(const boost::system::error_code &error, size_t length);
             void FlushOut();
@@ -101,8 +127,8 @@ namespace MaNGOS
             bool Read(char *buffer, int length);
             void ReadSkip(int length) { m_inBuffer->Read(nullptr, length); }
 
-            void Write(const char *buffer, int length);
-            void Write(const char *header, int headerSize, const char* content, int contentSize);
+            void Write(const char *buffer, int length, SendLatency latency = SendLatency::Normal);
+            void Write(const char *header, int headerSize, const char* content, int contentSize, SendLatency latency = SendLatency::Normal);
 
             boost::asio::ip::tcp::socket &GetAsioSocket() { return m_socket; }
 
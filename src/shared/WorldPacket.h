@@ -22,10 +22,11 @@
 #include "Common.h"
 #include "ByteBuffer.h"
 #include "Server/Opcodes.h"
+#include "Multithreading/MPSCQueue.h"
 
 // Note: m_opcode and size stored in platfom dependent format
 // ignore endianess until send, and converted at receive
-class WorldPacket : public ByteBuffer
+class WorldPacket : public ByteBuffer, public MPSCQueueNode
 {
     public:
         // just container for later use
@@ -34,7 +35,7 @@ class WorldPacket : public ByteBuffer
         }
         explicit WorldPacket(Opcodes opcode, size_t res = 200) : ByteBuffer(res), m_opcode(opcode) { }
         // copy constructor
-        WorldPacket(const WorldPacket& packet)              : ByteBuffer(packet), m_opcode(packet.m_opcode)
+        WorldPacket(const WorldPacket& packet)              : ByteBuffer(packet), MPSCQueueNode(), m_opcode(packet.m_opcode)
         {
         }
 